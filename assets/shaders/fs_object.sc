@@ -2,7 +2,11 @@ $input v_position, v_texcoord0, v_normal
 
 #include <bgfx_shader.sh>
 
+#ifdef USE_SKIN_ARRAY
+SAMPLER2DARRAY(s_diffuse, 0);
+#else
 SAMPLER2D(s_diffuse, 0);
+#endif // USE_SKIN_ARRAY
 uniform vec4 u_skyAlphaThreshold;
 
 void main()
@@ -15,6 +19,9 @@ void main()
 	// unpack uniforms
 	float skyType = u_skyAlphaThreshold.x;
 	float alphaThreshold = u_skyAlphaThreshold.y;
+#ifdef USE_SKIN_ARRAY
+	float skinLayer = u_skyAlphaThreshold.z;
+#endif // USE_SKIN_ARRAY
 
 	float skyBightness = skyType / 2.0f;
 
@@ -27,7 +34,11 @@ void main()
 	float diff = max(dot(v_normal, lightDir.xyz), 0.0);
 	vec3 diffuse = skyBightness * diff * lightColor * ( 1.0f - ambientStrength);
 
+#ifdef USE_SKIN_ARRAY
+	vec4 diffuseTex = texture2DArray(s_diffuse, vec3(v_texcoord0.xy, skinLayer));
+#else
 	vec4 diffuseTex = texture2D(s_diffuse, v_texcoord0.xy);
+#endif // USE_SKIN_ARRAY
 	diffuseTex.rgb = diffuseTex.rgb * (ambient + diffuse);
 	if (diffuseTex.a <= alphaThreshold)
 	{
@@ -0,0 +1,2 @@
+#define USE_SKIN_ARRAY 1
+#include "fs_object.sc"
@@ -1,11 +1,22 @@
+#ifdef USE_INSTANCING
+$input v_texcoord0, v_color0
+#else
 $input v_texcoord0
+#endif // USE_INSTANCING
 
 #include <bgfx_shader.sh>
 
 SAMPLER2D(s_diffuse, 0);
+#ifndef USE_INSTANCING
 uniform vec4 u_tint;
+#endif // USE_INSTANCING
 
 void main()
 {
-	gl_FragColor = texture2D(s_diffuse, v_texcoord0.xy).rrrr * u_tint;
+#ifdef USE_INSTANCING
+	vec4 tint = v_color0;
+#else
+	vec4 tint = u_tint;
+#endif // USE_INSTANCING
+	gl_FragColor = texture2D(s_diffuse, v_texcoord0.xy).rrrr * tint;
 }
@@ -0,0 +1,3 @@
+#define USE_INSTANCING 1
+
+#include "fs_sprite.sc"
@@ -1,4 +1,4 @@
-$input a_position, a_texcoord0, i_data0, i_data1, i_data2, i_data3, i_data4
+$input a_position, a_texcoord0, i_data0, i_data1, i_data2, i_data3
 $output v_texcoord0
 
 #include <bgfx_shader.sh>
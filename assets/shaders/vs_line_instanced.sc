@@ -1,4 +1,4 @@
-$input a_position, a_color0, i_data0, i_data1, i_data2, i_data3, i_data4
+$input a_position, a_color0, i_data0, i_data1, i_data2, i_data3
 $output v_color0
 
 #include <bgfx_shader.sh>
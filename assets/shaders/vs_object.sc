@@ -1,5 +1,5 @@
 #ifdef USE_INSTANCING
-$input a_position, a_texcoord0, a_normal, a_indices, i_data0, i_data1, i_data2, i_data3, i_data4
+$input a_position, a_texcoord0, a_normal, a_indices, i_data0, i_data1, i_data2, i_data3
 #else
 $input a_position, a_texcoord0, a_normal, a_indices
 #endif // USE_INSTANCING
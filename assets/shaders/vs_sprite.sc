@@ -1,21 +1,41 @@
+#ifdef USE_INSTANCING
+$input a_position, i_data0, i_data1, i_data2, i_data3, i_data4
+$output v_texcoord0, v_color0
+#else
 $input a_position
 $output v_texcoord0
+#endif // USE_INSTANCING
 
 #include <bgfx_shader.sh>
 
+#ifndef USE_INSTANCING
 uniform vec4 u_sampleRect;
+#endif // USE_INSTANCING
 
 void main()
 {
+#ifdef USE_INSTANCING
+	// Unpack: scaled x and y axes of the plane, translation, sample rect and tint
+	vec3 axisX = i_data0.xyz;
+	vec3 axisY = i_data1.xyz;
+	vec3 translation = i_data2.xyz;
+	vec4 sampleRect = i_data3;
+	v_color0 = i_data4;
+#else
+	vec3 axisX = mul(u_model[0], vec4(1.0f, 0.0f, 0.0f, 0.0f)).xyz;
+	vec3 axisY = mul(u_model[0], vec4(0.0f, 1.0f, 0.0f, 0.0f)).xyz;
+	vec3 translation = mul(u_model[0], vec4(0.0f, 0.0f, 0.0f, 1.0f)).xyz;
+	vec4 sampleRect = u_sampleRect;
+#endif // USE_INSTANCING
+
 	// Plane position to UV
 	v_texcoord0.xy = vec2(a_position.x * 0.5f + 0.5f, 0.5f - a_position.y * 0.5f);
 	// Zoom on section of sprite to render
-	v_texcoord0.xy = v_texcoord0.xy * u_sampleRect.xy + u_sampleRect.zw;
+	v_texcoord0.xy = v_texcoord0.xy * sampleRect.xy + sampleRect.zw;
 
-	vec3 translation = mul(u_model[0], vec4(0.0f, 0.0f, 0.0f, 1.0f)).xyz;
 	vec4 position = a_position;
 	// Apply scaling
-	position.xyz = mul(u_model[0], vec4(position.xyz, 0.0)).xyz;
+	position.xyz = axisX * a_position.x + axisY * a_position.y;
 	// Undo camera rotation so sprite faces camera
 	position.xyz = mul(u_invView, vec4(position.xyz, 0.0)).xyz;
 	// Apply translation
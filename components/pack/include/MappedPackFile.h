@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "PackFile.h"
+
+namespace openblack::pack
+{
+
+/// Texture of a pack whose DDS texels point into the pack's memory
+struct G3DTextureView
+{
+	G3DTextureHeader header;
+	DdsHeader ddsHeader;
+	std::span<const uint8_t> ddsData;
+};
+
+/**
+  This class is used to read LionHead Packs files without copying their contents
+
+  The file is memory mapped and opening it only indexes the block headers. Each kind of content is decoded by its
+  Resolve function which only reads the tables describing it, the views returned by the getters point into the mapped
+  file and are valid for as long as the MappedPackFile is alive. Once resolved, the getters can be used from any thread.
+ */
+class MappedPackFile
+{
+public:
+	MappedPackFile() noexcept;
+	virtual ~MappedPackFile() noexcept;
+	MappedPackFile(const MappedPackFile&) = delete;
+	MappedPackFile& operator=(const MappedPackFile&) = delete;
+	MappedPackFile(MappedPackFile&&) = delete;
+	MappedPackFile& operator=(MappedPackFile&&) = delete;
+
+	/// Map pack file from the filesystem
+	PackResult Open(const std::filesystem::path& filepath) noexcept;
+
+	/// Read pack file from a buffer, for files which can't be mapped
+	PackResult Open(std::vector<uint8_t>&& buffer) noexcept;
+
+	/// Find the mesh views in the MESHES block
+	PackResult ResolveMeshes() noexcept;
+
+	/// Decode the texture and DDS headers of all textures named in the INFO block
+	PackResult ResolveTextures() noexcept;
+
+	/// Decode the sample headers and find the sample views in the LHAudioWaveData block
+	PackResult ResolveAudioSamples() noexcept;
+
+	[[nodiscard]] bool HasBlock(std::string_view name) const noexcept { return _blocks.contains(name); }
+	[[nodiscard]] std::span<const uint8_t> GetBlock(std::string_view name) const noexcept { return _blocks.find(name)->second; }
+	[[nodiscard]] const std::vector<std::span<const uint8_t>>& GetMeshes() const noexcept { return _meshes; }
+	[[nodiscard]] const std::map<std::string, G3DTextureView>& GetTextures() const noexcept { return _textures; }
+	[[nodiscard]] const std::vector<AudioBankSampleHeader>& GetAudioSampleHeaders() const noexcept
+	{
+		return _audioSampleHeaders;
+	}
+	[[nodiscard]] const std::vector<std::span<const uint8_t>>& GetAudioSamplesData() const noexcept
+	{
+		return _audioSampleData;
+	}
+
+private:
+	/// Index the blocks of the file in _data
+	PackResult ReadBlocks() noexcept;
+	void Close() noexcept;
+
+	/// Address returned by the platform's mapping function, null when the file is read into _buffer instead
+	void* _mapping {nullptr};
+	std::vector<uint8_t> _buffer;
+	std::span<const uint8_t> _data;
+
+	std::map<std::string, std::span<const uint8_t>, std::less<>> _blocks;
+	std::vector<std::span<const uint8_t>> _meshes;
+	std::map<std::string, G3DTextureView> _textures;
+	std::vector<AudioBankSampleHeader> _audioSampleHeaders;
+	std::vector<std::span<const uint8_t>> _audioSampleData;
+	bool _meshesResolved {false};
+	bool _texturesResolved {false};
+	bool _audioSamplesResolved {false};
+};
+
+} // namespace openblack::pack
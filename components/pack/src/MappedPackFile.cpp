@@ -0,0 +1,376 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+/*
+ * See PackFile.cpp for the layout of pack files.
+ */
+
+#include "MappedPackFile.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <array>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace openblack::pack;
+
+namespace
+{
+struct PackBlockHeader
+{
+	static constexpr uint32_t k_BlockNameSize = 0x20;
+	std::array<char, k_BlockNameSize> blockName;
+	uint32_t blockSize;
+};
+
+/// Magic Key Jean-Claude Cottier
+constexpr const std::array<char, 4> k_BlockMagic = {'M', 'K', 'J', 'C'};
+constexpr const std::array<char, 8> k_Magic = {'L', 'i', 'O', 'n', 'H', 'e', 'A', 'd'};
+
+/// Copy a struct out of the pack, the data in the mapping isn't necessarily aligned
+template <typename T>
+bool ReadAt(std::span<const uint8_t> data, size_t offset, T& value)
+{
+	if (offset > data.size() || data.size() - offset < sizeof(T))
+	{
+		return false;
+	}
+	std::memcpy(&value, data.data() + offset, sizeof(T));
+	return true;
+}
+
+/// Map the whole file read-only, returns null on failure
+void* MapFile(const std::filesystem::path& filepath, size_t& size)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return nullptr;
+	}
+	// The view keeps the mapping alive
+	void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return address;
+#else
+	const int fd = open(filepath.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+	// The mapping stays valid once the descriptor is closed
+	void* address = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED)
+	{
+		return nullptr;
+	}
+	size = static_cast<size_t>(fileStat.st_size);
+	return address;
+#endif
+}
+
+void UnmapFile(void* address, [[maybe_unused]] size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(address);
+#else
+	munmap(address, size);
+#endif
+}
+} // namespace
+
+MappedPackFile::MappedPackFile() noexcept = default;
+
+MappedPackFile::~MappedPackFile() noexcept
+{
+	Close();
+}
+
+void MappedPackFile::Close() noexcept
+{
+	if (_mapping != nullptr)
+	{
+		UnmapFile(_mapping, _data.size());
+		_mapping = nullptr;
+	}
+	_buffer.clear();
+	_data = {};
+}
+
+PackResult MappedPackFile::Open(const std::filesystem::path& filepath) noexcept
+{
+	assert(_data.empty());
+
+	size_t size = 0;
+	_mapping = MapFile(filepath, size);
+	if (_mapping == nullptr)
+	{
+		return PackResult::ErrCantOpen;
+	}
+	_data = {static_cast<const uint8_t*>(_mapping), size};
+
+	return ReadBlocks();
+}
+
+PackResult MappedPackFile::Open(std::vector<uint8_t>&& buffer) noexcept
+{
+	assert(_data.empty());
+
+	_buffer = std::move(buffer);
+	_data = _buffer;
+
+	return ReadBlocks();
+}
+
+PackResult MappedPackFile::ReadBlocks() noexcept
+{
+	if (_data.size() < k_Magic.size() + sizeof(PackBlockHeader))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
+
+	if (std::memcmp(_data.data(), k_Magic.data(), k_Magic.size()) != 0)
+	{
+		return PackResult::ErrUnrecognizedHeader;
+	}
+
+	PackBlockHeader header;
+	size_t offset = k_Magic.size();
+	while (ReadAt(_data, offset, header))
+	{
+		offset += sizeof(header);
+		if (header.blockSize > _data.size() - offset)
+		{
+			return PackResult::ErrFileNotEvenlySplit;
+		}
+
+		header.blockName.back() = '\0';
+		if (!_blocks.emplace(header.blockName.data(), _data.subspan(offset, header.blockSize)).second)
+		{
+			return PackResult::ErrDuplicateBlockName;
+		}
+		offset += header.blockSize;
+	}
+
+	return PackResult::Success;
+}
+
+PackResult MappedPackFile::ResolveMeshes() noexcept
+{
+	if (_meshesResolved)
+	{
+		return PackResult::Success;
+	}
+	if (!HasBlock("MESHES"))
+	{
+		return PackResult::ErrMissingMeshBlock;
+	}
+	const auto data = GetBlock("MESHES");
+
+	// Greetings Jean-Claude Cottier
+	std::array<char, k_BlockMagic.size()> magic;
+	uint32_t meshCount;
+	if (!ReadAt(data, 0, magic) || std::memcmp(magic.data(), k_BlockMagic.data(), magic.size()) != 0 ||
+	    !ReadAt(data, magic.size(), meshCount))
+	{
+		return PackResult::ErrMeshBlockHeaderMalformed;
+	}
+
+	const size_t offsetsStart = magic.size() + sizeof(meshCount);
+	if (meshCount > (data.size() - offsetsStart) / sizeof(uint32_t))
+	{
+		return PackResult::ErrMeshBlockHeaderMalformed;
+	}
+
+	std::vector<uint32_t> meshOffsets(meshCount);
+	std::memcpy(meshOffsets.data(), data.data() + offsetsStart, meshOffsets.size() * sizeof(meshOffsets[0]));
+
+	_meshes.resize(meshOffsets.size());
+	for (size_t i = 0; i < _meshes.size(); ++i)
+	{
+		const size_t end = i == _meshes.size() - 1 ? data.size() : meshOffsets[i + 1];
+		if (meshOffsets[i] > end || end > data.size())
+		{
+			_meshes.clear();
+			return PackResult::ErrMeshBlockHeaderMalformed;
+		}
+		_meshes[i] = data.subspan(meshOffsets[i], end - meshOffsets[i]);
+	}
+
+	_meshesResolved = true;
+	return PackResult::Success;
+}
+
+PackResult MappedPackFile::ResolveTextures() noexcept
+{
+	if (_texturesResolved)
+	{
+		return PackResult::Success;
+	}
+	if (!HasBlock("INFO"))
+	{
+		return PackResult::ErrMissingInfoBlock;
+	}
+	const auto info = GetBlock("INFO");
+
+	uint32_t totalTextures;
+	if (!ReadAt(info, 0, totalTextures) || totalTextures > (info.size() - sizeof(totalTextures)) / sizeof(InfoBlockLookup))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
+
+	std::array<char, PackBlockHeader::k_BlockNameSize> blockName;
+	for (uint32_t i = 0; i < totalTextures; ++i)
+	{
+		InfoBlockLookup item;
+		ReadAt(info, sizeof(totalTextures) + i * sizeof(item), item);
+
+		// Convert int id to string representation as hexadecimal key
+		std::snprintf(blockName.data(), blockName.size(), "%x", item.blockId);
+		if (!HasBlock(blockName.data()))
+		{
+			return PackResult::ErrMissingTextureBlock;
+		}
+		const auto block = GetBlock(blockName.data());
+
+		G3DTextureView texture;
+		if (!ReadAt(block, 0, texture.header))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
+		if (texture.header.id != item.blockId)
+		{
+			return PackResult::ErrTextureBlockIdMismatch;
+		}
+		if (_textures.contains(blockName.data()))
+		{
+			return PackResult::ErrTextureDuplicate;
+		}
+
+		const auto dds = block.subspan(sizeof(texture.header));
+		if (!ReadAt(dds, 0, texture.ddsHeader))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
+
+		// Verify the header to validate the DDS file
+		auto& ddsHeader = texture.ddsHeader;
+		if (ddsHeader.size != sizeof(DdsHeader) || ddsHeader.format.size != sizeof(DdsPixelFormat))
+		{
+			return PackResult::ErrTextureInvalidDDSHeaderSize;
+		}
+
+		// Some Creature Isle DXT5 textures lack this field, see PackFile::ExtractTexturesFromBlock
+		if (ddsHeader.pitchOrLinearSize == 0)
+		{
+			const auto format = std::string_view(ddsHeader.format.fourCC.data(), ddsHeader.format.fourCC.size());
+			const uint32_t blockSize = format == "DXT1" || format.starts_with("BC1") || format.starts_with("BC4") ? 8 : 16;
+			ddsHeader.pitchOrLinearSize = ((ddsHeader.width + 3) / 4) * ((ddsHeader.height + 3) / 4) * blockSize;
+		}
+
+		if (ddsHeader.pitchOrLinearSize > dds.size() - sizeof(DdsHeader))
+		{
+			return PackResult::ErrFileTooSmall;
+		}
+		texture.ddsData = dds.subspan(sizeof(DdsHeader), ddsHeader.pitchOrLinearSize);
+
+		_textures.emplace(blockName.data(), texture);
+	}
+
+	_texturesResolved = true;
+	return PackResult::Success;
+}
+
+PackResult MappedPackFile::ResolveAudioSamples() noexcept
+{
+	if (_audioSamplesResolved)
+	{
+		return PackResult::Success;
+	}
+	if (!HasBlock("LHAudioBankSampleTable"))
+	{
+		return PackResult::ErrMissingAudioBankSampleTableBlock;
+	}
+	if (!HasBlock("LHAudioWaveData"))
+	{
+		return PackResult::ErrMissingAudioWaveDataBlock;
+	}
+	const auto table = GetBlock("LHAudioBankSampleTable");
+	const auto waveData = GetBlock("LHAudioWaveData");
+
+	uint16_t sampleCount;
+	if (table.size() < sizeof(uint32_t) || !ReadAt(table, 0, sampleCount))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
+	if (sampleCount == 0)
+	{
+		return PackResult::ErrNoEntries;
+	}
+	if (table.size() != sizeof(uint32_t) + sampleCount * sizeof(AudioBankSampleHeader))
+	{
+		return PackResult::ErrFileTooSmall;
+	}
+
+	// Headers are small and copied out of the pack to be aligned
+	_audioSampleHeaders.resize(sampleCount);
+	std::memcpy(_audioSampleHeaders.data(), table.data() + sizeof(uint32_t),
+	            _audioSampleHeaders.size() * sizeof(_audioSampleHeaders[0]));
+
+	_audioSampleData.resize(_audioSampleHeaders.size());
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& sample : _audioSampleHeaders)
+	{
+		if (sample.offset > waveData.size() || sample.size > waveData.size() - sample.offset)
+		{
+			_audioSampleHeaders.clear();
+			_audioSampleData.clear();
+			return PackResult::ErrFileTooSmall;
+		}
+		_audioSampleData[i] = waveData.subspan(sample.offset, sample.size);
+		++i;
+	}
+
+	_audioSamplesResolved = true;
+	return PackResult::Success;
+}
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <glm/common.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vector_relational.hpp>
 
@@ -26,6 +29,15 @@ struct AxisAlignedBoundingBox
 	{
 		return glm::all(glm::greaterThanEqual(point, minima) && glm::lessThanEqual(point, maxima));
 	}
+	/// Smallest axis aligned box containing this box after an affine transform
+	[[nodiscard]] inline AxisAlignedBoundingBox Transform(const glm::mat4& transform) const
+	{
+		const auto center = glm::vec3(transform * glm::vec4(Center(), 1.0f));
+		const auto absolute =
+		    glm::mat3(glm::abs(glm::vec3(transform[0])), glm::abs(glm::vec3(transform[1])), glm::abs(glm::vec3(transform[2])));
+		const auto halfSize = absolute * (Size() * 0.5f);
+		return {center - halfSize, center + halfSize};
+	}
 };
 
 } // namespace openblack
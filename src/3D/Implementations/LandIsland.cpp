@@ -12,12 +12,18 @@
 
 #include "LandIsland.h"
 
+#include <cassert>
+
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <LNDFile.h>
 #include <bgfx/bgfx.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/component_wise.hpp>
+#include <glm/gtx/intersect.hpp>
 #include <glm/gtx/transform.hpp>
 #include <spdlog/spdlog.h>
 #include <stb_image_write.h>
@@ -143,6 +149,8 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	    bgfx::makeRef(lnd.GetExtra().bump.texels.data(),
 	                  static_cast<uint32_t>(sizeof(lnd.GetExtra().bump.texels[0]) * lnd.GetExtra().bump.texels.size())));
 
+	BuildHeightField();
+
 	// build the meshes (we could move this elsewhere)
 	for (auto& block : _landBlocks)
 	{
@@ -151,36 +159,257 @@ void LandIsland::LoadFromFile(const std::filesystem::path& path)
 	bgfx::frame();
 }
 
+namespace
+{
+struct HeightFieldSample
+{
+	size_t index;
+	glm::vec2 weight;
+};
+
+/// Index of the corner before position in the height field and the bilinear weights of the next corners
+inline HeightFieldSample SampleHeightField(glm::vec2 position, uint16_t fieldSize)
+{
+	// Offset by the empty border and clamp to just before the last corner, outside of the map is empty like in GetCell
+	const auto maxCoordinate = static_cast<float>(fieldSize) - 1.0f - 1.0f / 256.0f;
+	const auto coordinates =
+	    glm::clamp(position / LandIslandInterface::k_CellSize + 1.0f, glm::vec2(0.0f), glm::vec2(maxCoordinate));
+	const auto corner = glm::floor(coordinates);
+	return {static_cast<size_t>(corner.y) * fieldSize + static_cast<size_t>(corner.x), coordinates - corner};
+}
+
+inline float InterpolateHeight(const std::vector<float>& field, glm::vec2 position, uint16_t fieldSize)
+{
+	const auto [index, weight] = SampleHeightField(position, fieldSize);
+	const auto back = glm::mix(field[index], field[index + 1], weight.x);
+	const auto forward = glm::mix(field[index + fieldSize], field[index + fieldSize + 1], weight.x);
+	return glm::mix(back, forward, weight.y);
+}
+
+/// Visit in order the cells of a grid crossed by a ray in the xz plane between tBegin and tEnd, with the ray parameters at
+/// which each cell is entered and exited. Stops when visit returns true.
+template <typename Visitor>
+bool TraverseGrid(glm::vec2 origin, glm::vec2 direction, float cellSize, float tBegin, float tEnd, Visitor visit)
+{
+	auto cell = glm::ivec2(glm::floor((origin + direction * tBegin) / cellSize));
+	const auto step = glm::ivec2(glm::sign(direction));
+	// Ray parameter of the next cell boundary on each axis and between two boundaries
+	auto tNext = glm::vec2(std::numeric_limits<float>::infinity());
+	auto tDelta = glm::vec2(std::numeric_limits<float>::infinity());
+	for (glm::length_t i = 0; i < 2; ++i)
+	{
+		if (step[i] != 0)
+		{
+			tNext[i] = (static_cast<float>(cell[i] + std::max(step[i], 0)) * cellSize - origin[i]) / direction[i];
+			tDelta[i] = cellSize / glm::abs(direction[i]);
+		}
+	}
+
+	for (auto t = tBegin; t < tEnd;)
+	{
+		const auto axis = tNext.x < tNext.y ? 0 : 1;
+		const auto tExit = glm::min(tNext[axis], tEnd);
+		if (visit(cell, t, tExit))
+		{
+			return true;
+		}
+		cell[axis] += step[axis];
+		tNext[axis] += tDelta[axis];
+		t = tExit;
+	}
+	return false;
+}
+} // namespace
+
+void LandIsland::BuildHeightField()
+{
+	_heightField.assign(k_HeightFieldSize * k_HeightFieldSize, 0.0f);
+	for (uint16_t z = 0; z < 512; ++z)
+	{
+		for (uint16_t x = 0; x < 512; ++x)
+		{
+			const auto index = (z + 1u) * k_HeightFieldSize + x + 1u;
+			_heightField[index] = GetCell(glm::u16vec2(x, z)).altitude * k_HeightUnit;
+		}
+	}
+
+	// Including the corners shared with the next blocks
+	for (uint16_t blockX = 0; blockX < 32; ++blockX)
+	{
+		for (uint16_t blockZ = 0; blockZ < 32; ++blockZ)
+		{
+			auto& blockMax = _blockMaxHeights.at(blockX << 5 | blockZ);
+			blockMax = 0.0f;
+			for (uint16_t z = blockZ * k_CellCount; z <= (blockZ + 1) * k_CellCount; ++z)
+			{
+				const auto row = _heightField.begin() + (z + 1) * k_HeightFieldSize + blockX * k_CellCount + 1;
+				blockMax = std::max(blockMax, *std::max_element(row, row + k_CellCount + 1));
+			}
+		}
+	}
+	_maxHeight = *std::max_element(_heightField.begin(), _heightField.end());
+
+	// Central differences, clamped to the field on the border
+	_normalField.resize(_heightField.size());
+	for (int z = 0; z < k_HeightFieldSize; ++z)
+	{
+		const auto back = std::max(z - 1, 0) * k_HeightFieldSize;
+		const auto forward = std::min(z + 1, k_HeightFieldSize - 1) * k_HeightFieldSize;
+		for (int x = 0; x < k_HeightFieldSize; ++x)
+		{
+			const auto left = std::max(x - 1, 0);
+			const auto right = std::min(x + 1, k_HeightFieldSize - 1);
+			const auto slopeX = _heightField[z * k_HeightFieldSize + left] - _heightField[z * k_HeightFieldSize + right];
+			const auto slopeZ = _heightField[back + x] - _heightField[forward + x];
+			_normalField[z * k_HeightFieldSize + x] = glm::normalize(glm::vec3(slopeX, 2.0f * k_CellSize, slopeZ));
+		}
+	}
+}
+
 float LandIsland::GetHeightAt(glm::vec2 vec) const
 {
-	return GetCell(vec * 0.1f).altitude * LandIsland::k_HeightUnit;
+	return InterpolateHeight(_heightField, vec, k_HeightFieldSize);
 }
 
 glm::vec3 LandIsland::GetNormalAt(glm::vec2 vec) const
 {
-	const auto delta = 0.1f;
-	const auto posLeft = vec - glm::vec2(delta, 0.0f);
-	const auto posRight = vec + glm::vec2(delta, 0.0f);
-	const auto posBack = vec - glm::vec2(0.0f, delta);
-	const auto posForward = vec + glm::vec2(0.0f, delta);
+	const auto [index, weight] = SampleHeightField(vec, k_HeightFieldSize);
+	const auto back = glm::mix(_normalField[index], _normalField[index + 1], weight.x);
+	const auto forward =
+	    glm::mix(_normalField[index + k_HeightFieldSize], _normalField[index + k_HeightFieldSize + 1], weight.x);
+	return glm::normalize(glm::mix(back, forward, weight.y));
+}
+
+void LandIsland::GetHeightsAt(std::span<const glm::vec2> positions, std::span<float> heights) const
+{
+	assert(positions.size() == heights.size());
+	// Same as GetHeightAt without the virtual call per position. There are no branches in the loop so that the compiler
+	// can vectorize the clamping and weights, only the four loads of each position are scalar.
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		heights[i] = InterpolateHeight(_heightField, positions[i], k_HeightFieldSize);
+	}
+}
 
-	const auto heightLeft = GetHeightAt(posLeft);
-	const auto heightRight = GetHeightAt(posRight);
-	const auto heightBack = GetHeightAt(posBack);
-	const auto heightForward = GetHeightAt(posForward);
+std::optional<LandIslandInterface::RayHit> LandIsland::RayCast(const glm::vec3& origin, const glm::vec3& direction,
+                                                              float tMax) const
+{
+	// Clip the ray to the map, under the highest corner
+	auto tBegin = 0.0f;
+	auto tEnd = tMax;
+	const auto mapSize = k_CellSize * 512.0f;
+	for (const glm::length_t axis : {0, 2})
+	{
+		if (direction[axis] == 0.0f)
+		{
+			if (origin[axis] < 0.0f || origin[axis] > mapSize)
+			{
+				return std::nullopt;
+			}
+			continue;
+		}
+		const auto t0 = -origin[axis] / direction[axis];
+		const auto t1 = (mapSize - origin[axis]) / direction[axis];
+		tBegin = std::max(tBegin, std::min(t0, t1));
+		tEnd = std::min(tEnd, std::max(t0, t1));
+	}
+	if (direction.y == 0.0f)
+	{
+		if (origin.y > _maxHeight)
+		{
+			return std::nullopt;
+		}
+	}
+	else if (direction.y > 0.0f)
+	{
+		tEnd = std::min(tEnd, (_maxHeight - origin.y) / direction.y);
+	}
+	else
+	{
+		tBegin = std::max(tBegin, (_maxHeight - origin.y) / direction.y);
+	}
+	if (tBegin >= tEnd)
+	{
+		return std::nullopt;
+	}
 
-	const auto slopeLeftRight = glm::vec3(2.0f * delta, heightRight - heightLeft, 0.0f);
-	const auto slopeBackForward = glm::vec3(0.0f, heightForward - heightBack, 2.0f * delta);
+	// Walk the blocks along the ray, then the cells of the blocks the ray goes low enough to hit. Cells are visited in
+	// order so the first hit is the closest.
+	std::optional<RayHit> hit;
+	const auto origin2d = glm::vec2(origin.x, origin.z);
+	const auto direction2d = glm::vec2(direction.x, direction.z);
+	TraverseGrid(origin2d, direction2d, k_CellSize * k_CellCount, tBegin, tEnd, [&](glm::ivec2 block, float t0, float t1) {
+		if (glm::any(glm::lessThan(block, glm::ivec2(0))) || glm::any(glm::greaterThan(block, glm::ivec2(31))))
+		{
+			return false;
+		}
+		const auto lookupIndex = block.x << 5 | block.y;
+		const auto lowest = std::min(origin.y + direction.y * t0, origin.y + direction.y * t1);
+		if (_blockIndexLookup.at(lookupIndex) == 0 || lowest > _blockMaxHeights.at(lookupIndex))
+		{
+			return false;
+		}
+		return TraverseGrid(origin2d, direction2d, k_CellSize, t0, t1, [&](glm::ivec2 cell, float c0, float c1) {
+			hit = RayCastCell(cell, origin, direction, c0, c1);
+			return hit.has_value();
+		});
+	});
+	return hit;
+}
 
-	auto normal = glm::cross(slopeBackForward, slopeLeftRight);
-	normal = glm::normalize(normal);
+std::optional<LandIslandInterface::RayHit> LandIsland::RayCastCell(glm::ivec2 cell, const glm::vec3& origin,
+                                                                   const glm::vec3& direction, float tBegin, float tEnd) const
+{
+	if (glm::any(glm::lessThan(cell, glm::ivec2(0))) || glm::any(glm::greaterThan(cell, glm::ivec2(511))))
+	{
+		return std::nullopt;
+	}
+	const uint8_t blockIndex = _blockIndexLookup.at((cell.x >> 4) << 5 | (cell.y >> 4));
+	if (blockIndex == 0)
+	{
+		return std::nullopt;
+	}
 
-	if (normal.y < 0)
+	// Same corners and triangles as LandBlock::BuildVertexList
+	const auto index = static_cast<size_t>(cell.y + 1) * k_HeightFieldSize + static_cast<size_t>(cell.x + 1);
+	const auto heights = glm::vec4(_heightField[index], _heightField[index + 1], _heightField[index + k_HeightFieldSize],
+	                               _heightField[index + k_HeightFieldSize + 1]);
+	if (std::min(origin.y + direction.y * tBegin, origin.y + direction.y * tEnd) > glm::compMax(heights))
 	{
-		normal = -normal;
+		return std::nullopt;
+	}
+	const auto corner = glm::vec2(cell) * k_CellSize;
+	const auto topLeft = glm::vec3(corner.x, heights[0], corner.y);
+	const auto topRight = glm::vec3(corner.x + k_CellSize, heights[1], corner.y);
+	const auto bottomLeft = glm::vec3(corner.x, heights[2], corner.y + k_CellSize);
+	const auto bottomRight = glm::vec3(corner.x + k_CellSize, heights[3], corner.y + k_CellSize);
+	using Triangle = std::array<glm::vec3, 3>;
+	std::array<Triangle, 2> triangles {{{topLeft, topRight, bottomRight}, {topLeft, bottomLeft, bottomRight}}};
+	if (GetCell(glm::u16vec2(cell)).properties.split)
+	{
+		triangles = {{{bottomLeft, topLeft, topRight}, {bottomLeft, bottomRight, topRight}}};
 	}
 
-	return normal;
+	// Allow for the rounding of the cell boundaries in TraverseGrid
+	const auto tolerance = 1e-4f * (tEnd - tBegin);
+	std::optional<RayHit> hit;
+	for (const auto& triangle : triangles)
+	{
+		glm::vec2 barycentric;
+		float distance = 0.0f;
+		if (glm::intersectRayTriangle(origin, direction, triangle[0], triangle[1], triangle[2], barycentric, distance) &&
+		    distance >= std::max(tBegin - tolerance, 0.0f) && distance <= tEnd + tolerance &&
+		    (!hit.has_value() || distance < hit->distance))
+		{
+			auto normal = glm::normalize(glm::cross(triangle[1] - triangle[0], triangle[2] - triangle[0]));
+			if (normal.y < 0.0f)
+			{
+				normal = -normal;
+			}
+			hit = RayHit {origin + direction * distance, normal, distance, blockIndex - 1};
+		}
+	}
+	return hit;
 }
 
 uint8_t LandIsland::GetNoise(glm::u8vec2 pos)
@@ -33,6 +33,9 @@ class LandIsland final: public LandIslandInterface
 
 	[[nodiscard]] float GetHeightAt(glm::vec2) const override;
 	[[nodiscard]] glm::vec3 GetNormalAt(glm::vec2) const override;
+	void GetHeightsAt(std::span<const glm::vec2> positions, std::span<float> heights) const override;
+	[[nodiscard]] std::optional<RayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+	                                            float tMax) const override;
 	[[nodiscard]] const LandBlock* GetBlock(const glm::u8vec2& coordinates) const;
 	[[nodiscard]] const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const override;
 
@@ -41,11 +44,25 @@ class LandIsland final: public LandIslandInterface
 	void DumpMaps() const override;
 
 private:
+	/// Cells -1 to 513 of the 512x512 map, so positions clamped outside of the map only sample the empty border
+	static constexpr uint16_t k_HeightFieldSize = 512 + 3;
+
 	[[nodiscard]] std::vector<uint8_t> CreateHeightMap() const;
+	/// Precompute the height and normal of every cell corner and the highest corner of every block
+	void BuildHeightField();
+	/// Closest intersection with the two triangles of a cell between the ray parameters tBegin and tEnd
+	[[nodiscard]] std::optional<RayHit> RayCastCell(glm::ivec2 cell, const glm::vec3& origin, const glm::vec3& direction,
+	                                                float tBegin, float tEnd) const;
 	std::vector<LandBlock> _landBlocks;
 	std::vector<lnd::LNDCountry> _countries;
 
 	std::array<uint8_t, 1024> _blockIndexLookup {0};
+	/// Heights and normals at cell corners, row major by z then x, sampled bilinearly by GetHeightAt and GetNormalAt
+	std::vector<float> _heightField;
+	std::vector<glm::vec3> _normalField;
+	/// Highest corner of each block, indexed like _blockIndexLookup, and of the whole island
+	std::array<float, 1024> _blockMaxHeights {0};
+	float _maxHeight {0.0f};
 
 	// Renderer, Dynamics
 public:
@@ -11,6 +11,8 @@
 
 #include "Ocean.h"
 
+#include <algorithm>
+
 #include <bgfx/bgfx.h>
 #include <glm/vec2.hpp>
 
@@ -23,11 +25,11 @@
 using namespace openblack;
 using namespace openblack::graphics;
 
-Ocean::Ocean() noexcept
+Ocean::Ocean(float reflectionResolutionScale) noexcept
 {
-	_reflectionFrameBuffer =
-	    std::make_unique<FrameBuffer>("Reflection", static_cast<uint16_t>(1024), static_cast<uint16_t>(1024),
-	                                  graphics::TextureFormat::RGBA8, graphics::TextureFormat::Depth24Stencil8);
+	const auto resolution = static_cast<uint16_t>(std::clamp(1024.0f * reflectionResolutionScale, 16.0f, 1024.0f));
+	_reflectionFrameBuffer = std::make_unique<FrameBuffer>("Reflection", resolution, resolution, graphics::TextureFormat::RGBA8,
+	                                                       graphics::TextureFormat::Depth24Stencil8);
 	CreateMesh();
 }
 Ocean::~Ocean() noexcept = default;
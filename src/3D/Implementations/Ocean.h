@@ -35,7 +35,8 @@ class Ocean final: public OceanInterface
 	static constexpr entt::hashed_string k_DiffuseTextureId = entt::hashed_string("raw/Sky");
 	static constexpr entt::hashed_string k_AlphaTextureId = entt::hashed_string("raw/Skya");
 
-	Ocean() noexcept;
+	/// The reflection framebuffer is 1024x1024 scaled by reflectionResolutionScale
+	explicit Ocean(float reflectionResolutionScale = 1.0f) noexcept;
 	~Ocean() noexcept;
 
 	[[nodiscard]] graphics::FrameBuffer& GetReflectionFramebuffer() const noexcept override { return *_reflectionFrameBuffer; }
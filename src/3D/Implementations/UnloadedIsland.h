@@ -27,6 +27,17 @@ class UnloadedIsland final: public LandIslandInterface
 		throw std::runtime_error("Cannot get landscape before any are loaded");
 	}
 
+	void GetHeightsAt(std::span<const glm::vec2>, std::span<float>) const override
+	{
+		throw std::runtime_error("Cannot get landscape before any are loaded");
+	}
+
+	/// There is nothing to hit, picking runs every frame even before a land is loaded
+	[[nodiscard]] std::optional<RayHit> RayCast(const glm::vec3&, const glm::vec3&, float) const override
+	{
+		return std::nullopt;
+	}
+
 	[[nodiscard]] const LandBlock* GetBlock(const glm::u8vec2&) const
 	{
 		throw std::runtime_error("Cannot get landscape before any are loaded");
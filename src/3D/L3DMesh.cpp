@@ -10,6 +10,7 @@
 #include "L3DMesh.h"
 
 #include <filesystem>
+#include <limits>
 #include <stdexcept>
 
 #include <BulletCollision/CollisionShapes/btConvexHullShape.h>
@@ -23,6 +24,7 @@
 #include "3D/L3DSubMesh.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/Texture2D.h"
+#include "Graphics/UploadBatch.h"
 #include "Graphics/VertexBuffer.h"
 #include "Locator.h"
 
@@ -38,18 +40,18 @@ L3DMesh::L3DMesh(std::string debugName) noexcept
 L3DMesh::~L3DMesh() noexcept = default;
 
 bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
+{
+	const auto result = Prepare(l3d);
+	Upload(l3d);
+	return result;
+}
+
+bool L3DMesh::Prepare(const l3d::L3DFile& l3d) noexcept
 {
 	bool result = true;
 
 	_flags = static_cast<l3d::L3DMeshFlags>(l3d.GetHeader().flags);
 	_nameData = l3d.GetNameData();
-	for (const auto& skin : l3d.GetSkins())
-	{
-		_skins[skin.id] = std::make_unique<Texture2D>(_debugName.c_str());
-		_skins[skin.id]->Create(
-		    l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, TextureFormat::BGRA4, Wrapping::Repeat, Filter::Linear,
-		    bgfx::makeRef(skin.texels.data(), static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0]))));
-	}
 
 	if (HasDoorPosition() && !l3d.GetExtraPoints().empty())
 	{
@@ -58,37 +60,18 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 
 	if (ContainsLandscapeFeature() && l3d.GetFootprint().has_value())
 	{
-		struct FootprintVertex
-		{
-			glm::vec2 pos;
-			glm::vec2 texCoord;
-		};
-		VertexDecl decl;
-		decl.reserve(1);
-		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
-
 		const auto& footprint = *l3d.GetFootprint();
 
-		// TODO (#749) use use std::views::enumerate
-		for (uint32_t i = 1; const auto& entry : footprint.entries)
+		for (const auto& entry : footprint.entries)
 		{
-			auto texture = std::make_unique<Texture2D>("footprints/texture/" + _debugName + "/" + std::to_string(i));
-			++i;
-			texture->Create(
-			    static_cast<uint16_t>(footprint.header.width), static_cast<uint16_t>(footprint.header.height), 1,
-			    graphics::TextureFormat::BGRA4, Wrapping::ClampEdge, Filter::Linear,
-			    bgfx::makeRef(entry.pixels.data(), static_cast<uint32_t>(entry.pixels.size() * sizeof(entry.pixels[0]))));
-
-			const bgfx::Memory* verticesMem =
-			    bgfx::alloc(static_cast<uint32_t>(sizeof(FootprintVertex) * entry.triangles.size() * 3));
-			auto* vertices = reinterpret_cast<FootprintVertex*>(verticesMem->data);
+			auto& vertices = _pendingFootprintVertices.emplace_back(entry.triangles.size() * 3);
+			auto bounds = AxisAlignedBoundingBox {glm::vec3(std::numeric_limits<float>::max()),
+			                                      glm::vec3(std::numeric_limits<float>::lowest())};
 			// TODO (#749) Maybe use std::views::enumerate
 			for (uint8_t j = 0; const auto& t : entry.triangles)
 			{
 				for (uint8_t k = 0; k < 3; ++k)
 				{
-					// NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index): access is bound to size
 					auto& vertex = vertices[j];
 					++j;
 
@@ -101,12 +84,13 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 					vertex.pos.y = world.y;
 					vertex.texCoord.x = uv.x / footprint.header.width;
 					vertex.texCoord.y = uv.y / footprint.header.height;
+					bounds.minima = glm::min(bounds.minima, glm::vec3(world.x, 0.0f, world.y));
+					bounds.maxima = glm::max(bounds.maxima, glm::vec3(world.x, 0.0f, world.y));
 				}
 			}
 
-			auto* vertexBuffer = new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i), verticesMem, decl);
-			auto mesh = std::make_unique<Mesh>(vertexBuffer);
-			_footprints.emplace_back(Footprint {std::move(texture), std::move(mesh)});
+			// The texture and mesh are created by Upload
+			_footprints.emplace_back(Footprint {nullptr, nullptr, bounds});
 		}
 	}
 
@@ -145,7 +129,7 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 	for (uint32_t i = 0; i < submeshCount; ++i)
 	{
 		auto subMesh = std::make_unique<L3DSubMesh>(*this);
-		if (!subMesh->Load(l3d, i))
+		if (!subMesh->Prepare(l3d, i))
 		{
 			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open L3DSubMesh");
 			result = false;
@@ -161,6 +145,10 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 			_physicsMesh.reset(physicsMesh);
 			// FIXME(bwrsandman): Some meshes have multiple physics meshes
 		}
+		else
+		{
+			_lodMask |= static_cast<uint8_t>(subMesh->GetFlags().lodMask);
+		}
 		const auto& bb = subMesh->GetBoundingBox();
 		_boundingBox.minima = glm::min(_boundingBox.minima, bb.minima);
 		_boundingBox.maxima = glm::max(_boundingBox.maxima, bb.maxima);
@@ -169,10 +157,73 @@ bool L3DMesh::Load(const l3d::L3DFile& l3d) noexcept
 	}
 	// TODO(bwrsandman): if no physics mesh was found, make physics mesh the bounding box
 
+	return result;
+}
+
+void L3DMesh::Upload(const l3d::L3DFile& l3d) noexcept
+{
+	auto* skinPacker = SkinArrayPacker::GetActive();
+	for (const auto& skin : l3d.GetSkins())
+	{
+		if (skinPacker != nullptr)
+		{
+			_skinLayers.insert_or_assign(skin.id, skinPacker->Add(skin));
+			continue;
+		}
+		_skins[skin.id] = std::make_unique<Texture2D>(_debugName.c_str());
+		_skins[skin.id]->Create(
+		    l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, 1, TextureFormat::BGRA4, Wrapping::Repeat, Filter::Linear,
+		    bgfx::copy(skin.texels.data(), static_cast<uint32_t>(skin.texels.size() * sizeof(skin.texels[0]))));
+	}
+
+	if (!_footprints.empty())
+	{
+		VertexDecl decl;
+		decl.reserve(1);
+		decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+		decl.emplace_back(VertexAttrib::Attribute::TexCoord0, static_cast<uint8_t>(2), VertexAttrib::Type::Float);
+
+		const auto& footprint = *l3d.GetFootprint();
+		for (size_t i = 0; i < _footprints.size(); ++i)
+		{
+			const auto& entry = footprint.entries[i];
+			const auto& vertices = _pendingFootprintVertices[i];
+			auto texture = std::make_unique<Texture2D>("footprints/texture/" + _debugName + "/" + std::to_string(i + 1));
+			texture->Create(
+			    static_cast<uint16_t>(footprint.header.width), static_cast<uint16_t>(footprint.header.height), 1,
+			    graphics::TextureFormat::BGRA4, Wrapping::ClampEdge, Filter::Linear,
+			    bgfx::copy(entry.pixels.data(), static_cast<uint32_t>(entry.pixels.size() * sizeof(entry.pixels[0]))));
+
+			const auto* verticesMem =
+			    bgfx::copy(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(vertices[0])));
+			auto* vertexBuffer =
+			    new VertexBuffer("footprints/quad/" + _debugName + "/" + std::to_string(i + 2), verticesMem, decl);
+			_footprints[i].texture = std::move(texture);
+			_footprints[i].mesh = std::make_unique<Mesh>(vertexBuffer);
+		}
+		_pendingFootprintVertices = {};
+	}
+
+	for (auto& subMesh : _subMeshes)
+	{
+		subMesh->Upload();
+	}
+
 	// TODO(bwrsandman): store vertex and index buffers at mesh level
-	bgfx::frame();
+	// Vertex and index buffers of the submeshes and footprints
+	UploadBatch::ResourcesCreated(static_cast<uint32_t>(_subMeshes.size() * 2 + _footprints.size()));
+}
 
-	return result;
+uint8_t L3DMesh::GetAvailableLod(uint8_t lod) const
+{
+	for (; lod > 0; --lod)
+	{
+		if ((_lodMask & (1u << lod)) != 0)
+		{
+			break;
+		}
+	}
+	return lod;
 }
 
 bool L3DMesh::LoadFromFilesystem(const std::filesystem::path& path) noexcept
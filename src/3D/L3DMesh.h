@@ -17,10 +17,12 @@
 
 #include <L3DFile.h>
 #include <glm/gtc/quaternion.hpp>
+#include <glm/vec2.hpp>
 
 #include "AxisAlignedBoundingBox.h"
 #include "Graphics/Mesh.h"
 #include "Graphics/ShaderProgram.h"
+#include "Graphics/SkinArrayPacker.h"
 
 class btConvexShape;
 
@@ -87,11 +89,20 @@ class L3DMesh
 	{
 		std::unique_ptr<graphics::Texture2D> texture;
 		std::unique_ptr<graphics::Mesh> mesh;
+		AxisAlignedBoundingBox bounds; ///< In model space, footprints are flat so the height is always 0
 	};
+	/// Number of levels of detail which can be set in the submesh lod masks, 0 being the most detailed
+	static constexpr uint8_t k_LodCount = 3;
+
 	explicit L3DMesh(std::string debugName = "") noexcept;
 	virtual ~L3DMesh() noexcept;
 
+	/// Prepare then upload the mesh
 	bool Load(const l3d::L3DFile& l3d) noexcept;
+	/// Convert everything which doesn't need the GPU, safe to call from any thread
+	bool Prepare(const l3d::L3DFile& l3d) noexcept;
+	/// Create the textures and buffers of a prepared mesh from the same file, main thread only
+	void Upload(const l3d::L3DFile& l3d) noexcept;
 	bool LoadFromFilesystem(const std::filesystem::path& path) noexcept;
 	bool LoadFromFile(const std::filesystem::path& path) noexcept;
 	bool LoadFromBuffer(const std::vector<uint8_t>& data) noexcept;
@@ -99,6 +110,8 @@ class L3DMesh
 	[[nodiscard]] uint8_t GetNumSubMeshes() const { return static_cast<uint8_t>(_subMeshes.size()); }
 	[[nodiscard]] const std::vector<std::unique_ptr<L3DSubMesh>>& GetSubMeshes() const { return _subMeshes; }
 	[[nodiscard]] const std::unordered_map<SkinId, std::unique_ptr<graphics::Texture2D>>& GetSkins() const { return _skins; }
+	/// Skins which were packed in texture arrays when loaded, they are not in \ref GetSkins
+	[[nodiscard]] const std::unordered_map<SkinId, graphics::SkinLayer>& GetSkinLayers() const { return _skinLayers; }
 	[[nodiscard]] const std::vector<Footprint>& GetFootprints() const { return _footprints; }
 	[[nodiscard]] const std::vector<uint32_t>& GetBoneParents() const { return _bonesParents; }
 	[[nodiscard]] const std::vector<glm::mat4>& GetBoneMatrices() const { return _bonesDefaultMatrices; }
@@ -109,13 +122,26 @@ class L3DMesh
 	[[nodiscard]] const btConvexShape& GetPhysicsMesh() const { return *_physicsMesh; }
 	[[nodiscard]] float GetMass() const { return _physicsMass; }
 	[[nodiscard]] AxisAlignedBoundingBox GetBoundingBox() const { return _boundingBox; }
+	/// Union of the lod masks of all drawable submeshes
+	[[nodiscard]] uint8_t GetLodMask() const { return _lodMask; }
+	/// Least detailed level available in the mesh which is at least as detailed as lod
+	[[nodiscard]] uint8_t GetAvailableLod(uint8_t lod) const;
 
 private:
+	struct FootprintVertex
+	{
+		glm::vec2 pos;
+		glm::vec2 texCoord;
+	};
+
 	l3d::L3DMeshFlags _flags;
 	std::string _debugName;
 
 	std::unordered_map<SkinId, std::unique_ptr<graphics::Texture2D>> _skins;
+	std::unordered_map<SkinId, graphics::SkinLayer> _skinLayers;
 	std::vector<Footprint> _footprints; ///< If ContainsLandscapeFeature() is true
+	/// Vertices of each footprint between Prepare and Upload
+	std::vector<std::vector<FootprintVertex>> _pendingFootprintVertices;
 	std::vector<std::unique_ptr<L3DSubMesh>> _subMeshes;
 	std::vector<uint32_t> _bonesParents;
 	std::vector<glm::mat4> _bonesDefaultMatrices;
@@ -129,6 +155,7 @@ class L3DMesh
 	    {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()},
 	};
 	std::string _nameData;
+	uint8_t _lodMask {0};
 
 public:
 	[[nodiscard]] const std::string& GetDebugName() const { return _debugName; }
@@ -40,7 +40,7 @@ L3DSubMesh::L3DSubMesh(L3DMesh& mesh) noexcept
 
 L3DSubMesh::~L3DSubMesh() noexcept = default;
 
-bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
+bool L3DSubMesh::Prepare(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 {
 	const auto& header = l3d.GetSubmeshHeaders()[meshIndex];
 	const auto primitiveSpan = l3d.GetPrimitiveSpan(meshIndex);
@@ -108,8 +108,8 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 	}
 
 	// Get vertices
-	const bgfx::Memory* verticesMem = bgfx::alloc(sizeof(EnhancedL3DVertex) * nVertices);
-	auto* verticesMemAccess = reinterpret_cast<EnhancedL3DVertex*>(verticesMem->data);
+	_pendingVertices.resize(nVertices);
+	auto* verticesMemAccess = _pendingVertices.data();
 	for (uint32_t i = 0; i < nVertices; ++i)
 	{
 		verticesMemAccess[i].pos = glm::make_vec3(&verticesSpan[i].position.x);
@@ -126,8 +126,8 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 	}
 
 	// Get Indices
-	const bgfx::Memory* indicesMem = bgfx::alloc(sizeof(uint16_t) * nIndices);
-	auto* indices = reinterpret_cast<uint16_t*>(indicesMem->data);
+	_pendingIndices.resize(nIndices);
+	auto* indices = _pendingIndices.data();
 
 	// Fill bone index
 	uint32_t vertexIndex = 0;
@@ -203,6 +203,13 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 		startIndex += static_cast<uint16_t>(primitive.numTriangles * 3);
 	}
 
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} submesh {} with {} verts and {} indices", _l3dMesh.GetDebugName(), meshIndex,
+	                    nVertices, nIndices);
+	return true;
+}
+
+void L3DSubMesh::Upload() noexcept
+{
 	VertexDecl decl;
 	decl.reserve(4);
 	decl.emplace_back(VertexAttrib::Attribute::Position, static_cast<uint8_t>(3), VertexAttrib::Type::Float);
@@ -211,13 +218,16 @@ bool L3DSubMesh::Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept
 	decl.emplace_back(VertexAttrib::Attribute::Indices, static_cast<uint8_t>(2), VertexAttrib::Type::Int16);
 
 	// build our buffers
+	const auto* verticesMem = bgfx::copy(_pendingVertices.data(),
+	                                     static_cast<uint32_t>(_pendingVertices.size() * sizeof(_pendingVertices[0])));
+	const auto* indicesMem =
+	    bgfx::copy(_pendingIndices.data(), static_cast<uint32_t>(_pendingIndices.size() * sizeof(_pendingIndices[0])));
 	auto* vertexBuffer = new VertexBuffer(_l3dMesh.GetDebugName(), verticesMem, decl);
 	auto* indexBuffer = new IndexBuffer(_l3dMesh.GetDebugName(), indicesMem, IndexBuffer::Type::Uint16);
 	_mesh = std::make_unique<graphics::Mesh>(vertexBuffer, indexBuffer);
 
-	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "{} submesh {} with {} verts and {} indices", _l3dMesh.GetDebugName(), meshIndex,
-	                    nVertices, nIndices);
-	return true;
+	_pendingVertices = {};
+	_pendingIndices = {};
 }
 
 Mesh& L3DSubMesh::GetMesh() const
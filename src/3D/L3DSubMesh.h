@@ -20,6 +20,11 @@
 
 #include "../Graphics/RenderPass.h"
 
+namespace openblack
+{
+struct EnhancedL3DVertex;
+}
+
 namespace openblack::graphics
 {
 class L3DMesh;
@@ -52,7 +57,10 @@ class L3DSubMesh
 	explicit L3DSubMesh(graphics::L3DMesh& mesh) noexcept;
 	~L3DSubMesh() noexcept;
 
-	bool Load(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept;
+	/// Convert the vertices and indices of the submesh, safe to call from any thread
+	bool Prepare(const l3d::L3DFile& l3d, uint32_t meshIndex) noexcept;
+	/// Create the buffers from the prepared vertices and indices, main thread only
+	void Upload() noexcept;
 
 	[[nodiscard]] openblack::l3d::L3DSubmeshHeader::Flags GetFlags() const { return _flags; }
 	[[nodiscard]] bool IsPhysics() const { return _flags.isPhysics; }
@@ -67,6 +75,9 @@ class L3DSubMesh
 
 	std::unique_ptr<graphics::Mesh> _mesh;
 	std::vector<Primitive> _primitives;
+	/// Between Prepare and Upload
+	std::vector<EnhancedL3DVertex> _pendingVertices;
+	std::vector<uint16_t> _pendingIndices;
 
 	AxisAlignedBoundingBox _boundingBox;
 };
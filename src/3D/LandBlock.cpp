@@ -11,6 +11,7 @@
 
 #include <cassert>
 
+#include <limits>
 #include <ranges>
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
@@ -65,6 +66,15 @@ void LandBlock::BuildMesh(LandIslandInterface& island)
 
 	BuildVertexList(vertices, island);
 
+	const auto mapOffset = glm::vec3(GetMapPosition().x, 0.0f, GetMapPosition().y);
+	_boundingBox.minima = glm::vec3(std::numeric_limits<float>::max());
+	_boundingBox.maxima = glm::vec3(std::numeric_limits<float>::lowest());
+	for (const auto& vertex : vertices)
+	{
+		_boundingBox.minima = glm::min(_boundingBox.minima, vertex.position + mapOffset);
+		_boundingBox.maxima = glm::max(_boundingBox.maxima, vertex.position + mapOffset);
+	}
+
 	auto* vertexBuffer = new VertexBuffer("LandBlock", verticesMem, decl);
 	_mesh = std::make_unique<Mesh>(vertexBuffer);
 
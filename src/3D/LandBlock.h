@@ -18,6 +18,7 @@
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
+#include "AxisAlignedBoundingBox.h"
 #include "LandIslandInterface.h"
 
 class btBvhTriangleMeshShape;
@@ -72,6 +73,8 @@ class LandBlock
 	[[nodiscard]] const lnd::LNDCell* GetCells() const;
 	[[nodiscard]] glm::ivec2 GetBlockPosition() const;
 	[[nodiscard]] glm::vec2 GetMapPosition() const;
+	/// World space bounds of the block mesh, computed in \ref BuildMesh
+	[[nodiscard]] const AxisAlignedBoundingBox& GetBoundingBox() const { return _boundingBox; }
 	[[nodiscard]] std::unique_ptr<btRigidBody>& GetRigidBody() { return _rigidBody; };
 	[[nodiscard]] const std::unique_ptr<lnd::LNDBlock>& GetLndBlock() const { return _block; };
 	void SetLndBlock(const lnd::LNDBlock& block);
@@ -82,6 +85,7 @@ class LandBlock
 	std::unique_ptr<dynamics::LandBlockBulletMeshInterface> _dynamicsMeshInterface;
 	std::unique_ptr<btBvhTriangleMeshShape> _physicsMesh;
 	std::unique_ptr<btRigidBody> _rigidBody;
+	AxisAlignedBoundingBox _boundingBox {};
 
 	void BuildVertexList(std::span<LandVertex> vertices, LandIslandInterface& island);
 };
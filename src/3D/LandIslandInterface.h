@@ -10,6 +10,8 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <entt/core/hashed_string.hpp>
@@ -38,8 +40,23 @@ class LandIslandInterface
 	static const float k_CellSize;
 	static constexpr entt::hashed_string k_SmallBumpTextureId = entt::hashed_string("raw/smallbumpa");
 
+	struct RayHit
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		/// Along the ray, in units of its direction
+		float distance;
+		/// Index of the hit block in GetBlocks()
+		int blockIndex;
+	};
+
 	[[nodiscard]] virtual float GetHeightAt(glm::vec2) const = 0;
 	[[nodiscard]] virtual glm::vec3 GetNormalAt(glm::vec2) const = 0;
+	/// Write the height at each of positions into heights, which must be of the same size
+	virtual void GetHeightsAt(std::span<const glm::vec2> positions, std::span<float> heights) const = 0;
+	/// Closest intersection with the triangles of the land blocks of a ray going no further than tMax times direction
+	[[nodiscard]] virtual std::optional<RayHit> RayCast(const glm::vec3& origin, const glm::vec3& direction,
+	                                                    float tMax) const = 0;
 	[[nodiscard]] virtual const lnd::LNDCell& GetCell(const glm::u16vec2& coordinates) const = 0;
 
 	// Debug
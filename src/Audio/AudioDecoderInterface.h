@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
+#include <span>
 #include <string>
 #include <vector>
 
@@ -19,8 +23,15 @@ namespace openblack::audio
 class AudioDecoderInterface
 {
 public:
-	virtual bool Open(const std::vector<uint8_t>& buffer) = 0;
+	virtual ~AudioDecoderInterface() = default;
+	/// The encoded buffer is not copied and must outlive the decoder
+	virtual bool Open(std::span<const uint8_t> buffer) = 0;
+	/// Decode the whole sound
 	virtual void Read(std::vector<int16_t>& buffer) = 0;
+	/// Decode the next frames which fit in buffer, returns the number of frames read, 0 once the end is reached
+	virtual size_t ReadFrames(std::span<int16_t> buffer) = 0;
+	/// Frames of the whole sound from its headers without decoding it, an estimate for formats without a length
+	[[nodiscard]] virtual uint64_t GetFrameCount() = 0;
 	[[nodiscard]] virtual ChannelLayout GetChannelLayout() = 0;
 };
 } // namespace openblack::audio
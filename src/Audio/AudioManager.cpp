@@ -13,7 +13,6 @@
 
 #include <fstream>
 
-#include <PackFile.h>
 #include <glm/gtc/constants.hpp>
 #include <spdlog/spdlog.h>
 
@@ -39,6 +38,9 @@ AudioManager::AudioManager()
 
 AudioManager::~AudioManager()
 {
+	// The music has no buffer of its own, its stream releases its buffers
+	StopMusic();
+
 	auto& registry = Locator::entitiesRegistry::value();
 	registry.Each<Transform, AudioEmitter>([this](entt::entity entity, const Transform&, const AudioEmitter& emitter) {
 		DestroyEmitter(entity);
@@ -80,6 +82,12 @@ void AudioManager::Update()
 		    {
 			    volume *= _sfxVolume;
 		    }
+		    // The music stream loops by queuing the track again, the source itself never loops and stops when it runs dry
+		    if (entity == _musicEntity)
+		    {
+			    _audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, false);
+			    return;
+		    }
 		    _audioPlayer->UpdateSource(emitter.sourceId, transform.position, volume, emitter.loop == PlayType::Repeat);
 		    auto audioStatus = _audioPlayer->GetStatus(emitter.sourceId);
 		    if (audioStatus == AudioStatus::Stopped)
@@ -87,6 +95,15 @@ void AudioManager::Update()
 			    DestroyEmitter(entity);
 		    }
 	    });
+
+	if (_musicStream != nullptr)
+	{
+		_musicStream->Update();
+		if (_musicStream->IsFinished())
+		{
+			StopMusic();
+		}
+	}
 }
 
 BufferId AudioManager::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
@@ -196,6 +213,10 @@ float AudioManager::GetProgress(entt::entity entity)
 	auto& registry = Locator::entitiesRegistry::value();
 	assert(registry.AnyOf<AudioEmitter>(entity));
 	auto& emitter = registry.Get<AudioEmitter>(entity);
+	if (entity == _musicEntity && _musicStream != nullptr)
+	{
+		return _musicStream->GetProgress();
+	}
 	auto sizeInBytes = Locator::resources::value().GetSounds().Handle(emitter.soundId)->sizeInBytes;
 	return _audioPlayer->GetProgress(sizeInBytes, emitter.sourceId);
 }
@@ -251,21 +272,29 @@ const std::map<std::string, SoundGroup>& AudioManager::GetSoundGroups()
 void AudioManager::PlayMusic(const std::string& packPath, PlayType type)
 {
 	StopMusic();
+
+	// Music is decoded and queued in chunks by the stream, the sound resource only holds its metadata
+	auto stream = std::make_unique<MusicStream>(*_audioPlayer);
+	if (!stream->Open(packPath))
+	{
+		return;
+	}
 	const entt::id_type id = entt::hashed_string(fmt::format("{}", packPath).c_str());
-	if (!Locator::resources::value().GetSounds().Contains(packPath))
+	if (!Locator::resources::value().GetSounds().Contains(id))
 	{
-		pack::PackFile soundPack;
-		soundPack.Open(packPath);
-		const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		const auto& audioData = soundPack.GetAudioSamplesData();
-		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[0], audioData);
+		Locator::resources::value().GetSounds().Load(id, resources::SoundLoader::FromBufferTag {}, stream->GetHeader(),
+		                                             std::vector<std::span<const uint8_t>> {});
 	}
 	auto sound = Locator::resources::value().GetSounds().Handle(id);
-	auto position = glm::one<glm::vec3>();
-	auto direction = glm::zero<glm::vec3>();
-	auto radius = glm::zero<glm::vec3>();
-	_musicEntity = CreateEmitter(id, type, position, direction, radius, sound->volume, AudioStatus::Playing, true);
-	PlayEmitter(_musicEntity);
+	auto& registry = Locator::entitiesRegistry::value();
+	_musicEntity = registry.Create();
+	auto sourceId = _audioPlayer->CreateSource(static_cast<float>(sound->pitch), true);
+	registry.Assign<AudioEmitter>(_musicEntity, sourceId, id, 0, glm::one<glm::vec3>(), glm::zero<glm::vec3>(),
+	                              glm::zero<glm::vec2>(), sound->volume, type, AudioStatus::Playing, true);
+	registry.Assign<Transform>(_musicEntity, glm::zero<glm::vec3>(), glm::one<glm::mat4>(), glm::one<glm::vec3>());
+
+	_musicStream = std::move(stream);
+	_musicStream->Start(sourceId, sound->volume * _globalVolume * _musicVolume, type == PlayType::Repeat);
 }
 
 void AudioManager::StopMusic()
@@ -277,6 +306,7 @@ void AudioManager::StopMusic()
 	}
 	auto& emitter = registry.Get<AudioEmitter>(_musicEntity);
 	// Clean up the audio player's music resources
+	_musicStream.reset();
 	_audioPlayer->StopSource(emitter.sourceId);
 	_audioPlayer->DeleteSource(emitter.sourceId);
 	[[maybe_unused]] auto music = Locator::resources::value().GetSounds().Handle(emitter.soundId);
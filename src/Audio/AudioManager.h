@@ -10,6 +10,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "AudioDecoderInterface.h"
 #include "AudioManagerInterface.h"
 #include "AudioPlayer.h"
+#include "MusicStream.h"
 #include "SoundGroup.h"
 
 #if !defined(LOCATOR_IMPLEMENTATIONS)
@@ -80,6 +82,8 @@ class AudioManager final: public AudioManagerInterface
 	float _musicVolume {1.0f};
 	float _sfxVolume {1.0f};
 	entt::entity _musicEntity {entt::null};
+	/// Decodes the music playing on the source of _musicEntity
+	std::unique_ptr<MusicStream> _musicStream;
 };
 
 } // namespace openblack::audio
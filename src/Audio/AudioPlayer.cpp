@@ -111,6 +111,14 @@ void AudioPlayer::UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front,
 }
 
 BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate)
+{
+	BufferId id;
+	alCheckCall(alGenBuffers(1, &id));
+	FillBuffer(id, layout, buffer, sampleRate);
+	return id;
+}
+
+void AudioPlayer::FillBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate)
 {
 	int playerLayout;
 	if (layout == ChannelLayout::Mono)
@@ -125,11 +133,8 @@ BufferId AudioPlayer::CreateBuffer(ChannelLayout layout, const std::vector<int16
 	{
 		throw std::runtime_error("Unknown channel layout");
 	}
-	BufferId id;
-	alCheckCall(alGenBuffers(1, &id));
 	auto bufferSize = static_cast<ALsizei>(buffer.size() * sizeof(buffer[0]));
 	alCheckCall(alBufferData(id, playerLayout, buffer.data(), bufferSize, sampleRate));
-	return id;
 }
 
 void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
@@ -137,6 +142,18 @@ void AudioPlayer::QueueBuffer(SourceId sourceId, BufferId bufferId)
 	alCheckCall(alSourceQueueBuffers(sourceId, 1, &bufferId));
 }
 
+std::vector<BufferId> AudioPlayer::UnqueueProcessedBuffers(SourceId sourceId)
+{
+	ALint processed;
+	alCheckCall(alGetSourcei(sourceId, AL_BUFFERS_PROCESSED, &processed));
+	std::vector<BufferId> buffers(static_cast<size_t>(processed));
+	if (processed > 0)
+	{
+		alCheckCall(alSourceUnqueueBuffers(sourceId, processed, buffers.data()));
+	}
+	return buffers;
+}
+
 void AudioPlayer::DeleteBuffer(BufferId id)
 {
 	alCheckCall(alDeleteBuffers(1, &id));
@@ -27,7 +27,9 @@ class AudioPlayer final: public AudioPlayerInterface
 	void Initialize() override;
 	void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const override;
 	BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) override;
+	void FillBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate) override;
 	void QueueBuffer(SourceId sourceId, BufferId buffer) override;
+	std::vector<BufferId> UnqueueProcessedBuffers(SourceId sourceId) override;
 	void DeleteBuffer(BufferId id) override;
 	void DeleteSource(SourceId id) override;
 	void UpdateSource(SourceId id, glm::vec3 pos, float volume, bool loop) override;
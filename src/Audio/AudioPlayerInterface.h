@@ -16,6 +16,7 @@ extern "C" {
 
 #include <filesystem>
 #include <queue>
+#include <span>
 #include <vector>
 
 #include <glm/vec3.hpp>
@@ -32,7 +33,11 @@ class AudioPlayerInterface
 	virtual void Initialize() = 0;
 	virtual void UpdateListener(glm::vec3 pos, glm::vec3 vel, glm::vec3 front, glm::vec3 up) const = 0;
 	[[nodiscard]] virtual BufferId CreateBuffer(ChannelLayout layout, const std::vector<int16_t>& buffer, int sampleRate) = 0;
+	/// Replace the contents of an existing buffer which isn't queued, used to refill streamed buffers
+	virtual void FillBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate) = 0;
 	virtual void QueueBuffer(SourceId sourceId, BufferId buffer) = 0;
+	/// Remove the buffers the source finished playing from its queue and return them
+	virtual std::vector<BufferId> UnqueueProcessedBuffers(SourceId sourceId) = 0;
 	virtual void DeleteBuffer(BufferId id) = 0;
 	[[nodiscard]] virtual SourceId CreateSource(float pitch, bool relative) = 0;
 	virtual void DeleteSource(SourceId id) = 0;
@@ -9,6 +9,10 @@
 
 #include "MpegAudioDecoder.h"
 
+#include <cassert>
+
+#include <array>
+
 #include <spdlog/spdlog.h>
 
 extern "C" {
@@ -27,10 +31,47 @@ extern "C" {
 
 using namespace openblack::audio;
 
-bool MpegAudioDecoder::Open(const std::vector<uint8_t>& buffer)
+namespace
+{
+/// Bits per second of the first MPEG layer III frame header of data, 0 if it has none
+uint32_t GetFirstFrameBitrate(std::span<const uint8_t> data)
 {
-	const auto status = drmp3_init_memory(&_mp3, buffer.data(), buffer.size(), nullptr);
-	return static_cast<bool>(status);
+	constexpr std::array<uint16_t, 15> k_Mpeg1Kbps = {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320};
+	constexpr std::array<uint16_t, 15> k_Mpeg2Kbps = {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160};
+	constexpr uint8_t k_Mpeg1 = 3;
+	constexpr uint8_t k_ReservedVersion = 1;
+	constexpr uint8_t k_Layer3 = 1;
+	for (size_t i = 0; i + 4 <= data.size(); ++i)
+	{
+		const auto version = (data[i + 1] >> 3) & 3;
+		const auto layer = (data[i + 1] >> 1) & 3;
+		const auto bitrateIndex = data[i + 2] >> 4;
+		const auto sampleRateIndex = (data[i + 2] >> 2) & 3;
+		if (data[i] != 0xFF || (data[i + 1] & 0xE0) != 0xE0 || version == k_ReservedVersion || layer != k_Layer3 ||
+		    bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3)
+		{
+			continue;
+		}
+		return (version == k_Mpeg1 ? k_Mpeg1Kbps : k_Mpeg2Kbps).at(bitrateIndex) * 1000u;
+	}
+	return 0;
+}
+} // namespace
+
+MpegAudioDecoder::~MpegAudioDecoder()
+{
+	if (_isOpen)
+	{
+		drmp3_uninit(&_mp3);
+	}
+}
+
+bool MpegAudioDecoder::Open(std::span<const uint8_t> buffer)
+{
+	assert(!_isOpen);
+	_isOpen = static_cast<bool>(drmp3_init_memory(&_mp3, buffer.data(), buffer.size(), nullptr));
+	_buffer = buffer;
+	return _isOpen;
 }
 
 void MpegAudioDecoder::Read(std::vector<int16_t>& buffer)
@@ -40,6 +81,23 @@ void MpegAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] const auto framesRead = drmp3_read_pcm_frames_s16(&_mp3, frameCount, buffer.data());
 }
 
+size_t MpegAudioDecoder::ReadFrames(std::span<int16_t> buffer)
+{
+	const auto frameCount = buffer.size() / _mp3.channels;
+	return static_cast<size_t>(drmp3_read_pcm_frames_s16(&_mp3, frameCount, buffer.data()));
+}
+
+uint64_t MpegAudioDecoder::GetFrameCount()
+{
+	// drmp3_get_pcm_frame_count goes through every frame of the stream, assume a constant bitrate instead
+	const auto bitrate = GetFirstFrameBitrate(_buffer);
+	if (bitrate == 0)
+	{
+		return 0;
+	}
+	return static_cast<uint64_t>(_buffer.size()) * 8 * _mp3.sampleRate / bitrate;
+}
+
 ChannelLayout MpegAudioDecoder::GetChannelLayout()
 {
 	switch (_mp3.channels)
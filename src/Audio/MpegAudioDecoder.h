@@ -19,12 +19,23 @@ namespace openblack::audio
 class MpegAudioDecoder final: public AudioDecoderInterface
 {
 public:
-	bool Open(const std::vector<uint8_t>& buffer) override;
+	MpegAudioDecoder() = default;
+	~MpegAudioDecoder() override;
+	MpegAudioDecoder(const MpegAudioDecoder&) = delete;
+	MpegAudioDecoder& operator=(const MpegAudioDecoder&) = delete;
+	MpegAudioDecoder(MpegAudioDecoder&&) = delete;
+	MpegAudioDecoder& operator=(MpegAudioDecoder&&) = delete;
+
+	bool Open(std::span<const uint8_t> buffer) override;
 	void Read(std::vector<int16_t>& buffer) override;
+	size_t ReadFrames(std::span<int16_t> buffer) override;
+	[[nodiscard]] uint64_t GetFrameCount() override;
 	[[nodiscard]] ChannelLayout GetChannelLayout() override;
 
 private:
 	drmp3 _mp3;
+	std::span<const uint8_t> _buffer;
+	bool _isOpen {false};
 };
 
 } // namespace openblack::audio
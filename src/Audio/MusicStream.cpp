@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MusicStream.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "FileSystem/FileSystemInterface.h"
+#include "Locator.h"
+#include "MpegAudioDecoder.h"
+#include "WavAudioDecoder.h"
+
+using namespace openblack::audio;
+
+namespace
+{
+size_t GetChannelCount(ChannelLayout layout)
+{
+	return layout == ChannelLayout::Mono ? 1 : 2;
+}
+
+/// Music packs hold mp3 samples, wav samples are decoded too like in the sound packs. Only wav has a header to check, so
+/// it is tried first
+std::unique_ptr<AudioDecoderInterface> OpenDecoder(std::span<const uint8_t> sample)
+{
+	auto wavDecoder = std::make_unique<WavAudioDecoder>();
+	if (wavDecoder->Open(sample))
+	{
+		return wavDecoder;
+	}
+	auto mpegDecoder = std::make_unique<MpegAudioDecoder>();
+	if (mpegDecoder->Open(sample))
+	{
+		return mpegDecoder;
+	}
+	return nullptr;
+}
+} // namespace
+
+MusicStream::MusicStream(AudioPlayerInterface& player) noexcept
+    : _player(player)
+{
+}
+
+MusicStream::~MusicStream() noexcept
+{
+	Stop();
+}
+
+bool MusicStream::Open(const std::filesystem::path& packPath)
+{
+	// Memory map the pack when it is a file on disk, otherwise read it whole
+	auto result = _pack.Open(packPath);
+	if (result == pack::PackResult::ErrCantOpen)
+	{
+		result = _pack.Open(Locator::filesystem::value().ReadAll(packPath));
+	}
+	if (result == pack::PackResult::Success)
+	{
+		result = _pack.ResolveAudioSamples();
+	}
+	if (result != pack::PackResult::Success)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to open music pack {}: {}", packPath.string(),
+		                    pack::ResultToStr(result));
+		return false;
+	}
+
+	try
+	{
+		const auto decoder = OpenDecoder(_pack.GetAudioSamplesData().front());
+		if (decoder == nullptr)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode music pack {}", packPath.string());
+			return false;
+		}
+		_channelLayout = decoder->GetChannelLayout();
+	}
+	catch (std::runtime_error& err)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("audio"), "Unable to decode music pack {}: {}", packPath.string(), err.what());
+		return false;
+	}
+	_sampleRate = static_cast<int>(GetHeader().sampleRate);
+
+	return true;
+}
+
+void MusicStream::Start(SourceId sourceId, float volume, bool loop)
+{
+	assert(!_thread.joinable());
+
+	_sourceId = sourceId;
+	_volume = volume;
+	_loop = loop;
+	_freeBuffers.clear();
+	for (size_t i = 0; i < _buffers.size(); ++i)
+	{
+		_buffers[i] = _player.CreateBuffer(_channelLayout, {}, _sampleRate);
+		_freeBuffers.push_back(i);
+	}
+	_thread = std::thread(&MusicStream::Decode, this);
+}
+
+void MusicStream::Update()
+{
+	if (!_thread.joinable() || _finished)
+	{
+		return;
+	}
+
+	// Checked before unqueuing so a source which stops in between doesn't replay buffers which weren't unqueued
+	const auto status = _player.GetStatus(_sourceId);
+
+	for (const auto buffer : _player.UnqueueProcessedBuffers(_sourceId))
+	{
+		const auto index = static_cast<size_t>(std::distance(_buffers.begin(), std::ranges::find(_buffers, buffer)));
+		assert(index < _buffers.size());
+		_framesPlayed += _bufferFrames[index];
+		_freeBuffers.push_back(index);
+	}
+
+	const auto channels = GetChannelCount(_channelLayout);
+	bool endOfPack = false;
+	while (!_freeBuffers.empty())
+	{
+		std::vector<int16_t> pcm;
+		{
+			const std::lock_guard lock(_mutex);
+			if (_chunks.empty())
+			{
+				endOfPack = _endOfPack;
+				break;
+			}
+			pcm = std::move(_chunks.front());
+			_chunks.pop_front();
+		}
+		_chunkConsumed.notify_one();
+
+		const auto index = _freeBuffers.back();
+		_freeBuffers.pop_back();
+		_player.FillBuffer(_buffers[index], _channelLayout, pcm, _sampleRate);
+		_bufferFrames[index] = pcm.size() / channels;
+		_player.QueueBuffer(_sourceId, _buffers[index]);
+	}
+
+	if (status == AudioStatus::Initial || status == AudioStatus::Stopped)
+	{
+		if (_freeBuffers.size() == _buffers.size())
+		{
+			_finished = endOfPack;
+			return;
+		}
+		// Either the first buffers were just queued, or the source ran out of buffers before they could be refilled
+		_player.PlaySource(_sourceId, _volume, false);
+	}
+}
+
+void MusicStream::Stop()
+{
+	if (!_thread.joinable())
+	{
+		return;
+	}
+
+	{
+		const std::lock_guard lock(_mutex);
+		_stop = true;
+	}
+	_chunkConsumed.notify_one();
+	_thread.join();
+	_chunks.clear();
+
+	_player.StopSource(_sourceId);
+	// Every queued buffer is processed once the source is stopped
+	[[maybe_unused]] const auto unqueued = _player.UnqueueProcessedBuffers(_sourceId);
+	for (auto& buffer : _buffers)
+	{
+		_player.DeleteBuffer(buffer);
+		buffer = 0;
+	}
+}
+
+float MusicStream::GetProgress() const
+{
+	const uint64_t totalFrames = _totalFrames;
+	if (totalFrames == 0)
+	{
+		return 0.0f;
+	}
+	return static_cast<float>(_framesPlayed % totalFrames) / static_cast<float>(totalFrames);
+}
+
+void MusicStream::Decode()
+{
+	const auto channels = GetChannelCount(_channelLayout);
+	bool counted = false;
+	while (true)
+	{
+		std::vector<int16_t> pcm(k_FramesPerBuffer * channels);
+		const auto frames = DecodeFrames(pcm);
+		pcm.resize(frames * channels);
+
+		std::unique_lock lock(_mutex);
+		if (frames != 0)
+		{
+			_chunks.push_back(std::move(pcm));
+		}
+		// Counted once the source has enough to start playing
+		if (!counted && (frames == 0 || _chunks.size() == k_BufferCount))
+		{
+			lock.unlock();
+			CountFrames();
+			counted = true;
+			lock.lock();
+		}
+		if (frames == 0)
+		{
+			_endOfPack = true;
+			return;
+		}
+		_chunkConsumed.wait(lock, [this] { return _stop || _chunks.size() < k_BufferCount; });
+		if (_stop)
+		{
+			return;
+		}
+	}
+}
+
+size_t MusicStream::DecodeFrames(std::span<int16_t> pcm)
+{
+	const auto channels = GetChannelCount(_channelLayout);
+	size_t frames = 0;
+	while (frames < k_FramesPerBuffer)
+	{
+		if (_decoder == nullptr && !OpenNextSample())
+		{
+			break;
+		}
+		const auto read = _decoder->ReadFrames(pcm.subspan(frames * channels));
+		if (read == 0)
+		{
+			_decoder.reset();
+			continue;
+		}
+		frames += read;
+	}
+	return frames;
+}
+
+bool MusicStream::OpenNextSample()
+{
+	const auto& samples = _pack.GetAudioSamplesData();
+	// Give up after a full pass over the samples without one that can be decoded
+	for (size_t attempt = 0; attempt < samples.size(); ++attempt)
+	{
+		if (_nextSample == samples.size())
+		{
+			if (!_loop)
+			{
+				return false;
+			}
+			_nextSample = 0;
+		}
+
+		const auto index = _nextSample++;
+		bool decodable;
+		try
+		{
+			_decoder = OpenDecoder(samples[index]);
+			decodable = _decoder != nullptr && _decoder->GetChannelLayout() == _channelLayout;
+		}
+		catch (std::runtime_error&)
+		{
+			decodable = false;
+		}
+		if (decodable)
+		{
+			return true;
+		}
+		SPDLOG_LOGGER_WARN(spdlog::get("audio"), "Skipping music sample {} which can't be decoded",
+		                   _pack.GetAudioSampleHeaders()[index].name.data());
+		_decoder.reset();
+	}
+	return false;
+}
+
+void MusicStream::CountFrames()
+{
+	uint64_t totalFrames = 0;
+	for (const auto& sample : _pack.GetAudioSamplesData())
+	{
+		if (const auto decoder = OpenDecoder(sample))
+		{
+			totalFrames += decoder->GetFrameCount();
+		}
+	}
+	_totalFrames = totalFrames;
+}
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <MappedPackFile.h>
+
+#include "AudioDecoderInterface.h"
+#include "AudioPlayerInterface.h"
+
+namespace openblack::audio
+{
+
+/// Plays a music pack on a source by decoding it in chunks on a background thread.
+///
+/// The samples of the pack are played one after the other through a small ring of buffers which are refilled and queued
+/// again as soon as the source is done with them, so memory use doesn't depend on the length of the track.
+///
+/// The background thread only decodes, the player is only used by the thread calling Start, Update and Stop, as OpenAL
+/// errors are reported per context and not per thread.
+class MusicStream
+{
+public:
+	static constexpr size_t k_BufferCount = 4;
+	static constexpr size_t k_FramesPerBuffer = 16384;
+
+	explicit MusicStream(AudioPlayerInterface& player) noexcept;
+	~MusicStream() noexcept;
+	MusicStream(const MusicStream&) = delete;
+	MusicStream& operator=(const MusicStream&) = delete;
+	MusicStream(MusicStream&&) = delete;
+	MusicStream& operator=(MusicStream&&) = delete;
+
+	/// Map the pack, returns false if it has no audio samples
+	bool Open(const std::filesystem::path& packPath);
+	[[nodiscard]] const pack::AudioBankSampleHeader& GetHeader() const { return _pack.GetAudioSampleHeaders().front(); }
+
+	/// Create the buffers and start decoding, the source plays once Update queued them
+	void Start(SourceId sourceId, float volume, bool loop);
+	/// Queue the decoded chunks in the buffers the source is done with and restart it if it ran dry
+	void Update();
+	/// Stop the thread and the source and release the buffers
+	void Stop();
+
+	/// The whole pack was played and loop is off
+	[[nodiscard]] bool IsFinished() const { return _finished; }
+	[[nodiscard]] float GetProgress() const;
+
+private:
+	/// Decode the pack on the background thread, staying at most k_BufferCount chunks ahead of the source
+	void Decode();
+	/// Decode the next frames of the pack into pcm, returns the number of frames read, 0 at the end of the pack
+	size_t DecodeFrames(std::span<int16_t> pcm);
+	/// Open the decoder on the next sample of the pack, wrapping around if looping
+	bool OpenNextSample();
+	/// Only needed for the progress, the frames of mp3 samples are estimated from their bitrate
+	void CountFrames();
+
+	AudioPlayerInterface& _player;
+	pack::MappedPackFile _pack;
+	ChannelLayout _channelLayout {ChannelLayout::Stereo};
+	int _sampleRate {0};
+	bool _loop {false};
+
+	// Only used by the decoding thread once started
+	std::unique_ptr<AudioDecoderInterface> _decoder;
+	size_t _nextSample {0};
+
+	// Only used by the thread owning the player
+	SourceId _sourceId {0};
+	float _volume {1.0f};
+	std::array<BufferId, k_BufferCount> _buffers {};
+	/// Frames in each buffer of the ring, to count the played frames when they are unqueued
+	std::array<size_t, k_BufferCount> _bufferFrames {};
+	/// Indices of the buffers which aren't queued on the source
+	std::vector<size_t> _freeBuffers;
+	uint64_t _framesPlayed {0};
+	bool _finished {false};
+
+	/// Guards the chunks and the flags shared with the decoding thread
+	std::mutex _mutex;
+	std::condition_variable _chunkConsumed;
+	/// Decoded chunks waiting for a free buffer
+	std::deque<std::vector<int16_t>> _chunks;
+	bool _endOfPack {false};
+	bool _stop {false};
+	std::atomic<uint64_t> _totalFrames {0};
+	std::thread _thread;
+};
+
+} // namespace openblack::audio
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <memory>
 #include <queue>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -20,6 +22,11 @@ extern "C" {
 #include <AL/alc.h>
 }
 
+namespace openblack::pack
+{
+class MappedPackFile;
+}
+
 namespace openblack::audio
 {
 using SourceId = ALuint;
@@ -230,7 +237,10 @@ class Sound
 	PlayType playType;
 	BufferId bufferId;
 	float duration;
-	std::vector<std::vector<uint8_t>> buffer;
+	/// Encoded data, pointing into the pack
+	std::vector<std::span<const uint8_t>> buffer;
+	/// Keeps the memory of buffer alive
+	std::shared_ptr<const pack::MappedPackFile> pack;
 	size_t sizeInBytes;
 };
 } // namespace openblack::audio
@@ -9,6 +9,8 @@
 
 #include "WavAudioDecoder.h"
 
+#include <cassert>
+
 #include <spdlog/spdlog.h>
 
 extern "C" {
@@ -18,10 +20,19 @@ extern "C" {
 
 using namespace openblack::audio;
 
-bool WavAudioDecoder::Open(const std::vector<uint8_t>& buffer)
+WavAudioDecoder::~WavAudioDecoder()
 {
-	const auto status = drwav_init_memory(&_wav, buffer.data(), buffer.size(), nullptr);
-	return static_cast<bool>(status);
+	if (_isOpen)
+	{
+		drwav_uninit(&_wav);
+	}
+}
+
+bool WavAudioDecoder::Open(std::span<const uint8_t> buffer)
+{
+	assert(!_isOpen);
+	_isOpen = static_cast<bool>(drwav_init_memory(&_wav, buffer.data(), buffer.size(), nullptr));
+	return _isOpen;
 }
 
 void WavAudioDecoder::Read(std::vector<int16_t>& buffer)
@@ -32,6 +43,19 @@ void WavAudioDecoder::Read(std::vector<int16_t>& buffer)
 	[[maybe_unused]] auto framesRead = drwav_read_pcm_frames_s16(&_wav, frameCount, buffer.data());
 }
 
+size_t WavAudioDecoder::ReadFrames(std::span<int16_t> buffer)
+{
+	const auto frameCount = buffer.size() / _wav.channels;
+	return static_cast<size_t>(drwav_read_pcm_frames_s16(&_wav, frameCount, buffer.data()));
+}
+
+uint64_t WavAudioDecoder::GetFrameCount()
+{
+	drwav_uint64 frameCount;
+	drwav_get_length_in_pcm_frames(&_wav, &frameCount);
+	return frameCount;
+}
+
 ChannelLayout WavAudioDecoder::GetChannelLayout()
 {
 	switch (_wav.channels)
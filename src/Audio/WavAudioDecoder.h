@@ -19,12 +19,22 @@ namespace openblack::audio
 class WavAudioDecoder final: public AudioDecoderInterface
 {
 public:
-	bool Open(const std::vector<uint8_t>& buffer) override;
+	WavAudioDecoder() = default;
+	~WavAudioDecoder() override;
+	WavAudioDecoder(const WavAudioDecoder&) = delete;
+	WavAudioDecoder& operator=(const WavAudioDecoder&) = delete;
+	WavAudioDecoder(WavAudioDecoder&&) = delete;
+	WavAudioDecoder& operator=(WavAudioDecoder&&) = delete;
+
+	bool Open(std::span<const uint8_t> buffer) override;
 	void Read(std::vector<int16_t>& buffer) override;
+	size_t ReadFrames(std::span<int16_t> buffer) override;
+	[[nodiscard]] uint64_t GetFrameCount() override;
 	[[nodiscard]] ChannelLayout GetChannelLayout() override;
 
 private:
 	drwav _wav;
+	bool _isOpen {false};
 };
 
 } // namespace openblack::audio
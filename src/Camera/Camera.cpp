@@ -66,6 +66,11 @@ glm::mat4 Camera::GetViewProjectionMatrix(Projection projection, Interpolation i
 	return GetProjectionMatrix(projection) * GetViewMatrix(interpolation);
 }
 
+Frustum Camera::GetFrustum(Interpolation interpolation) const
+{
+	return Frustum(GetViewProjectionMatrix(Projection::Normal, interpolation));
+}
+
 std::optional<ecs::components::Transform> Camera::RaycastMouseToLand(bool includeWater, Interpolation interpolation) const
 {
 	// get the hit by raycasting to the land down via the mouse
@@ -9,6 +9,7 @@
 
 #include "DefaultWorldCameraModel.h"
 
+#include <array>
 #include <numeric>
 #include <ranges>
 
@@ -154,16 +155,25 @@ void DefaultWorldCameraModel::TiltZoom(glm::vec3& eulerAngles, float scalingFact
 
 float DefaultWorldCameraModel::GetVerticalLineInverseDistanceWeighingRayCast(const Camera& camera) const
 {
-	std::vector<float> inverseHitDistances;
-	inverseHitDistances.reserve(0x10);
-
-	for (int i = 0; i < 0x10; ++i)
+	std::array<Ray, 0x10> rays;
+	// TODO (#749) use std::views::enumerate
+	for (int i = 0; auto& ray : rays)
 	{
 		const glm::vec2 coord = glm::vec2(0.5f, i / 16.0f);
+		camera.DeprojectScreenToWorld(coord, ray.origin, ray.direction, Camera::Interpolation::Target);
+		ray.tMax = 1e10f;
+		++i;
+	}
+	std::array<ecs::systems::RayCastHit, 0x10> hits;
+	Locator::dynamicsSystem::value().RayCastClosestHits(rays, hits);
 
-		if (const auto hit = camera.RaycastScreenCoordToLand(coord, false, Camera::Interpolation::Target))
+	std::vector<float> inverseHitDistances;
+	inverseHitDistances.reserve(0x10);
+	for (const auto& hit : hits)
+	{
+		if (hit.has_value())
 		{
-			inverseHitDistances.push_back(1.0f / glm::length(hit->position - _targetOrigin));
+			inverseHitDistances.push_back(1.0f / glm::length(hit->first.position - _targetOrigin));
 		}
 	}
 
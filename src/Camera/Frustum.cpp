@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "Frustum.h"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_access.hpp>
+
+using namespace openblack;
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+	const auto x = glm::row(viewProjection, 0);
+	const auto y = glm::row(viewProjection, 1);
+	const auto z = glm::row(viewProjection, 2);
+	const auto w = glm::row(viewProjection, 3);
+
+	_planes[static_cast<size_t>(Plane::Left)] = w + x;
+	_planes[static_cast<size_t>(Plane::Right)] = w - x;
+	_planes[static_cast<size_t>(Plane::Bottom)] = w + y;
+	_planes[static_cast<size_t>(Plane::Top)] = w - y;
+	_planes[static_cast<size_t>(Plane::Near)] = w + z;
+	_planes[static_cast<size_t>(Plane::Far)] = w - z;
+
+	for (auto& plane : _planes)
+	{
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool Frustum::Intersects(const AxisAlignedBoundingBox& box) const
+{
+	for (const auto& plane : _planes)
+	{
+		// Corner of the box furthest along the plane normal
+		const glm::vec3 positive = {
+		    plane.x >= 0.0f ? box.maxima.x : box.minima.x,
+		    plane.y >= 0.0f ? box.maxima.y : box.minima.y,
+		    plane.z >= 0.0f ? box.maxima.z : box.minima.z,
+		};
+		if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Frustum::Intersects(const glm::vec3& center, float radius) const
+{
+	for (const auto& plane : _planes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+		{
+			return false;
+		}
+	}
+	return true;
+}
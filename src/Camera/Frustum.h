@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack
+{
+
+/// Six clipping planes of a view volume, extracted from a view-projection matrix (Gribb-Hartmann).
+/// The plane normals point inwards and are normalized so distances are in world units.
+class Frustum
+{
+public:
+	enum class Plane : uint8_t
+	{
+		Left,
+		Right,
+		Bottom,
+		Top,
+		Near,
+		Far,
+
+		_count
+	};
+
+	/// The view-projection matrix is expected to have a clip space depth of [-1, 1] (Camera::Projection::Normal)
+	explicit Frustum(const glm::mat4& viewProjection);
+
+	[[nodiscard]] const glm::vec4& GetPlane(Plane plane) const { return _planes.at(static_cast<size_t>(plane)); }
+
+	/// Conservative test, may return true for boxes close to but outside the corners of the frustum
+	[[nodiscard]] bool Intersects(const AxisAlignedBoundingBox& box) const;
+	[[nodiscard]] bool Intersects(const glm::vec3& center, float radius) const;
+
+private:
+	std::array<glm::vec4, static_cast<size_t>(Plane::_count)> _planes;
+};
+
+} // namespace openblack
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "JobSystem.h"
+
+#include <cassert>
+
+#include <optional>
+
+using namespace openblack;
+
+namespace
+{
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): index of the queue owned by the current thread
+thread_local uint32_t t_QueueIndex = 0;
+} // namespace
+
+JobSystem::JobSystem(uint32_t threadCount)
+{
+	if (threadCount == 0)
+	{
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	_queues.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; ++i)
+	{
+		_queues.emplace_back(std::make_unique<Queue>());
+	}
+	_workers.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i)
+	{
+		_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		const std::lock_guard lock(_wakeMutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (auto& worker : _workers)
+	{
+		worker.join();
+	}
+}
+
+uint32_t JobSystem::GetThreadIndex()
+{
+	return t_QueueIndex;
+}
+
+void JobSystem::Run(TaskGroup& group, Job job)
+{
+	group._pending.fetch_add(1, std::memory_order_relaxed);
+	if (_workers.empty())
+	{
+		job();
+		group._pending.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	auto& queue = *_queues[t_QueueIndex];
+	{
+		const std::lock_guard lock(queue.mutex);
+		queue.entries.push_back({std::move(job), &group});
+	}
+	{
+		// Under the lock so that a worker can't miss it between checking the count and going to sleep
+		const std::lock_guard lock(_wakeMutex);
+		_queued.fetch_add(1, std::memory_order_relaxed);
+	}
+	_wake.notify_one();
+}
+
+void JobSystem::Wait(TaskGroup& group)
+{
+	while (!group.Done())
+	{
+		if (!RunPending())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::RunPending()
+{
+	return RunPending(t_QueueIndex);
+}
+
+bool JobSystem::RunPending(uint32_t queueIndex)
+{
+	std::optional<Entry> entry;
+	{
+		auto& queue = *_queues[queueIndex];
+		const std::lock_guard lock(queue.mutex);
+		if (!queue.entries.empty())
+		{
+			entry = std::move(queue.entries.back());
+			queue.entries.pop_back();
+		}
+	}
+	for (size_t i = 1; !entry.has_value() && i < _queues.size(); ++i)
+	{
+		auto& queue = *_queues[(queueIndex + i) % _queues.size()];
+		const std::lock_guard lock(queue.mutex);
+		if (!queue.entries.empty())
+		{
+			entry = std::move(queue.entries.front());
+			queue.entries.pop_front();
+		}
+	}
+	if (!entry.has_value())
+	{
+		return false;
+	}
+
+	_queued.fetch_sub(1, std::memory_order_relaxed);
+	entry->job();
+	entry->group->_pending.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void JobSystem::WorkerLoop(uint32_t queueIndex)
+{
+	t_QueueIndex = queueIndex;
+	while (true)
+	{
+		if (RunPending(queueIndex))
+		{
+			continue;
+		}
+		std::unique_lock lock(_wakeMutex);
+		_wake.wait(lock, [this]() { return _stop || _queued.load(std::memory_order_relaxed) > 0; });
+		if (_stop)
+		{
+			assert(_queued == 0);
+			return;
+		}
+	}
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openblack
+{
+
+/// Fixed pool of worker threads, each with its own queue of jobs. Workers take the newest job of their own queue and when
+/// it is empty, steal the oldest job of another queue.
+/// Threads which are not workers share one more queue. A thread waiting for jobs runs queued jobs in the meantime, so jobs
+/// may themselves add jobs and wait for them.
+/// Jobs must not throw.
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+
+	/// Jobs which are waited for together
+	class TaskGroup
+	{
+	public:
+		[[nodiscard]] bool Done() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+		std::atomic<uint32_t> _pending {0};
+	};
+
+	/// threadCount includes the thread creating the jobs, 0 is one per hardware thread
+	explicit JobSystem(uint32_t threadCount = 0);
+	~JobSystem();
+
+	/// Number of threads running jobs, workers and the thread creating the jobs
+	[[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(_workers.size()) + 1; }
+	/// Index of the calling thread in [0, GetThreadCount()), 0 for threads which are not workers
+	[[nodiscard]] static uint32_t GetThreadIndex();
+
+	void Run(TaskGroup& group, Job job);
+	/// Run queued jobs until every job of group is done
+	void Wait(TaskGroup& group);
+	/// Run one queued job, returns false if there were none
+	bool RunPending();
+
+	/// Call func(begin, end) over [0, count) split in ranges of chunkSize, on all threads and the calling one.
+	/// Returns once every range was processed.
+	template <typename Func>
+	void ParallelForChunks(size_t count, size_t chunkSize, Func func)
+	{
+		chunkSize = std::max<size_t>(chunkSize, 1);
+		const auto chunkCount = (count + chunkSize - 1) / chunkSize;
+		if (chunkCount <= 1 || _workers.empty())
+		{
+			func(size_t {0}, count);
+			return;
+		}
+
+		TaskGroup group;
+		for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+		{
+			Run(group, [&func, chunk, chunkSize, count]() {
+				func(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+			});
+		}
+		func(size_t {0}, chunkSize);
+		Wait(group);
+	}
+
+	/// Call func(i) for every i in [0, count), in a few chunks per thread
+	template <typename Func>
+	void ParallelFor(size_t count, Func func)
+	{
+		const auto chunkSize = count / (GetThreadCount() * k_ChunksPerThread) + 1;
+		ParallelForChunks(count, chunkSize, [&func](size_t begin, size_t end) {
+			for (auto i = begin; i < end; ++i)
+			{
+				func(i);
+			}
+		});
+	}
+
+private:
+	/// More chunks than threads so that threads which finish early can steal from the others
+	static constexpr uint32_t k_ChunksPerThread = 4;
+
+	struct Entry
+	{
+		Job job;
+		TaskGroup* group;
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Entry> entries;
+	};
+
+	void WorkerLoop(uint32_t queueIndex);
+	bool RunPending(uint32_t queueIndex);
+
+	/// Queue 0 is shared by the threads which are not workers
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::vector<std::thread> _workers;
+	std::atomic<uint32_t> _queued {0};
+	std::mutex _wakeMutex;
+	std::condition_variable _wake;
+	bool _stop {false};
+};
+
+} // namespace openblack
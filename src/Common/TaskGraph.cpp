@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "JobSystem.h"
+
+using namespace openblack;
+
+namespace
+{
+bool Intersects(const std::vector<TaskGraph::ResourceId>& first, const std::vector<TaskGraph::ResourceId>& second)
+{
+	return std::ranges::any_of(first, [&second](auto id) { return std::ranges::find(second, id) != second.end(); });
+}
+
+bool HasAll(const std::vector<TaskGraph::ResourceId>& resources)
+{
+	return std::ranges::find(resources, TaskGraph::k_AllResources) != resources.end();
+}
+} // namespace
+
+bool TaskGraph::Conflicts(const Task& first, const Task& second)
+{
+	if (HasAll(first.reads) || HasAll(first.writes) || HasAll(second.reads) || HasAll(second.writes))
+	{
+		return true;
+	}
+	return Intersects(first.writes, second.writes) || Intersects(first.writes, second.reads) ||
+	       Intersects(first.reads, second.writes);
+}
+
+void TaskGraph::Add(std::string_view name, std::vector<ResourceId> reads, std::vector<ResourceId> writes, Func func,
+                    Affinity affinity)
+{
+	auto task = Task {name, std::move(reads), std::move(writes), std::move(func), affinity, {}, 0};
+	const auto index = _tasks.size();
+	for (auto& other : _tasks)
+	{
+		if (Conflicts(task, other))
+		{
+			other.dependents.push_back(index);
+			++task.dependencyCount;
+		}
+	}
+	_tasks.emplace_back(std::move(task));
+}
+
+void TaskGraph::Run(JobSystem& jobs) const
+{
+	std::vector<std::atomic<uint32_t>> remaining(_tasks.size());
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& task : _tasks)
+	{
+		remaining[i].store(task.dependencyCount, std::memory_order_relaxed);
+		++i;
+	}
+
+	JobSystem::TaskGroup group;
+	std::atomic<size_t> finished {0};
+	std::mutex callingThreadMutex;
+	std::vector<size_t> callingThreadReady;
+
+	// Called once all the dependencies of a task are done, from whichever thread finished the last of them
+	std::function<void(size_t)> schedule;
+	auto runTask = [this, &remaining, &finished, &schedule](size_t index) {
+		const auto& task = _tasks[index];
+		task.func();
+		for (const auto dependent : task.dependents)
+		{
+			if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				schedule(dependent);
+			}
+		}
+		finished.fetch_add(1, std::memory_order_release);
+	};
+	schedule = [this, &jobs, &group, &callingThreadMutex, &callingThreadReady, &runTask](size_t index) {
+		if (_tasks[index].affinity == Affinity::CallingThread)
+		{
+			const std::lock_guard lock(callingThreadMutex);
+			callingThreadReady.push_back(index);
+			return;
+		}
+		jobs.Run(group, [&runTask, index]() { runTask(index); });
+	};
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& task : _tasks)
+	{
+		if (task.dependencyCount == 0)
+		{
+			schedule(i);
+		}
+		++i;
+	}
+
+	while (finished.load(std::memory_order_acquire) < _tasks.size())
+	{
+		std::optional<size_t> index;
+		{
+			const std::lock_guard lock(callingThreadMutex);
+			if (!callingThreadReady.empty())
+			{
+				index = callingThreadReady.back();
+				callingThreadReady.pop_back();
+			}
+		}
+		if (index.has_value())
+		{
+			runTask(*index);
+		}
+		else if (!jobs.RunPending())
+		{
+			std::this_thread::yield();
+		}
+	}
+	jobs.Wait(group);
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include <entt/core/fwd.hpp>
+#include <entt/core/type_info.hpp>
+
+namespace openblack
+{
+class JobSystem;
+
+/// Systems of a frame or a turn with the resources each reads and writes, ECS components or anything else named by a hashed
+/// string. A task runs after every task added before it which writes what it reads or writes, or reads what it writes.
+/// Tasks which don't conflict run in parallel on the JobSystem.
+class TaskGraph
+{
+public:
+	using ResourceId = entt::id_type;
+	using Func = std::function<void()>;
+
+	/// Conflicts with every resource, for tasks which touch too much of the game to list or change the entities' components
+	static constexpr ResourceId k_AllResources = std::numeric_limits<ResourceId>::max();
+
+	enum class Affinity : uint8_t
+	{
+		AnyThread,
+		/// Only run on the thread calling Run, for tasks which call into the renderer, the windowing or the audio
+		CallingThread,
+	};
+
+	template <typename... Components>
+	[[nodiscard]] static std::vector<ResourceId> ComponentIds()
+	{
+		return {entt::type_hash<Components>::value()...};
+	}
+
+	void Add(std::string_view name, std::vector<ResourceId> reads, std::vector<ResourceId> writes, Func func,
+	         Affinity affinity = Affinity::AnyThread);
+	/// Run every task and return once they are all done, the graph can be run again
+	void Run(JobSystem& jobs) const;
+	void Clear() { _tasks.clear(); }
+
+	[[nodiscard]] size_t GetTaskCount() const { return _tasks.size(); }
+	/// Number of tasks which must run before the task at index
+	[[nodiscard]] size_t GetDependencyCount(size_t index) const { return _tasks.at(index).dependencyCount; }
+
+private:
+	struct Task
+	{
+		std::string_view name;
+		std::vector<ResourceId> reads;
+		std::vector<ResourceId> writes;
+		Func func;
+		Affinity affinity;
+		/// Tasks added later which have to wait for this one
+		std::vector<size_t> dependents;
+		uint32_t dependencyCount;
+	};
+
+	[[nodiscard]] static bool Conflicts(const Task& first, const Task& second);
+
+	std::vector<Task> _tasks;
+};
+
+} // namespace openblack
@@ -569,6 +569,19 @@ bool Gui::ShowMenu() noexcept
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Reflection"))
+			{
+				auto updateInterval = static_cast<int>(config.reflectionUpdateInterval);
+				if (ImGui::SliderInt("Update Interval", &updateInterval, 1, 16))
+				{
+					config.reflectionUpdateInterval = static_cast<uint32_t>(updateInterval);
+				}
+				ImGui::SliderFloat("Model Distance", &config.reflectionModelDistance, 0.0f, 2000.0f, "%.0f");
+				ImGui::SliderFloat("Reuse Distance", &config.reflectionReuseDistance, 0.0f, 10.0f, "%.2f");
+
+				ImGui::EndMenu();
+			}
+
 			if (ImGui::BeginMenu("Field of View"))
 			{
 				auto& camera = Locator::camera::value();
@@ -335,6 +335,7 @@ void MeshViewer::Update() noexcept
 		graphics::RendererInterface::L3DMeshSubmitDesc desc = {};
 		desc.viewId = k_ViewId;
 		desc.program = objectShader;
+		desc.skinArrayProgram = shaderManager.GetShader("ObjectSkinArray");
 		desc.state = state;
 		desc.modelMatrices = &identity;
 		desc.matrixCount = 1;
@@ -70,7 +70,10 @@ void PathFinding::Draw() noexcept
 		{
 			auto& transform = registry.Get<Transform>(_selectedVillager.value());
 			auto& wallHug = registry.Get<WallHug>(_selectedVillager.value());
-			ImGui::DragFloat3("Position", glm::value_ptr(transform.position));
+			if (ImGui::DragFloat3("Position", glm::value_ptr(transform.position)))
+			{
+				registry.SetDirty(*_selectedVillager);
+			}
 			ImGui::DragFloat2("Goal", glm::value_ptr(wallHug.goal));
 			ImGui::DragFloat("Speed", &wallHug.speed);
 		}
@@ -98,6 +101,7 @@ void PathFinding::Draw() noexcept
 				if (ImGui::Button("Execute"))
 				{
 					registry.Get<Transform>(*_selectedVillager).position = _destination;
+					registry.SetDirty(*_selectedVillager);
 				}
 				ImGui::PopItemFlag();
 				ImGui::PopStyleVar();
@@ -16,6 +16,7 @@
 
 #include "ECS/Components/Transform.h"
 #include "ECS/Components/Tree.h"
+#include "ECS/Map.h"
 #include "ECS/Registry.h"
 #include "EngineConfig.h"
 #include "Graphics/RendererInterface.h"
@@ -74,6 +75,7 @@ void Profiler::Draw() noexcept
 	ImGui::NextColumn();
 	ImGui::Checkbox("Sprites", &config.drawSprites);
 	ImGui::Columns(1);
+	ImGui::Checkbox("Frustum Culling", &config.frustumCulling);
 
 	auto width = ImGui::GetColumnWidth() - ImGui::CalcTextSize("Frame").x;
 	ImGui::PlotHistogram("Frame", _times.values.data(), decltype(_times)::k_BufferSize, _times.offset, frameTextOverlay.data(),
@@ -95,6 +97,11 @@ void Profiler::Draw() noexcept
 	ImGui::Text("Memory Texture %" PRId64 ", RenderTarget %" PRId64, stats->textureMemoryUsed, stats->rtMemoryUsed);
 	ImGui::Text("Num Programs %u, Num Shaders %u, Uniforms %u", stats->numPrograms, stats->numShaders, stats->numUniforms);
 	ImGui::Text("Num Occlusion Queries %u", stats->numOcclusionQueries);
+	if (Locator::entitiesMap::has_value())
+	{
+		const auto mapMemory = Locator::entitiesMap::value().GetMemoryUsage();
+		ImGui::Text("Memory Entity Map Fixed %zu, Mobile %zu", mapMemory.fixedBytes, mapMemory.mobileBytes);
+	}
 
 	ImGui::Columns(1);
 
@@ -195,6 +202,34 @@ void Profiler::Draw() noexcept
 		ImGui::Text("    Unaccounted: %0.3f", 1000.0f * frameDuration / static_cast<double>(stats->gpuTimerFreq));
 	}
 	ImGui::Columns(1);
+
+	if (ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Columns(3);
+		ImGui::Text("Counter");
+		ImGui::NextColumn();
+		ImGui::Text("Last Frame");
+		ImGui::NextColumn();
+		ImGui::Text("Last %u Frames", openblack::Profiler::k_BufferSize);
+		ImGui::NextColumn();
+		// TODO (#749) use std::views::enumerate
+		for (uint8_t i = 0; const auto& name : openblack::Profiler::k_CounterNames)
+		{
+			uint32_t total = 0;
+			for (const auto& e : profiler.GetEntries())
+			{
+				total += e.counters.at(i);
+			}
+			ImGui::Text("%s", name.data());
+			ImGui::NextColumn();
+			ImGui::Text("%u", entry.counters.at(i));
+			ImGui::NextColumn();
+			ImGui::Text("%u", total);
+			ImGui::NextColumn();
+			++i;
+		}
+		ImGui::Columns(1);
+	}
 }
 
 void Profiler::Update() noexcept {}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "CommandBuffer.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace openblack::ecs;
+
+void CommandBuffer::Record(entt::entity entity, Command command)
+{
+	_entries.emplace_back(Entry {entity, std::move(command)});
+}
+
+void CommandBuffer::Apply(std::span<CommandBuffer> buffers, Registry& registry)
+{
+	std::vector<Entry> entries;
+	size_t count = 0;
+	for (const auto& buffer : buffers)
+	{
+		count += buffer._entries.size();
+	}
+	if (count == 0)
+	{
+		return;
+	}
+
+	entries.reserve(count);
+	for (auto& buffer : buffers)
+	{
+		std::move(buffer._entries.begin(), buffer._entries.end(), std::back_inserter(entries));
+		buffer._entries.clear();
+	}
+	std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		return entt::to_integral(a.entity) < entt::to_integral(b.entity);
+	});
+
+	for (auto& entry : entries)
+	{
+		entry.command(registry);
+	}
+}
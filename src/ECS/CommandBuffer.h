@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <entt/entity/entity.hpp>
+
+#include "ECS/Registry.h"
+
+namespace openblack::ecs
+{
+
+/// Changes to the registry recorded while entities are updated in parallel and applied later from a single thread.
+///
+/// Each command is recorded for the entity being updated. Since an entity is only updated by one thread, applying the
+/// commands of all buffers sorted by entity keeps the order of each entity's commands and does not depend on which thread
+/// updated which entity.
+class CommandBuffer
+{
+public:
+	using Command = std::function<void(Registry&)>;
+
+	void Record(entt::entity entity, Command command);
+
+	[[nodiscard]] bool Empty() const { return _entries.empty(); }
+	[[nodiscard]] size_t Size() const { return _entries.size(); }
+
+	/// Run the commands of all buffers, ordered by entity then by recording order, and clear the buffers
+	static void Apply(std::span<CommandBuffer> buffers, Registry& registry);
+
+private:
+	struct Entry
+	{
+		entt::entity entity;
+		Command command;
+	};
+
+	std::vector<Entry> _entries;
+};
+
+} // namespace openblack::ecs
@@ -9,10 +9,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
-#include <array>
-#include <unordered_set>
+#include <span>
 
 #include <entt/fwd.hpp>
 #include <glm/fwd.hpp>
@@ -29,16 +29,34 @@ class MapInterface
 	static constexpr float k_PositionToGridFactor = static_cast<float>(0x10000) * 0.1f;
 	static constexpr glm::u16vec2 k_GridSize = {0x200, 0x200};
 
+	virtual ~MapInterface() = default;
+
 	static CellId GetGridCell(const glm::vec2& pos);
 	static CellId GetGridCell(const glm::vec3& pos);
 	static glm::vec2 GetCellCenter(const CellId& cellId);
 
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const = 0;
-	[[nodiscard]] virtual const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const = 0;
+	struct MemoryUsage
+	{
+		size_t fixedBytes;
+		size_t mobileBytes;
+	};
+
+	/// The returned spans are invalidated by the next Update or Rebuild, and by any Fixed or Mobile component change
+	[[nodiscard]] virtual std::span<const entt::entity> GetFixedInGridCell(const CellId& cellId) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetFixedInGridCell(const glm::vec3& pos) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetMobileInGridCell(const CellId& cellId) const = 0;
+	[[nodiscard]] virtual std::span<const entt::entity> GetMobileInGridCell(const glm::vec3& pos) const = 0;
+	[[nodiscard]] virtual MemoryUsage GetMemoryUsage() const = 0;
 
+	/// Clear the whole grid and re-insert every fixed and mobile entity.
 	virtual void Rebuild() = 0;
+	/// Relink the entities marked dirty since the last update: mobile entities which have moved into a different cell and
+	/// fixed entities which have moved or changed scale. Otherwise entities are kept up to date as their Fixed, Mobile
+	/// and Transform components are constructed and destroyed.
+	virtual void Update() = 0;
+	/// The transform of the entity changed, relink it on the next Update if it is linked. An entity is only queued once
+	/// until the next Update.
+	virtual void SetDirty(entt::entity entity) = 0;
 
 private:
 	virtual void Clear() = 0;
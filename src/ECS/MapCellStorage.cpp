@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "MapCellStorage.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <limits>
+
+#include <entt/entity/entity.hpp>
+
+using namespace openblack::ecs;
+
+MapCellStorage::MapCellStorage(size_t cellCount)
+    : _slices(cellCount, Slice {0, 0, 0})
+{
+}
+
+std::span<const entt::entity> MapCellStorage::Get(size_t cellIndex) const
+{
+	const auto& slice = _slices.at(cellIndex);
+	return {_entities.data() + slice.offset, slice.size};
+}
+
+void MapCellStorage::Insert(size_t cellIndex, entt::entity entity)
+{
+	auto& slice = _slices.at(cellIndex);
+	const auto begin = _entities.begin() + slice.offset;
+	if (std::find(begin, begin + slice.size, entity) != begin + slice.size)
+	{
+		return;
+	}
+
+	if (slice.size == slice.capacity)
+	{
+		assert(slice.capacity <= std::numeric_limits<uint16_t>::max() / 2);
+		const auto capacity = static_cast<uint16_t>(std::max<uint16_t>(k_MinCapacity, slice.capacity * 2));
+		const auto offset = static_cast<uint32_t>(_entities.size());
+		_entities.resize(_entities.size() + capacity, entt::null);
+		std::copy_n(_entities.begin() + slice.offset, slice.size, _entities.begin() + offset);
+		_unused += slice.capacity;
+		slice.offset = offset;
+		slice.capacity = capacity;
+	}
+
+	_entities[slice.offset + slice.size] = entity;
+	++slice.size;
+}
+
+bool MapCellStorage::Erase(size_t cellIndex, entt::entity entity)
+{
+	auto& slice = _slices.at(cellIndex);
+	const auto begin = _entities.begin() + slice.offset;
+	const auto end = begin + slice.size;
+	const auto iter = std::find(begin, end, entity);
+	if (iter == end)
+	{
+		return false;
+	}
+	*iter = *(end - 1);
+	*(end - 1) = entt::null;
+	--slice.size;
+	return true;
+}
+
+void MapCellStorage::Clear()
+{
+	std::fill(_slices.begin(), _slices.end(), Slice {0, 0, 0});
+	_entities.clear();
+	_unused = 0;
+}
+
+void MapCellStorage::Compact()
+{
+	if (_unused * 2 <= _entities.size())
+	{
+		return;
+	}
+
+	std::vector<entt::entity> entities;
+	entities.reserve(_entities.size() - _unused);
+	for (auto& slice : _slices)
+	{
+		const auto offset = static_cast<uint32_t>(entities.size());
+		entities.insert(entities.end(), _entities.begin() + slice.offset, _entities.begin() + slice.offset + slice.size);
+		slice.offset = offset;
+		slice.capacity = slice.size;
+	}
+	_entities = std::move(entities);
+	_unused = 0;
+}
+
+size_t MapCellStorage::GetMemoryUsage() const
+{
+	return _slices.capacity() * sizeof(Slice) + _entities.capacity() * sizeof(entt::entity);
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <span>
+#include <vector>
+
+#include <entt/entity/fwd.hpp>
+
+namespace openblack::ecs
+{
+
+/// Entity lists of every cell of a grid, packed into a single contiguous array (CSR layout with slack).
+///
+/// Each cell owns a slice of the packed array. Removing swaps with the last entity of the slice. When a slice is full, it
+/// is moved to the end of the packed array with double the capacity and the old slice becomes unused. Unused space is
+/// reclaimed by Compact which tightly repacks all slices in cell order.
+/// Spans returned by Get are invalidated by any modification.
+class MapCellStorage
+{
+public:
+	explicit MapCellStorage(size_t cellCount);
+
+	[[nodiscard]] std::span<const entt::entity> Get(size_t cellIndex) const;
+
+	/// Add entity to cell if it isn't already in it
+	void Insert(size_t cellIndex, entt::entity entity);
+	/// Remove entity from cell, returns false if it wasn't in it
+	bool Erase(size_t cellIndex, entt::entity entity);
+	void Clear();
+	/// Repack the slices when more than half of the packed array is unused
+	void Compact();
+
+	[[nodiscard]] size_t GetMemoryUsage() const;
+
+private:
+	struct Slice
+	{
+		uint32_t offset;
+		uint16_t size;
+		uint16_t capacity;
+	};
+
+	static constexpr uint16_t k_MinCapacity = 4;
+
+	std::vector<Slice> _slices;
+	std::vector<entt::entity> _entities;
+	size_t _unused {0};
+};
+
+} // namespace openblack::ecs
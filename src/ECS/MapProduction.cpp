@@ -20,76 +20,276 @@
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
 #include "Locator.h"
+#include "Profiler.h"
 
 using namespace openblack::ecs;
 using namespace openblack::ecs::components;
 
-const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const CellId& cellId) const
+MapProduction::MapProduction()
+    : _fixedGrid(k_GridSize.x * k_GridSize.y)
+    , _mobileGrid(k_GridSize.x * k_GridSize.y)
 {
-	return _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
+	auto& registry = Locator::entitiesRegistry::value();
+	registry.OnConstruct<Fixed>().connect<&MapProduction::OnFixedConstruct>(*this);
+	registry.OnUpdate<Fixed>().connect<&MapProduction::OnFixedConstruct>(*this);
+	registry.OnDestroy<Fixed>().connect<&MapProduction::OnFixedDestroy>(*this);
+	registry.OnConstruct<Mobile>().connect<&MapProduction::OnMobileConstruct>(*this);
+	registry.OnDestroy<Mobile>().connect<&MapProduction::OnMobileDestroy>(*this);
+	registry.OnConstruct<Transform>().connect<&MapProduction::OnTransformConstruct>(*this);
+	registry.OnDestroy<Transform>().connect<&MapProduction::OnTransformDestroy>(*this);
+
+	// Entities created before the map are linked once, the signals keep the grid up to date afterwards
+	Build();
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetFixedInGridCell(const glm::vec3& pos) const
+MapProduction::~MapProduction()
+{
+	if (Locator::entitiesRegistry::has_value())
+	{
+		auto& registry = Locator::entitiesRegistry::value();
+		registry.OnConstruct<Fixed>().disconnect(*this);
+		registry.OnUpdate<Fixed>().disconnect(*this);
+		registry.OnDestroy<Fixed>().disconnect(*this);
+		registry.OnConstruct<Mobile>().disconnect(*this);
+		registry.OnDestroy<Mobile>().disconnect(*this);
+		registry.OnConstruct<Transform>().disconnect(*this);
+		registry.OnDestroy<Transform>().disconnect(*this);
+	}
+}
+
+std::span<const entt::entity> MapProduction::GetFixedInGridCell(const CellId& cellId) const
+{
+	return _fixedGrid.Get(cellId.x + cellId.y * k_GridSize.x);
+}
+
+std::span<const entt::entity> MapProduction::GetFixedInGridCell(const glm::vec3& pos) const
 {
 	const auto cellId = GetGridCell(pos);
 	return GetFixedInGridCell(cellId);
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetMobileInGridCell(const CellId& cellId) const
+std::span<const entt::entity> MapProduction::GetMobileInGridCell(const CellId& cellId) const
 {
-	return _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
+	return _mobileGrid.Get(cellId.x + cellId.y * k_GridSize.x);
 }
 
-const std::unordered_set<entt::entity>& MapProduction::GetMobileInGridCell(const glm::vec3& pos) const
+std::span<const entt::entity> MapProduction::GetMobileInGridCell(const glm::vec3& pos) const
 {
 	const auto cellId = GetGridCell(pos);
 	return GetMobileInGridCell(cellId);
 }
 
+MapInterface::MemoryUsage MapProduction::GetMemoryUsage() const
+{
+	return {
+	    .fixedBytes = _fixedGrid.GetMemoryUsage(),
+	    .mobileBytes = _mobileGrid.GetMemoryUsage(),
+	};
+}
+
 void MapProduction::Rebuild()
 {
+	Locator::profiler::value().Count(Profiler::Counter::MapRebuilds);
 	Clear();
 	Build();
+	_fixedGrid.Compact();
+	_mobileGrid.Compact();
 }
 
-void MapProduction::Clear()
+void MapProduction::Update()
 {
-	for (auto& g : _fixedGrid)
+	auto& registry = Locator::entitiesRegistry::value();
+	uint32_t relinked = 0;
+	for (const auto entity : _dirtyEntities)
 	{
-		g.clear();
+		if (!registry.Valid(entity) || !registry.AllOf<Transform>(entity))
+		{
+			continue;
+		}
+		const auto& transform = registry.Get<const Transform>(entity);
+		if (auto* fixed = registry.TryGet<Fixed>(entity))
+		{
+			RelinkFixed(entity, *fixed, transform);
+		}
+		if (!registry.AllOf<Mobile>(entity))
+		{
+			continue;
+		}
+		const auto iter = _mobileCells.find(entity);
+		if (iter != _mobileCells.end() && iter->second == GetGridCell(transform.position))
+		{
+			continue;
+		}
+		UnlinkMobile(entity);
+		LinkMobile(entity, transform);
+		++relinked;
 	}
-	for (auto& g : _mobileGrid)
+	_dirtyEntities.clear();
+	_queuedEntities.clear();
+	Locator::profiler::value().Count(Profiler::Counter::MapMobileRelinks, relinked);
+
+	// Spans from the previous turn are no longer held, reclaim space left by moved cells
+	_fixedGrid.Compact();
+	_mobileGrid.Compact();
+}
+
+void MapProduction::SetDirty(entt::entity entity)
+{
+	// Entities which aren't linked, like the hand, have nothing to relink
+	if (!_mobileCells.contains(entity) && !_fixedCells.contains(entity))
 	{
-		g.clear();
+		return;
 	}
+	if (_queuedEntities.insert(entity).second)
+	{
+		_dirtyEntities.push_back(entity);
+	}
+}
+
+void MapProduction::Clear()
+{
+	_fixedGrid.Clear();
+	_mobileGrid.Clear();
+	_fixedCells.clear();
+	_mobileCells.clear();
+	_dirtyEntities.clear();
+	_queuedEntities.clear();
 }
 
 void MapProduction::Build()
 {
 	auto& registry = Locator::entitiesRegistry::value();
 	registry.Each<const Fixed, const Transform>([this](entt::entity entity, const Fixed& fixed, const Transform& transform) {
-		// TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
-		const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
-		const auto min = GetGridCell(fixed.boundingCenter - radius);
-		const auto max = GetGridCell(fixed.boundingCenter + radius);
+		LinkFixed(entity, fixed, transform);
+	});
+	registry.Each<const Mobile, const Transform>(
+	    [this](entt::entity entity, [[maybe_unused]] const Mobile& mobile, const Transform& transform) {
+		    LinkMobile(entity, transform);
+	    });
+}
+
+void MapProduction::LinkFixed(entt::entity entity, const Fixed& fixed, const Transform& transform)
+{
+	// TODO(bwrsandman): This is only in the case of a square bb underling the bounding circle (x/z) <= 1.4
+	const float radius = fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f;
+	const auto min = GetGridCell(fixed.boundingCenter - radius);
+	const auto max = GetGridCell(fixed.boundingCenter + radius);
 
-		for (uint16_t x = min.x; x < max.x + 1; ++x)
+	for (uint16_t x = min.x; x < max.x + 1; ++x)
+	{
+		for (uint16_t y = min.y; y < max.y + 1; ++y)
 		{
-			for (uint16_t y = min.y; y < max.y + 1; ++y)
+			const auto cellId = MapProduction::CellId(x, y);
+			if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
 			{
-				const auto cellId = MapProduction::CellId(x, y);
-				if (glm::distance2(GetCellCenter(cellId), fixed.boundingCenter) < radius * radius)
-				{
-					auto& cell = _fixedGrid.at(cellId.x + cellId.y * k_GridSize.x);
-					cell.insert(entity);
-				}
+				_fixedGrid.Insert(cellId.x + cellId.y * k_GridSize.x, entity);
 			}
 		}
-	});
-	registry.Each<const Mobile, const Transform>(
-	    [this](entt::entity entity, [[maybe_unused]] const Mobile& mobile, const Transform& transform) {
-		    const auto cellId = GetGridCell(transform.position);
-		    auto& cell = _mobileGrid.at(cellId.x + cellId.y * k_GridSize.x);
-		    cell.insert(entity);
-	    });
+	}
+	_fixedCells.insert_or_assign(entity, FixedLink {min, max, glm::xz(transform.position), radius});
+}
+
+void MapProduction::UnlinkFixed(entt::entity entity)
+{
+	const auto iter = _fixedCells.find(entity);
+	if (iter == _fixedCells.end())
+	{
+		return;
+	}
+	const auto& link = iter->second;
+	for (uint16_t x = link.min.x; x < link.max.x + 1; ++x)
+	{
+		for (uint16_t y = link.min.y; y < link.max.y + 1; ++y)
+		{
+			_fixedGrid.Erase(x + y * k_GridSize.x, entity);
+		}
+	}
+	_fixedCells.erase(iter);
+}
+
+void MapProduction::RelinkFixed(entt::entity entity, Fixed& fixed, const Transform& transform)
+{
+	const auto position = glm::xz(transform.position);
+	const auto iter = _fixedCells.find(entity);
+	if (iter != _fixedCells.end())
+	{
+		const auto& link = iter->second;
+		if (link.position == position && link.radius == fixed.boundingRadius * glm::compMax(transform.scale) + 1.0f)
+		{
+			return;
+		}
+		// The bounding circle moves with the entity, so that a rebuild links it to the same cells
+		fixed.boundingCenter += position - link.position;
+	}
+	UnlinkFixed(entity);
+	LinkFixed(entity, fixed, transform);
+}
+
+void MapProduction::LinkMobile(entt::entity entity, const Transform& transform)
+{
+	const auto cellId = GetGridCell(transform.position);
+	_mobileGrid.Insert(cellId.x + cellId.y * k_GridSize.x, entity);
+	_mobileCells.insert_or_assign(entity, cellId);
+}
+
+void MapProduction::UnlinkMobile(entt::entity entity)
+{
+	const auto iter = _mobileCells.find(entity);
+	if (iter == _mobileCells.end())
+	{
+		return;
+	}
+	const auto& cellId = iter->second;
+	_mobileGrid.Erase(cellId.x + cellId.y * k_GridSize.x, entity);
+	_mobileCells.erase(iter);
+}
+
+void MapProduction::OnFixedConstruct(entt::registry& registry, entt::entity entity)
+{
+	// Archetypes assign the transform first, entities without one are linked once it is assigned
+	if (const auto* transform = registry.try_get<Transform>(entity))
+	{
+		UnlinkFixed(entity);
+		LinkFixed(entity, registry.get<Fixed>(entity), *transform);
+	}
+}
+
+void MapProduction::OnFixedDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	UnlinkFixed(entity);
+}
+
+void MapProduction::OnMobileConstruct(entt::registry& registry, entt::entity entity)
+{
+	if (const auto* transform = registry.try_get<Transform>(entity))
+	{
+		UnlinkMobile(entity);
+		LinkMobile(entity, *transform);
+	}
+}
+
+void MapProduction::OnMobileDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	UnlinkMobile(entity);
+}
+
+void MapProduction::OnTransformConstruct(entt::registry& registry, entt::entity entity)
+{
+	if (const auto* fixed = registry.try_get<Fixed>(entity))
+	{
+		const auto& transform = registry.get<Transform>(entity);
+		UnlinkFixed(entity);
+		LinkFixed(entity, *fixed, transform);
+	}
+	if (registry.all_of<Mobile>(entity))
+	{
+		UnlinkMobile(entity);
+		LinkMobile(entity, registry.get<Transform>(entity));
+	}
+}
+
+void MapProduction::OnTransformDestroy([[maybe_unused]] entt::registry& registry, entt::entity entity)
+{
+	UnlinkFixed(entity);
+	UnlinkMobile(entity);
 }
@@ -13,26 +13,79 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <entt/entity/fwd.hpp>
+#include <glm/vec2.hpp>
+
 #include "Map.h"
+#include "MapCellStorage.h"
+
+namespace openblack::ecs::components
+{
+struct Fixed;
+struct Transform;
+} // namespace openblack::ecs::components
 
 namespace openblack::ecs
 {
 
 class MapProduction final: public MapInterface
 {
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const CellId& cellId) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetFixedInGridCell(const glm::vec3& pos) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const CellId& cellId) const override;
-	[[nodiscard]] const std::unordered_set<entt::entity>& GetMobileInGridCell(const glm::vec3& pos) const override;
+public:
+	MapProduction();
+	~MapProduction() override;
+
+	[[nodiscard]] std::span<const entt::entity> GetFixedInGridCell(const CellId& cellId) const override;
+	[[nodiscard]] std::span<const entt::entity> GetFixedInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] std::span<const entt::entity> GetMobileInGridCell(const CellId& cellId) const override;
+	[[nodiscard]] std::span<const entt::entity> GetMobileInGridCell(const glm::vec3& pos) const override;
+	[[nodiscard]] MemoryUsage GetMemoryUsage() const override;
 
 	void Rebuild() override;
+	void Update() override;
+	void SetDirty(entt::entity entity) override;
 
 private:
 	void Clear() override;
 	void Build() override;
 
-	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _fixedGrid;
-	std::array<std::unordered_set<entt::entity>, k_GridSize.x * k_GridSize.y> _mobileGrid;
+	void LinkFixed(entt::entity entity, const components::Fixed& fixed, const components::Transform& transform);
+	void UnlinkFixed(entt::entity entity);
+	void RelinkFixed(entt::entity entity, components::Fixed& fixed, const components::Transform& transform);
+	void LinkMobile(entt::entity entity, const components::Transform& transform);
+	void UnlinkMobile(entt::entity entity);
+
+	void OnFixedConstruct(entt::registry& registry, entt::entity entity);
+	void OnFixedDestroy(entt::registry& registry, entt::entity entity);
+	void OnMobileConstruct(entt::registry& registry, entt::entity entity);
+	void OnMobileDestroy(entt::registry& registry, entt::entity entity);
+	void OnTransformConstruct(entt::registry& registry, entt::entity entity);
+	void OnTransformDestroy(entt::registry& registry, entt::entity entity);
+
+	MapCellStorage _fixedGrid;
+	MapCellStorage _mobileGrid;
+
+	struct FixedLink
+	{
+		/// Bounds of cells the entity was linked to, used to unlink it
+		CellId min;
+		CellId max;
+		/// Position and radius it was linked with, used to detect moves and scale changes
+		glm::vec2 position;
+		float radius;
+	};
+
+	std::unordered_map<entt::entity, FixedLink> _fixedCells;
+	/// Cell a mobile entity is currently linked to, used to detect cell boundary crossings
+	std::unordered_map<entt::entity, CellId> _mobileCells;
+	/// Linked entities whose transform changed since the last update, in the order they were first marked. They may have
+	/// been destroyed since.
+	std::vector<entt::entity> _dirtyEntities;
+	/// Same entities as _dirtyEntities, entities moved every frame while the game is paused are only queued once
+	std::unordered_set<entt::entity> _queuedEntities;
 };
 
 } // namespace openblack::ecs
@@ -10,6 +10,7 @@
 #include "Registry.h"
 
 #include "Locator.h"
+#include "Map.h"
 #include "Systems/RenderingSystemInterface.h"
 
 namespace openblack::ecs
@@ -56,4 +57,16 @@ void Registry::SetDirty()
 		Locator::rendereringSystem::value().SetDirty();
 	}
 }
+
+void Registry::SetDirty(entt::entity entity)
+{
+	if (Locator::rendereringSystem::has_value())
+	{
+		Locator::rendereringSystem::value().SetDirty(entity);
+	}
+	if (Locator::entitiesMap::has_value())
+	{
+		Locator::entitiesMap::value().SetDirty(entity);
+	}
+}
 } // namespace openblack::ecs
@@ -9,6 +9,13 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
 #include <entt/entity/entity.hpp>
 #include <entt/entity/helper.hpp>
 #include <entt/entity/registry.hpp>
@@ -26,10 +33,28 @@ class DebugLines;
 class ShaderManager;
 } // namespace openblack::graphics
 
+namespace openblack::ecs::components
+{
+struct Footpath;
+struct Mesh;
+struct MorphWithTerrain;
+struct Stream;
+struct TempleInteriorPart;
+struct Transform;
+} // namespace openblack::ecs::components
+
 namespace openblack::ecs
 {
 class Registry
 {
+	/// Adding or removing one of these changes which instances and debug lines are drawn, the render context is rebuilt
+	template <typename Component>
+	static constexpr bool k_ChangesDrawnInstances =
+	    std::is_same_v<Component, components::Mesh> || std::is_same_v<Component, components::Transform> ||
+	    std::is_same_v<Component, components::MorphWithTerrain> ||
+	    std::is_same_v<Component, components::TempleInteriorPart> || std::is_same_v<Component, components::Footpath> ||
+	    std::is_same_v<Component, components::Stream>;
+
 public:
 	Registry();
 	decltype(auto) Create() { return _registry.create(); }
@@ -54,19 +79,40 @@ class Registry
 	template <typename Component, typename... Args>
 	decltype(auto) Assign(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
-		SetDirty();
+		if constexpr (k_ChangesDrawnInstances<Component>)
+		{
+			SetDirty();
+		}
 		return _registry.emplace<Component>(entity, std::forward<Args>(args)...);
 	}
 	template <typename Component, typename... Args>
 	decltype(auto) AssignOrReplace(entt::entity entity, [[maybe_unused]] Args&&... args)
 	{
-		SetDirty();
+		// Replacing the transform of a drawn entity keeps its instance, only its uniforms need an update
+		if constexpr (std::is_same_v<Component, components::Transform>)
+		{
+			if (_registry.all_of<Component>(entity))
+			{
+				SetDirty(entity);
+			}
+			else
+			{
+				SetDirty();
+			}
+		}
+		else if constexpr (k_ChangesDrawnInstances<Component>)
+		{
+			SetDirty();
+		}
 		return _registry.emplace_or_replace<Component>(entity, std::forward<Args>(args)...);
 	}
 	template <typename Component, typename... Other>
 	decltype(auto) Remove(entt::entity entity)
 	{
-		SetDirty();
+		if constexpr (k_ChangesDrawnInstances<Component> || (k_ChangesDrawnInstances<Other> || ...))
+		{
+			SetDirty();
+		}
 		return _registry.remove<Component, Other...>(entity);
 	}
 	template <typename After, typename Before, typename... Args>
@@ -77,9 +123,21 @@ class Registry
 		return Assign<After>(entity, std::forward<Args>(args)...);
 	}
 	virtual void SetDirty();
+	/// Only the transform of the entity changed, no need for a full rebuild of the render context or the map
+	virtual void SetDirty(entt::entity entity);
 	virtual RegistryContext& Context();
 	[[nodiscard]] virtual const RegistryContext& Context() const;
 	virtual void Reset();
+	/// Serialize all entities with their identifiers, their components and the context to a compact binary blob.
+	/// key identifies what the world was built from, for example the hash of the map script.
+	/// RigidBody and AudioEmitter own objects of other systems, they are not saved and have to be recreated by them.
+	[[nodiscard]] std::vector<uint8_t> SaveSnapshot(uint64_t key) const;
+	/// Replace the content of the registry with a snapshot. Components are inserted in bulk, construction signals are
+	/// emitted. Returns false, leaving the registry untouched, if data was not saved with the same key by this version of
+	/// the game and resets the registry if data is malformed.
+	bool LoadSnapshot(std::span<const uint8_t> data, uint64_t key);
+	/// Names of the components in use which are neither saved in snapshots nor listed as not saved, should be empty
+	[[nodiscard]] std::vector<std::string_view> GetUnlistedSnapshotComponents() const;
 	template <typename Component>
 	size_t Size()
 	{
@@ -152,6 +210,21 @@ class Registry
 		return _registry.view<Components...>().size();
 	}
 	[[nodiscard]] decltype(auto) Valid(entt::entity entity) const { return _registry.valid(entity); }
+	template <typename Component>
+	decltype(auto) OnConstruct()
+	{
+		return _registry.on_construct<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnUpdate()
+	{
+		return _registry.on_update<Component>();
+	}
+	template <typename Component>
+	decltype(auto) OnDestroy()
+	{
+		return _registry.on_destroy<Component>();
+	}
 	virtual ~Registry() = default;
 
 protected:
@@ -0,0 +1,699 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "Registry.h"
+
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <entt/core/type_info.hpp>
+#include <entt/entity/entity.hpp>
+#include <entt/entity/snapshot.hpp>
+#include <glm/vec3.hpp>
+
+#include "Components/Abode.h"
+#include "Components/AnimatedStatic.h"
+#include "Components/AudioEmitter.h"
+#include "Components/CameraBookmark.h"
+#include "Components/Creature.h"
+#include "Components/Feature.h"
+#include "Components/Field.h"
+#include "Components/Fixed.h"
+#include "Components/Footpath.h"
+#include "Components/Forest.h"
+#include "Components/Hand.h"
+#include "Components/LivingAction.h"
+#include "Components/Mesh.h"
+#include "Components/Mobile.h"
+#include "Components/MorphWithTerrain.h"
+#include "Components/Player.h"
+#include "Components/Pot.h"
+#include "Components/RigidBody.h"
+#include "Components/Sprite.h"
+#include "Components/StoragePit.h"
+#include "Components/Stream.h"
+#include "Components/Temple.h"
+#include "Components/Town.h"
+#include "Components/Transform.h"
+#include "Components/Tree.h"
+#include "Components/Velocity.h"
+#include "Components/Villager.h"
+#include "Components/WallHug.h"
+#include "Enums.h"
+
+using namespace openblack::ecs;
+using namespace openblack::ecs::components;
+
+namespace
+{
+
+struct SnapshotHeader
+{
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint64_t key;
+	/// Snapshots are only loaded back with the same components in the same order
+	uint64_t componentsHash;
+};
+
+constexpr std::array<char, 4> k_Magic = {'O', 'B', 'W', 'S'};
+constexpr uint32_t k_Version = 1;
+
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>);
+
+// Every component is listed here or in NotSnapshotted, those with enums or bools are in k_SavedByMember.
+// Transform comes first, MapProduction links Fixed and Mobile entities which have one when they are constructed
+using SnapshotComponents =
+    std::tuple<Transform, Abode, AnimatedStatic, BigForest, CameraBookmark, Creature, Feature, Field, Fixed, Footpath,
+               FootpathLink, Forest, Hand, LivingAction, Mesh, Mobile, MobileObject, MobileStatic, MorphWithTerrain,
+               MoveStateArrivedTag, MoveStateExitCircleTag, MoveStateFinalStepTag, MoveStateLinearTag, MoveStateOrbitTag,
+               MoveStateStepThroughTag, Player, Pot, Sprite, StoragePit, Stream, Temple, TempleInteriorPart, Town, Tree,
+               openblack::Tribe, Velocity, Villager, WallHug, WallHugObjectReference>;
+
+/// Components owning objects of the dynamics world or the audio backend, they are recreated by them
+using NotSnapshotted = std::tuple<RigidBody, AudioEmitter>;
+
+template <typename T, typename Components>
+constexpr bool k_IsListedIn = false;
+
+template <typename T, typename... Components>
+constexpr bool k_IsListedIn<T, std::tuple<Components...>> = (std::is_same_v<T, Components> || ...);
+
+template <typename... Components>
+constexpr bool AnySnapshotted([[maybe_unused]] std::type_identity<std::tuple<Components...>> components)
+{
+	return (k_IsListedIn<Components, SnapshotComponents> || ...);
+}
+
+static_assert(!AnySnapshotted(std::type_identity<NotSnapshotted>()), "A component is either saved or not");
+
+template <typename T>
+constexpr bool k_IsMoveStateTag = requires { requires std::is_same_v<T, MoveStateTagComponent<T::k_Value>>; };
+
+/// Not every value of the bytes of an enum or a bool is valid, components with them are saved one member at a time and
+/// their values are checked when loading
+template <typename T>
+constexpr bool k_SavedByMember =
+    std::is_same_v<T, AnimatedStatic> || std::is_same_v<T, Creature> || std::is_same_v<T, Feature> ||
+    std::is_same_v<T, Hand> || std::is_same_v<T, MobileObject> || std::is_same_v<T, MobileStatic> ||
+    std::is_same_v<T, Player> || std::is_same_v<T, Temple> || std::is_same_v<T, TempleInteriorPart> ||
+    std::is_same_v<T, Tree> || std::is_same_v<T, Villager> || k_IsMoveStateTag<T>;
+
+/// Everything else is loaded from its bytes as they are, entities are enums of which every value is valid
+template <typename T>
+constexpr bool k_ReadAsBytes = std::is_trivially_copyable_v<T> && (!std::is_enum_v<T> || std::is_same_v<T, entt::entity>) &&
+                               !std::is_same_v<T, bool> && !k_SavedByMember<T>;
+
+class OutputArchive
+{
+public:
+	explicit OutputArchive(std::vector<uint8_t>& data)
+	    : _data(data)
+	{
+	}
+
+	template <typename T>
+	    requires(std::is_trivially_copyable_v<T> && !k_SavedByMember<T>)
+	void operator()(const T& value)
+	{
+		Write(std::span<const T>(&value, 1));
+	}
+
+	template <typename T>
+	void operator()(const std::vector<T>& values)
+	{
+		(*this)(static_cast<uint32_t>(values.size()));
+		if constexpr (std::is_trivially_copyable_v<T> && !k_SavedByMember<T>)
+		{
+			Write(std::span(values));
+		}
+		else
+		{
+			for (const auto& value : values)
+			{
+				(*this)(value);
+			}
+		}
+	}
+
+	template <typename T>
+	void operator()(const std::set<T>& values)
+	{
+		(*this)(static_cast<uint32_t>(values.size()));
+		for (const auto& value : values)
+		{
+			(*this)(value);
+		}
+	}
+
+	template <typename Key, typename Value>
+	void operator()(const std::unordered_map<Key, Value>& values)
+	{
+		(*this)(static_cast<uint32_t>(values.size()));
+		for (const auto& [key, value] : values)
+		{
+			(*this)(key);
+			(*this)(value);
+		}
+	}
+
+	void operator()(const std::string& value)
+	{
+		(*this)(static_cast<uint32_t>(value.size()));
+		Write(std::span(value));
+	}
+
+	void operator()(const Stream::Node& node)
+	{
+		(*this)(node.position);
+		(*this)(node.edges);
+	}
+
+	void operator()(const Abode& abode)
+	{
+		(*this)(abode.type);
+		(*this)(abode.townId);
+		(*this)(abode.foodAmount);
+		(*this)(abode.woodAmount);
+		(*this)(abode.inhabitants);
+	}
+
+	void operator()(const AnimatedStatic& animatedStatic) { (*this)(animatedStatic.type); }
+
+	void operator()(const Creature& creature)
+	{
+		(*this)(creature.owner);
+		(*this)(creature.species);
+		(*this)(creature.mind);
+	}
+
+	void operator()(const Feature& feature) { (*this)(feature.type); }
+
+	void operator()(const Hand& hand)
+	{
+		(*this)(hand.rightHanded);
+		(*this)(hand.renderType);
+	}
+
+	void operator()(const MobileObject& mobileObject) { (*this)(mobileObject.type); }
+
+	void operator()(const MobileStatic& mobileStatic) { (*this)(mobileStatic.type); }
+
+	template <MoveState S>
+	void operator()(const MoveStateTagComponent<S>& tag)
+	{
+		(*this)(tag.clockwise);
+		(*this)(tag.stepGoal);
+	}
+
+	void operator()(const Player& player) { (*this)(player.name); }
+
+	void operator()(const Temple& temple) { (*this)(temple.owner); }
+
+	void operator()(const TempleInteriorPart& part) { (*this)(part.room); }
+
+	void operator()(const Tree& tree)
+	{
+		(*this)(tree.type);
+		(*this)(tree.maxSize);
+	}
+
+	void operator()(const Villager& villager)
+	{
+		(*this)(villager.health);
+		(*this)(villager.age);
+		(*this)(villager.hunger);
+		(*this)(villager.lifeStage);
+		(*this)(villager.sex);
+		(*this)(villager.tribe);
+		(*this)(villager.number);
+		(*this)(villager.task);
+		(*this)(villager.town);
+		(*this)(villager.abode);
+	}
+
+	void operator()(const Footpath& footpath) { (*this)(footpath.nodes); }
+
+	void operator()(const FootpathLink& link)
+	{
+		(*this)(link.position);
+		(*this)(link.footpaths);
+	}
+
+	void operator()(const Stream& stream)
+	{
+		(*this)(stream.id);
+		(*this)(stream.nodes);
+	}
+
+	void operator()(const Town& town)
+	{
+		(*this)(town.id);
+		(*this)(town.beliefs);
+		(*this)(town.uninhabitable);
+		(*this)(town.homelessVillagers);
+	}
+
+	void operator()(const RegistryContext& context)
+	{
+		(*this)(context.footpaths);
+		(*this)(context.streams);
+		(*this)(context.towns);
+	}
+
+	template <typename T>
+	void Write(std::span<const T> values)
+	{
+		const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+		_data.insert(_data.end(), bytes, bytes + values.size_bytes());
+	}
+
+private:
+	std::vector<uint8_t>& _data;
+};
+
+/// Reads what OutputArchive wrote, throws std::runtime_error when running out of data
+class InputArchive
+{
+public:
+	explicit InputArchive(std::span<const uint8_t> data)
+	    : _data(data)
+	{
+	}
+
+	[[nodiscard]] bool AtEnd() const { return _position == _data.size(); }
+
+	template <typename T>
+	    requires(k_ReadAsBytes<T>)
+	void operator()(T& value)
+	{
+		std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+	}
+
+	void operator()(bool& value)
+	{
+		const auto byte = Read<uint8_t>();
+		if (byte > 1)
+		{
+			throw std::runtime_error("Snapshot has an invalid bool");
+		}
+		value = byte != 0;
+	}
+
+	/// Enums are read from their underlying type and must be between first and last
+	template <typename Enum>
+	void ReadEnum(Enum& value, Enum first, Enum last)
+	{
+		const auto underlying = Read<std::underlying_type_t<Enum>>();
+		if (underlying < std::to_underlying(first) || underlying > std::to_underlying(last))
+		{
+			throw std::runtime_error("Snapshot has an enum out of its range");
+		}
+		value = static_cast<Enum>(underlying);
+	}
+
+	/// Enums with a _COUNT value are checked from first to the value before it
+	template <typename Enum>
+	void ReadEnum(Enum& value, Enum first)
+	{
+		ReadEnum(value, first, static_cast<Enum>(std::to_underlying(Enum::_COUNT) - 1));
+	}
+
+	template <typename T>
+	void operator()(std::vector<T>& values)
+	{
+		const auto count = ReadCount();
+		if constexpr (k_ReadAsBytes<T>)
+		{
+			values = ReadArray<T>(count);
+		}
+		else
+		{
+			values.clear();
+			values.reserve(count);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				values.push_back(Read<T>());
+			}
+		}
+	}
+
+	void operator()(std::vector<Stream::Node>& nodes)
+	{
+		const auto count = ReadCount();
+		nodes.clear();
+		nodes.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			auto& node = nodes.emplace_back(Read<glm::vec3>(), std::vector<Stream::Node> {});
+			(*this)(node.edges);
+		}
+	}
+
+	template <typename T>
+	void operator()(std::set<T>& values)
+	{
+		const auto count = ReadCount();
+		values.clear();
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			values.insert(values.end(), Read<T>());
+		}
+	}
+
+	template <typename Key, typename Value>
+	void operator()(std::unordered_map<Key, Value>& values)
+	{
+		const auto count = ReadCount();
+		values.clear();
+		values.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			auto key = Read<Key>();
+			values.emplace(std::move(key), Read<Value>());
+		}
+	}
+
+	void operator()(std::string& value)
+	{
+		const auto size = ReadCount();
+		value.assign(reinterpret_cast<const char*>(Take(size)), size);
+	}
+
+	void operator()(Abode& abode)
+	{
+		ReadEnum(abode.type, AbodeNumber::Invalid);
+		(*this)(abode.townId);
+		(*this)(abode.foodAmount);
+		(*this)(abode.woodAmount);
+		(*this)(abode.inhabitants);
+	}
+
+	void operator()(AnimatedStatic& animatedStatic) { ReadEnum(animatedStatic.type, AnimatedStaticInfo::None); }
+
+	void operator()(Creature& creature)
+	{
+		ReadEnum(creature.owner, PlayerNames::PLAYER_ONE);
+		ReadEnum(creature.species, CreatureType::Unknown);
+		(*this)(creature.mind);
+	}
+
+	void operator()(Feature& feature) { ReadEnum(feature.type, FeatureInfo::None); }
+
+	void operator()(Hand& hand)
+	{
+		(*this)(hand.rightHanded);
+		ReadEnum(hand.renderType, Hand::RenderType::Model, Hand::RenderType::Symbol);
+	}
+
+	void operator()(MobileObject& mobileObject) { ReadEnum(mobileObject.type, MobileObjectInfo::None); }
+
+	void operator()(MobileStatic& mobileStatic) { ReadEnum(mobileStatic.type, MobileStaticInfo::None); }
+
+	template <MoveState S>
+	void operator()(MoveStateTagComponent<S>& tag)
+	{
+		ReadEnum(tag.clockwise, MoveStateClockwise::Undefined, MoveStateClockwise::Clockwise);
+		(*this)(tag.stepGoal);
+	}
+
+	void operator()(Player& player) { ReadEnum(player.name, PlayerNames::PLAYER_ONE); }
+
+	void operator()(Temple& temple) { ReadEnum(temple.owner, PlayerNames::PLAYER_ONE); }
+
+	void operator()(TempleInteriorPart& part) { ReadEnum(part.room, TempleRoom::ChallengeRoom, TempleRoom::SaveGameRoom); }
+
+	void operator()(Tree& tree)
+	{
+		ReadEnum(tree.type, TreeInfo::Beech);
+		(*this)(tree.maxSize);
+	}
+
+	void operator()(openblack::Tribe& tribe) { ReadEnum(tribe, openblack::Tribe::NONE); }
+
+	void operator()(Villager& villager)
+	{
+		(*this)(villager.health);
+		(*this)(villager.age);
+		(*this)(villager.hunger);
+		ReadEnum(villager.lifeStage, Villager::LifeStage::Child);
+		ReadEnum(villager.sex, Villager::Sex::MALE);
+		ReadEnum(villager.tribe, openblack::Tribe::NONE);
+		ReadEnum(villager.number, VillagerNumber::Housewife);
+		ReadEnum(villager.task, Villager::Task::IDLE);
+		(*this)(villager.town);
+		(*this)(villager.abode);
+	}
+
+	void operator()(Footpath& footpath) { (*this)(footpath.nodes); }
+
+	void operator()(FootpathLink& link)
+	{
+		(*this)(link.position);
+		(*this)(link.footpaths);
+	}
+
+	void operator()(Stream& stream)
+	{
+		(*this)(stream.id);
+		(*this)(stream.nodes);
+	}
+
+	void operator()(Town& town)
+	{
+		(*this)(town.id);
+		(*this)(town.beliefs);
+		(*this)(town.uninhabitable);
+		(*this)(town.homelessVillagers);
+	}
+
+	void operator()(RegistryContext& context)
+	{
+		(*this)(context.footpaths);
+		(*this)(context.streams);
+		(*this)(context.towns);
+	}
+
+	/// Components without a default constructor are trivially copyable and built from their bytes
+	template <typename T>
+	T Read()
+	{
+		if constexpr (k_ReadAsBytes<T>)
+		{
+			std::array<uint8_t, sizeof(T)> bytes;
+			std::memcpy(bytes.data(), Take(sizeof(T)), sizeof(T));
+			return std::bit_cast<T>(bytes);
+		}
+		else
+		{
+			T value {};
+			(*this)(value);
+			return value;
+		}
+	}
+
+	template <typename T>
+	std::vector<T> ReadArray(uint32_t count)
+	{
+		static_assert(k_ReadAsBytes<T>);
+		if (count > (_data.size() - _position) / sizeof(T))
+		{
+			throw std::runtime_error("Snapshot array is larger than the data left");
+		}
+		std::vector<T> values(count);
+		std::memcpy(values.data(), Take(count * sizeof(T)), count * sizeof(T));
+		return values;
+	}
+
+	/// Size of a container, each element takes at least one byte
+	uint32_t ReadCount()
+	{
+		const auto count = Read<uint32_t>();
+		if (count > _data.size() - _position)
+		{
+			throw std::runtime_error("Snapshot container is larger than the data left");
+		}
+		return count;
+	}
+
+private:
+	const uint8_t* Take(size_t size)
+	{
+		if (size > _data.size() - _position)
+		{
+			throw std::runtime_error("Unexpected end of snapshot");
+		}
+		const auto* result = _data.data() + _position;
+		_position += size;
+		return result;
+	}
+
+	std::span<const uint8_t> _data;
+	size_t _position {0};
+};
+
+template <typename Component>
+void SaveStorage(const entt::registry& registry, OutputArchive& archive)
+{
+	const auto* storage = registry.storage<Component>();
+	if (storage == nullptr)
+	{
+		archive(uint32_t {0});
+		return;
+	}
+
+	// Entities in the order of the packed array, then their components in the same order
+	const auto entities = std::span<const entt::entity>(storage->data(), storage->size());
+	archive(static_cast<uint32_t>(entities.size()));
+	archive.Write(entities);
+	for (const auto entity : entities)
+	{
+		archive(storage->get(entity));
+	}
+}
+
+template <typename Component>
+void LoadStorage(entt::registry& registry, InputArchive& archive)
+{
+	const auto entities = archive.ReadArray<entt::entity>(archive.Read<uint32_t>());
+	if (!std::all_of(entities.cbegin(), entities.cend(), [&registry](auto entity) { return registry.valid(entity); }))
+	{
+		throw std::runtime_error("Snapshot has components of entities which it doesn't have");
+	}
+	// The storage can't hold two components of the same entity
+	auto sorted = entities;
+	std::ranges::sort(sorted);
+	if (std::ranges::adjacent_find(sorted) != sorted.cend())
+	{
+		throw std::runtime_error("Snapshot has two components of the same entity");
+	}
+
+	std::vector<Component> components;
+	components.reserve(entities.size());
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		components.push_back(archive.Read<Component>());
+	}
+	registry.storage<Component>().insert(entities.cbegin(), entities.cend(), components.cbegin());
+}
+
+template <typename... Components>
+uint64_t HashComponents([[maybe_unused]] std::type_identity<std::tuple<Components...>> components)
+{
+	constexpr uint64_t k_FnvOffsetBasis = 0xcbf29ce484222325;
+	constexpr uint64_t k_FnvPrime = 0x100000001b3;
+	auto hash = k_FnvOffsetBasis;
+	const auto combine = [&hash](uint64_t value) { hash = (hash ^ value) * k_FnvPrime; };
+	(combine(entt::type_hash<Components>::value()), ...);
+	(combine(sizeof(Components)), ...);
+	return hash;
+}
+
+template <typename... Components>
+bool ListsType(entt::id_type hash, [[maybe_unused]] std::type_identity<std::tuple<Components...>> components)
+{
+	return ((entt::type_hash<Components>::value() == hash) || ...);
+}
+
+template <typename... Components>
+void SaveComponents(const entt::registry& registry, OutputArchive& archive,
+                    [[maybe_unused]] std::type_identity<std::tuple<Components...>> components)
+{
+	(SaveStorage<Components>(registry, archive), ...);
+}
+
+template <typename... Components>
+void LoadComponents(entt::registry& registry, InputArchive& archive,
+                    [[maybe_unused]] std::type_identity<std::tuple<Components...>> components)
+{
+	(LoadStorage<Components>(registry, archive), ...);
+}
+
+} // namespace
+
+std::vector<uint8_t> Registry::SaveSnapshot(uint64_t key) const
+{
+	const SnapshotHeader header {
+	    .magic = k_Magic,
+	    .version = k_Version,
+	    .key = key,
+	    .componentsHash = HashComponents(std::type_identity<SnapshotComponents>()),
+	};
+
+	std::vector<uint8_t> data;
+	OutputArchive archive(data);
+	archive(header);
+	// Identifiers, versions and the free list of the entities, other systems keep entities they refer to
+	entt::snapshot {_registry}.get<entt::entity>(archive);
+	SaveComponents(_registry, archive, std::type_identity<SnapshotComponents>());
+	archive(Context());
+	return data;
+}
+
+bool Registry::LoadSnapshot(std::span<const uint8_t> data, uint64_t key)
+{
+	SnapshotHeader header;
+	if (data.size() < sizeof(header))
+	{
+		return false;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != k_Magic || header.version != k_Version || header.key != key ||
+	    header.componentsHash != HashComponents(std::type_identity<SnapshotComponents>()))
+	{
+		return false;
+	}
+
+	Reset();
+	try
+	{
+		InputArchive archive(data.subspan(sizeof(header)));
+		entt::snapshot_loader {_registry}.get<entt::entity>(archive);
+		LoadComponents(_registry, archive, std::type_identity<SnapshotComponents>());
+		archive(Context());
+		if (!archive.AtEnd())
+		{
+			throw std::runtime_error("Unexpected data after the end of the snapshot");
+		}
+	}
+	catch (const std::runtime_error&)
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+std::vector<std::string_view> Registry::GetUnlistedSnapshotComponents() const
+{
+	std::vector<std::string_view> names;
+	for (const auto [id, storage] : _registry.storage())
+	{
+		const auto hash = storage.type().hash();
+		if (!storage.empty() && !ListsType(hash, std::type_identity<SnapshotComponents>()) &&
+		    !ListsType(hash, std::type_identity<NotSnapshotted>()))
+		{
+			names.push_back(storage.type().name());
+		}
+	}
+	return names;
+}
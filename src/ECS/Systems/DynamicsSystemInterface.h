@@ -11,19 +11,18 @@
 
 #include <chrono>
 #include <optional>
+#include <span>
 #include <tuple>
 
-#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
+
+#include "ECS/Components/Transform.h"
 
 class btRigidBody;
 
 namespace openblack
 {
 class LandIslandInterface;
-namespace ecs::components
-{
-struct Transform;
-}
 
 enum class RigidBodyType
 {
@@ -38,10 +37,19 @@ struct RigidBodyDetails
 	const void* userData;
 };
 
+struct Ray
+{
+	glm::vec3 origin;
+	glm::vec3 direction;
+	float tMax;
+};
+
 } // namespace openblack
 
 namespace openblack::ecs::systems
 {
+using RayCastHit = std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>;
+
 class DynamicsSystemInterface
 {
 public:
@@ -53,6 +61,8 @@ class DynamicsSystemInterface
 	virtual void UpdatePhysicsTransforms() = 0;
 	[[nodiscard]] virtual std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const = 0;
+	/// Closest hit of each of rays into hits, which must be of the same size
+	virtual void RayCastClosestHits(std::span<const Ray> rays, std::span<RayCastHit> hits) const = 0;
 };
 
 } // namespace openblack::ecs::systems
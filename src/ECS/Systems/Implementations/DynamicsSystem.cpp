@@ -11,6 +11,12 @@
 
 #include "DynamicsSystem.h"
 
+#include <cassert>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -24,6 +30,7 @@
 
 #include "3D/LandBlock.h"
 #include "3D/LandIslandInterface.h"
+#include "Common/JobSystem.h"
 #include "ECS/Components/RigidBody.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/Registry.h"
@@ -102,7 +109,7 @@ void DynamicsSystem::RegisterIslandRigidBodies(LandIslandInterface& island)
 void DynamicsSystem::UpdatePhysicsTransforms()
 {
 	auto& registry = Locator::entitiesRegistry::value();
-	registry.Each<Transform, const RigidBody>([&registry](Transform& transform, const RigidBody& body) {
+	registry.Each<Transform, const RigidBody>([&registry](entt::entity entity, Transform& transform, const RigidBody& body) {
 		btTransform trans;
 		body.motionState->getWorldTransform(trans);
 
@@ -115,36 +122,108 @@ void DynamicsSystem::UpdatePhysicsTransforms()
 
 		transform.rotation = glm::mat3_cast(quaternion);
 
-		registry.SetDirty();
+		registry.SetDirty(entity);
 	});
 }
 
-std::optional<std::pair<Transform, RigidBodyDetails>>
-DynamicsSystem::RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+namespace
 {
-	auto from = btVector3(origin.x, origin.y, origin.z);
-	auto to = from + tMax * btVector3(direction.x, direction.y, direction.z);
-
-	btCollisionWorld::ClosestRayResultCallback callback(from, to);
-
-	_world->rayTest(from, to, callback);
+/// Ignores the land blocks, they are ray cast on the height field of the island instead
+struct EntityClosestRayResultCallback final: public btCollisionWorld::ClosestRayResultCallback
+{
+	using ClosestRayResultCallback::ClosestRayResultCallback;
 
-	if (!callback.hasHit())
+	[[nodiscard]] bool needsCollision(btBroadphaseProxy* proxy0) const override
 	{
-		return std::nullopt;
+		const auto* object = static_cast<const btCollisionObject*>(proxy0->m_clientObject);
+		return ClosestRayResultCallback::needsCollision(proxy0) &&
+		       object->getUserIndex() != static_cast<int>(RigidBodyType::Terrain);
 	}
+};
 
-	auto translation = glm::vec3(callback.m_hitPointWorld.x(), callback.m_hitPointWorld.y(), callback.m_hitPointWorld.z());
-	auto normal = glm::vec3(callback.m_hitNormalWorld.x(), callback.m_hitNormalWorld.y(), callback.m_hitNormalWorld.z());
+Transform TransformFromHit(const glm::vec3& translation, const glm::vec3& normal)
+{
 	const auto up = glm::vec3(0, 1, 0);
 	auto rotation = glm::mat4(1.f);
 	if (abs(normal) != abs(up))
 	{
 		rotation = glm::orientation(normal, up);
 	}
+	return Transform {translation, rotation, glm::vec3(1.0f)};
+}
+} // namespace
+
+std::optional<std::pair<Transform, RigidBodyDetails>>
+DynamicsSystem::RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const
+{
+	const auto ray = Ray {origin, direction, tMax};
+	RayCastHit hit;
+	RayCastClosestHits({&ray, 1}, {&hit, 1});
+	return hit;
+}
+
+void DynamicsSystem::RayCastClosestHits(std::span<const Ray> rays, std::span<RayCastHit> hits) const
+{
+	assert(rays.size() == hits.size());
+
+	std::array<std::optional<LandIslandInterface::RayHit>, k_InlineRays> inlineLandHits;
+	std::vector<std::optional<LandIslandInterface::RayHit>> heapLandHits;
+	if (rays.size() > inlineLandHits.size())
+	{
+		heapLandHits.resize(rays.size());
+	}
+	const auto landHits = heapLandHits.empty() ? std::span(inlineLandHits).first(rays.size()) : std::span(heapLandHits);
 
-	return std::make_optional(std::make_pair(
-	    Transform {translation, rotation, glm::vec3(1.0f)},
-	    RigidBodyDetails {static_cast<RigidBodyType>(callback.m_collisionObject->getUserIndex()),
-	                      callback.m_collisionObject->getUserIndex2(), callback.m_collisionObject->getUserPointer()}));
+	// The land is read only, cast on it from worker threads
+	const auto& island = Locator::terrainSystem::value();
+	const auto castOnLand = [&island, landHits, rays](size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i)
+		{
+			landHits[i] = island.RayCast(rays[i].origin, rays[i].direction, rays[i].tMax);
+		}
+	};
+	auto& jobs = Locator::jobSystem::value();
+	const auto raysPerTask = std::max(k_MinRaysPerTask, (rays.size() + jobs.GetThreadCount() - 1) / jobs.GetThreadCount());
+	jobs.ParallelForChunks(rays.size(), raysPerTask, castOnLand);
+
+	// Bullet isn't built thread safe, its broadphase shares a single stack between ray tests. Entities are tested on this
+	// thread, reusing the callback, and only up to the land.
+	EntityClosestRayResultCallback callback(btVector3(0, 0, 0), btVector3(0, 0, 0));
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& ray : rays)
+	{
+		const auto& landHit = landHits[i];
+		const auto from = btVector3(ray.origin.x, ray.origin.y, ray.origin.z);
+		const auto direction = btVector3(ray.direction.x, ray.direction.y, ray.direction.z);
+		const auto to = from + (landHit ? landHit->distance : ray.tMax) * direction;
+		callback.m_rayFromWorld = from;
+		callback.m_rayToWorld = to;
+		callback.m_closestHitFraction = 1.0f;
+		callback.m_collisionObject = nullptr;
+
+		_world->rayTest(from, to, callback);
+
+		if (callback.hasHit())
+		{
+			const auto translation =
+			    glm::vec3(callback.m_hitPointWorld.x(), callback.m_hitPointWorld.y(), callback.m_hitPointWorld.z());
+			const auto normal =
+			    glm::vec3(callback.m_hitNormalWorld.x(), callback.m_hitNormalWorld.y(), callback.m_hitNormalWorld.z());
+			hits[i] = std::make_pair(
+			    TransformFromHit(translation, normal),
+			    RigidBodyDetails {static_cast<RigidBodyType>(callback.m_collisionObject->getUserIndex()),
+			                      callback.m_collisionObject->getUserIndex2(), callback.m_collisionObject->getUserPointer()});
+		}
+		else if (landHit)
+		{
+			// Same details as the land block rigid bodies registered in RegisterIslandRigidBodies
+			hits[i] = std::make_pair(TransformFromHit(landHit->position, landHit->normal),
+			                         RigidBodyDetails {RigidBodyType::Terrain, landHit->blockIndex, this});
+		}
+		else
+		{
+			hits[i] = std::nullopt;
+		}
+		++i;
+	}
 }
@@ -49,8 +49,15 @@ class DynamicsSystem final: public DynamicsSystemInterface
 	void UpdatePhysicsTransforms() override;
 	[[nodiscard]] std::optional<std::pair<ecs::components::Transform, RigidBodyDetails>>
 	RayCastClosestHit(const glm::vec3& origin, const glm::vec3& direction, float tMax) const override;
+	void RayCastClosestHits(std::span<const Ray> rays, std::span<RayCastHit> hits) const override;
 
 private:
+	/// Fewest rays cast on the land by a worker at once, batches are otherwise split evenly over the threads. A ray marches
+	/// the height field over many cells, a few of them already cost more than handing them to a worker.
+	static constexpr size_t k_MinRaysPerTask = 4;
+	/// Batches up to this size, such as the rays of the camera, keep their land hits on the stack
+	static constexpr size_t k_InlineRays = 16;
+
 	/// collision configuration contains default setup for memory, collision setup
 	std::unique_ptr<btDefaultCollisionConfiguration> _configuration;
 	/// use the default collision dispatcher. For parallel processing you can use
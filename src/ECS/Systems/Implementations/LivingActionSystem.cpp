@@ -11,8 +11,14 @@
 
 #include "LivingActionSystem.h"
 
+#include <array>
+#include <atomic>
+#include <string_view>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
+#include "Common/JobSystem.h"
 #include "ECS/Components/LivingAction.h"
 #include "ECS/Components/Villager.h"
 #include "ECS/Registry.h"
@@ -23,7 +29,10 @@ using namespace openblack;
 using namespace openblack::ecs::components;
 using namespace openblack::ecs::systems;
 
-uint32_t VillagerInvalidState(LivingAction& action)
+namespace
+{
+
+uint32_t VillagerInvalidState(LivingAction& action, [[maybe_unused]] LivingAction::Index index)
 {
 	SPDLOG_LOGGER_ERROR(spdlog::get("ai"), "Villager #{}: Stuck in an invalid state",
 	                    static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)));
@@ -31,7 +40,7 @@ uint32_t VillagerInvalidState(LivingAction& action)
 	return 0;
 }
 
-uint32_t VillagerCreated(LivingAction& action)
+uint32_t VillagerCreated(LivingAction& action, [[maybe_unused]] LivingAction::Index index)
 {
 	if (action.turnsUntilStateChange > 0)
 	{
@@ -47,82 +56,81 @@ uint32_t VillagerCreated(LivingAction& action)
 
 struct VillagerStateTableEntry
 {
-	std::function<uint32_t(LivingAction&)> state = nullptr;
-	std::function<bool(LivingAction&, VillagerStates, VillagerStates)> entryState = nullptr;
-	std::function<bool(LivingAction&)> exitState = nullptr;
-	std::function<bool(LivingAction&)> saveState = nullptr;
-	std::function<bool(LivingAction&)> loadState = nullptr;
-	std::function<bool(LivingAction&)> field0x50 = nullptr;
-	std::function<bool(LivingAction&)> field0x60 = nullptr;
-	std::function<int(LivingAction&)> transitionAnimation = nullptr;
-	std::function<bool(LivingAction&)> validate = nullptr;
+	// Functions are given the index of the state they were called for
+	uint32_t (*state)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*entryState)(LivingAction&, LivingAction::Index, VillagerStates, VillagerStates) = nullptr;
+	bool (*exitState)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*saveState)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*loadState)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*field0x50)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*field0x60)(LivingAction&, LivingAction::Index) = nullptr;
+	int (*transitionAnimation)(LivingAction&, LivingAction::Index) = nullptr;
+	bool (*validate)(LivingAction&, LivingAction::Index) = nullptr;
 };
 
-static const VillagerStateTableEntry k_TodoEntry = {
-    .state = [](LivingAction& action) -> uint32_t {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented state function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return 0;
-    },
-    .entryState = [](LivingAction& action, VillagerStates src, VillagerStates dst) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented entry state function ({} -> {})",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(src)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(dst)));
-	    return false;
-    },
-    .exitState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented exit state function)",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)));
-	    return false;
-    },
-    .saveState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented save state function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return false;
-    },
-    .loadState = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented load state function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return false;
-    },
-    .field0x50 = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented field0x50 state function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return false;
-    },
-    .field0x60 = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented field0x60 state function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return false;
-    },
-    .transitionAnimation = [](LivingAction& action) -> int {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented transition animation function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return -1;
-    },
-    .validate = [](LivingAction& action) -> bool {
-	    SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented validate function: {}",
-	                       static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
-	                       k_VillagerStateStrings.at(static_cast<size_t>(
-	                           Locator::livingActionSystem::value().VillagerGetState(action, LivingAction::Index::Top))));
-	    return false;
-    },
+enum class StateFunction : uint8_t
+{
+	State,
+	EntryState,
+	ExitState,
+	SaveState,
+	LoadState,
+	Field0x50,
+	Field0x60,
+	TransitionAnimation,
+	Validate,
+
+	_COUNT
+};
+
+constexpr std::array<std::string_view, static_cast<size_t>(StateFunction::_COUNT)> k_StateFunctionNames = {
+    "state",                //
+    "entry state",          //
+    "exit state",           //
+    "save state",           //
+    "load state",           //
+    "field0x50",            //
+    "field0x60",            //
+    "transition animation", //
+    "validate",             //
 };
 
-const static std::array<VillagerStateTableEntry, static_cast<size_t>(VillagerStates::_COUNT)> k_VillagerStateTable = {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): calls to unimplemented functions, from all threads
+std::array<std::atomic<uint32_t>, static_cast<size_t>(StateFunction::_COUNT) * static_cast<size_t>(VillagerStates::_COUNT)>
+    g_UnimplementedCalls {};
+
+/// Calls to unimplemented functions happen for every villager every turn, only log when the count of a function of a state
+/// reaches a power of two. Counted and logged for the state at index, which isn't always the top state.
+template <StateFunction function, typename Result, Result k_Result, typename... Args>
+Result VillagerUnimplemented(LivingAction& action, LivingAction::Index index, [[maybe_unused]] Args... args)
+{
+	const auto state = action.states.at(static_cast<size_t>(index));
+	const auto counter = static_cast<size_t>(function) * static_cast<size_t>(VillagerStates::_COUNT) + state;
+	const auto count = g_UnimplementedCalls.at(counter).fetch_add(1, std::memory_order_relaxed) + 1;
+	if ((count & (count - 1)) == 0)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("ai"), "Villager #{}: TODO: Unimplemented {} function: {} {} (called {} times)",
+		                   static_cast<uint32_t>(Locator::entitiesRegistry::value().ToEntity(action)),
+		                   k_StateFunctionNames.at(static_cast<size_t>(function)),
+		                   LivingAction::k_IndexStrings.at(static_cast<size_t>(index)), k_VillagerStateStrings.at(state),
+		                   count);
+	}
+	return k_Result;
+}
+
+constexpr VillagerStateTableEntry k_TodoEntry = {
+    .state = &VillagerUnimplemented<StateFunction::State, uint32_t, 0>,
+    .entryState = &VillagerUnimplemented<StateFunction::EntryState, bool, false, VillagerStates, VillagerStates>,
+    .exitState = &VillagerUnimplemented<StateFunction::ExitState, bool, false>,
+    .saveState = &VillagerUnimplemented<StateFunction::SaveState, bool, false>,
+    .loadState = &VillagerUnimplemented<StateFunction::LoadState, bool, false>,
+    .field0x50 = &VillagerUnimplemented<StateFunction::Field0x50, bool, false>,
+    .field0x60 = &VillagerUnimplemented<StateFunction::Field0x60, bool, false>,
+    .transitionAnimation = &VillagerUnimplemented<StateFunction::TransitionAnimation, int, -1>,
+    .validate = &VillagerUnimplemented<StateFunction::Validate, bool, false>,
+};
+
+constexpr std::array<VillagerStateTableEntry, static_cast<size_t>(VillagerStates::_COUNT)> k_VillagerStateTable = {
     /* INVALID_STATE */ VillagerStateTableEntry {
         .state = &VillagerInvalidState,
     },
@@ -386,6 +394,35 @@ const static std::array<VillagerStateTableEntry, static_cast<size_t>(VillagerSta
     /* MOVE_SCAFFOLD_TO_BUILDING_SITE */ k_TodoEntry,
 };
 
+} // namespace
+
+LivingActionSystem::LivingActionSystem()
+{
+	for (auto& calls : g_UnimplementedCalls)
+	{
+		calls.store(0, std::memory_order_relaxed);
+	}
+}
+
+template <typename Func>
+void LivingActionSystem::ParallelEachVillager(Func func)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& jobs = Locator::jobSystem::value();
+
+	// Components are only added or removed once every villager is done, their addresses don't change in between
+	std::vector<LivingAction*> actions;
+	registry.Each<const Villager, LivingAction>(
+	    [&actions]([[maybe_unused]] const Villager& villager, LivingAction& action) { actions.push_back(&action); });
+
+	_commandBuffers.resize(jobs.GetThreadCount());
+	_deferChanges = true;
+	jobs.ParallelFor(actions.size(), [&func, &actions](size_t i) { func(*actions[i]); });
+	_deferChanges = false;
+
+	ecs::CommandBuffer::Apply(_commandBuffers, registry);
+}
+
 void LivingActionSystem::Update()
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -394,20 +431,14 @@ void LivingActionSystem::Update()
 
 	// TODO(#475): process food speedup
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Top);
-	});
+	ParallelEachVillager([this](LivingAction& action) { VillagerCallValidate(action, LivingAction::Index::Top); });
 	// TODO(#476): same call but for other types of living
 
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallValidate(action, LivingAction::Index::Final);
-	});
+	ParallelEachVillager([this](LivingAction& action) { VillagerCallValidate(action, LivingAction::Index::Final); });
 	// TODO(#476): same call but for other types of living
 
 	// TODO(bwrsandman): Store result of this call in vector or with tag component
-	registry.Each<const Villager, LivingAction>([this]([[maybe_unused]] const Villager& villager, LivingAction& action) {
-		VillagerCallState(action, LivingAction::Index::Top);
-	});
+	ParallelEachVillager([this](LivingAction& action) { VillagerCallState(action, LivingAction::Index::Top); });
 	// TODO(#476): same call but for other types of living
 }
 
@@ -419,6 +450,17 @@ VillagerStates LivingActionSystem::VillagerGetState(const LivingAction& action,
 void LivingActionSystem::VillagerSetState(LivingAction& action, LivingAction::Index index, VillagerStates state,
                                           bool skipTransition) const
 {
+	if (_deferChanges)
+	{
+		// Entering and exiting states may touch other entities
+		const auto entity = Locator::entitiesRegistry::value().ToEntity(action);
+		auto& commands = _commandBuffers.at(JobSystem::GetThreadIndex());
+		commands.Record(entity, [this, entity, index, state, skipTransition](ecs::Registry& registry) {
+			VillagerSetState(registry.Get<LivingAction>(entity), index, state, skipTransition);
+		});
+		return;
+	}
+
 	const auto previousState = static_cast<VillagerStates>(action.states.at(static_cast<size_t>(index)));
 	if (previousState != state)
 	{
@@ -428,19 +470,22 @@ void LivingActionSystem::VillagerSetState(LivingAction& action, LivingAction::In
 		                    k_VillagerStateStrings.at(static_cast<size_t>(previousState)),
 		                    k_VillagerStateStrings.at(static_cast<size_t>(state)));
 
-		if (index == LivingAction::Index::Top)
+		if (index != LivingAction::Index::Top)
 		{
-			action.turnsSinceStateChange = 0;
-			if (skipTransition)
-			{
-				return;
-			}
+			action.states.at(static_cast<size_t>(index)) = static_cast<uint8_t>(state);
+			return;
+		}
 
-			if (VillagerCallExitState(action, index))
-			{
-				return;
-			}
+		action.turnsSinceStateChange = 0;
+		// The previous state may refuse to be left
+		if (!skipTransition && VillagerCallExitState(action, index))
+		{
+			return;
+		}
 
+		action.states.at(static_cast<size_t>(index)) = static_cast<uint8_t>(state);
+		if (!skipTransition)
+		{
 			VillagerCallEntryState(action, index, previousState, state);
 		}
 	}
@@ -450,12 +495,12 @@ uint32_t LivingActionSystem::VillagerCallState(LivingAction& action, LivingActio
 {
 	const auto state = action.states.at(static_cast<size_t>(index));
 	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.state;
-	if (!callback)
+	const auto callback = entry.state;
+	if (callback == nullptr)
 	{
 		return 0;
 	}
-	return callback(action);
+	return callback(action, index);
 }
 
 bool LivingActionSystem::VillagerCallEntryState(LivingAction& action, LivingAction::Index index, VillagerStates src,
@@ -463,46 +508,46 @@ bool LivingActionSystem::VillagerCallEntryState(LivingAction& action, LivingActi
 {
 	const auto state = action.states.at(static_cast<size_t>(index));
 	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.entryState;
-	if (!callback)
+	const auto callback = entry.entryState;
+	if (callback == nullptr)
 	{
 		return false;
 	}
-	return callback(action, src, dst);
+	return callback(action, index, src, dst);
 }
 
 bool LivingActionSystem::VillagerCallExitState(LivingAction& action, LivingAction::Index index) const
 {
 	const auto& state = action.states.at(static_cast<size_t>(index));
 	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.exitState;
-	if (!callback)
+	const auto callback = entry.exitState;
+	if (callback == nullptr)
 	{
 		return false;
 	}
-	return callback(action);
+	return callback(action, index);
 }
 
 int LivingActionSystem::VillagerCallOutOfAnimation(LivingAction& action, LivingAction::Index index) const
 {
 	const auto state = action.states.at(static_cast<size_t>(index));
 	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.transitionAnimation;
-	if (!callback)
+	const auto callback = entry.transitionAnimation;
+	if (callback == nullptr)
 	{
 		return -1;
 	}
-	return callback(action);
+	return callback(action, index);
 }
 
 bool LivingActionSystem::VillagerCallValidate(LivingAction& action, LivingAction::Index index) const
 {
 	const auto state = action.states.at(static_cast<size_t>(index));
 	const auto& entry = k_VillagerStateTable.at(static_cast<size_t>(state));
-	const auto& callback = entry.validate;
-	if (!callback)
+	const auto callback = entry.validate;
+	if (callback == nullptr)
 	{
 		return false;
 	}
-	return callback(action);
+	return callback(action, index);
 }
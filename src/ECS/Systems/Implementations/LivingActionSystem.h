@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include "ECS/CommandBuffer.h"
 #include "ECS/Components/LivingAction.h"
 #include "ECS/Systems/LivingActionSystemInterface.h"
 
@@ -22,6 +25,9 @@ namespace openblack::ecs::systems
 class LivingActionSystem final: public LivingActionSystemInterface
 {
 public:
+	/// Counts of calls to unimplemented state functions start over, so the first calls of a new game are logged again
+	LivingActionSystem();
+
 	void Update() override;
 
 	[[nodiscard]] VillagerStates VillagerGetState(const components::LivingAction& action,
@@ -34,5 +40,15 @@ class LivingActionSystem final: public LivingActionSystemInterface
 	bool VillagerCallExitState(components::LivingAction& action, components::LivingAction::Index index) const override;
 	int VillagerCallOutOfAnimation(components::LivingAction& action, components::LivingAction::Index index) const override;
 	bool VillagerCallValidate(components::LivingAction& action, components::LivingAction::Index index) const override;
+
+private:
+	/// Call func on the action of every villager over all threads of the job system. Villagers may only change their own
+	/// action from func, other changes are recorded into the command buffer of the thread and applied once all are done.
+	template <typename Func>
+	void ParallelEachVillager(Func func);
+
+	/// One per thread of the job system, only used during ParallelEachVillager
+	mutable std::vector<CommandBuffer> _commandBuffers;
+	bool _deferChanges {false};
 };
 } // namespace openblack::ecs::systems
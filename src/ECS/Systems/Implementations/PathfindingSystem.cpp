@@ -122,10 +122,10 @@ bool LinearScanForObstacle(entt::entity entity, const glm::vec2& pos, const glm:
 		const auto& fixed = map.GetFixedInGridCell(c);
 		if (!fixed.empty())
 		{
-			auto iter = std::find_if(fixed.cbegin(), fixed.cend(), [&registry](const auto& f) {
+			auto iter = std::find_if(fixed.begin(), fixed.end(), [&registry](const auto& f) {
 				return !registry.AnyOf<Field>(f); // TODO(bwrsandman): && registry.AllOf<CollideData>();
 			});
-			if (iter != fixed.cend())
+			if (iter != fixed.end())
 			{
 				fixedEntity = std::make_optional(*iter);
 				break;
@@ -207,7 +207,7 @@ bool OrbitScanForObstacle(entt::entity entity, bool clockwise, Transform& transf
 			const auto& e = map.GetFixedInGridCell(c);
 			if (!e.empty())
 			{
-				auto iter = std::find_if(e.cbegin(), e.cend(), [&registry, &reference, &obstacleFixed](const auto& f) {
+				auto iter = std::find_if(e.begin(), e.end(), [&registry, &reference, &obstacleFixed](const auto& f) {
 					if (f == reference.entity)
 					{
 						return false;
@@ -222,7 +222,7 @@ bool OrbitScanForObstacle(entt::entity entity, bool clockwise, Transform& transf
 					const auto r2 = r * r;
 					return d2 < r2 && d2 > 0.0f;
 				});
-				if (iter != e.cend())
+				if (iter != e.end())
 				{
 					// https://stackoverflow.com/questions/3349125/circle-circle-intersection-points
 					// http://paulbourke.net/geometry/circlesphere/
@@ -598,4 +598,8 @@ void PathfindingSystem::Update()
 	    [&registry](entt::entity entity, const MoveStateExitCircleTag, const MoveStateOrbitTag) {
 		    registry.Remove<MoveStateOrbitTag>(entity);
 	    });
+
+	// Update the instance uniforms of everything that might have moved
+	registry.Each<const WallHug, const Transform>(
+	    [&registry](entt::entity entity, const WallHug&, const Transform&) { registry.SetDirty(entity); });
 }
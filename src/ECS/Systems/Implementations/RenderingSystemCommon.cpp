@@ -11,6 +11,11 @@
 
 #include "RenderingSystemCommon.h"
 
+#include <algorithm>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+
 #include <glm/gtx/transform.hpp>
 
 #include "3D/L3DMesh.h"
@@ -24,13 +29,22 @@
 #include "Graphics/GraphicsHandleBgfx.h"
 #include "Graphics/ShaderManager.h"
 #include "Locator.h"
+#include "Profiler.h"
 #include "Resources/ResourcesInterface.h"
 
 using namespace openblack::ecs::systems;
 using namespace openblack::ecs::components;
 
+namespace
+{
+/// Area larger than any island, the footprint framebuffer is redrawn entirely
+const openblack::AxisAlignedBoundingBox k_EverywhereArea {glm::vec3(std::numeric_limits<float>::lowest()),
+                                                          glm::vec3(std::numeric_limits<float>::max())};
+} // namespace
+
 RenderContext::RenderContext()
     : instanceUniformBuffer(BGFX_INVALID_HANDLE)
+    , footprintDirtyArea(k_EverywhereArea)
 {
 }
 RenderContext::~RenderContext()
@@ -50,6 +64,163 @@ void RenderingSystemCommon::SetDirty()
 	_renderContext.dirty = true;
 }
 
+void RenderingSystemCommon::SetDirty(entt::entity entity)
+{
+	_renderContext.dirtyEntities.push_back(entity);
+}
+
+void RenderingSystemCommon::SetFootprintsDirty()
+{
+	_renderContext.footprintDirtyArea = k_EverywhereArea;
+}
+
+std::optional<openblack::AxisAlignedBoundingBox> RenderingSystemCommon::TakeFootprintDirtyArea()
+{
+	return std::exchange(_renderContext.footprintDirtyArea, std::nullopt);
+}
+
+void RenderingSystemCommon::AddFootprintDirtyArea(const AxisAlignedBoundingBox& area)
+{
+	auto& dirtyArea = _renderContext.footprintDirtyArea;
+	if (dirtyArea.has_value())
+	{
+		dirtyArea->minima = glm::min(dirtyArea->minima, area.minima);
+		dirtyArea->maxima = glm::max(dirtyArea->maxima, area.maxima);
+	}
+	else
+	{
+		dirtyArea = area;
+	}
+}
+
+glm::mat4 RenderingSystemCommon::GetModelMatrix(const Transform& transform)
+{
+	auto modelMatrix = glm::mat4(transform.rotation);
+	modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
+	modelMatrix = glm::scale(modelMatrix, transform.scale);
+	return modelMatrix;
+}
+
+glm::mat4 RenderingSystemCommon::GetBoundingBoxMatrix(entt::id_type meshId, const glm::mat4& modelMatrix)
+{
+	auto l3dMesh = Locator::resources::value().GetMeshes().Handle(meshId);
+	auto box = l3dMesh->GetBoundingBox();
+	return modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
+}
+
+void RenderingSystemCommon::PrepareDrawUpdateUniforms(bool drawBoundingBox)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	auto& uniforms = _renderContext.instanceUniforms;
+	const auto boundingBoxOffset = static_cast<uint32_t>(uniforms.size() / 2);
+
+	std::vector<uint32_t> slots;
+	slots.reserve(_renderContext.dirtyEntities.size());
+	for (const auto entity : _renderContext.dirtyEntities)
+	{
+		const auto slot = _renderContext.instanceSlots.find(entity);
+		if (slot == _renderContext.instanceSlots.end() || !registry.Valid(entity))
+		{
+			continue;
+		}
+		const auto* transform = registry.TryGet<Transform>(entity);
+		if (transform == nullptr)
+		{
+			continue;
+		}
+		const auto modelMatrix = GetModelMatrix(*transform);
+		uniforms[slot->second] = modelMatrix;
+		if (drawBoundingBox)
+		{
+			uniforms[slot->second + boundingBoxOffset] = GetBoundingBoxMatrix(registry.Get<const Mesh>(entity).id, modelMatrix);
+		}
+		slots.push_back(slot->second);
+
+		// Both where the footprint was and where it now is need to be redrawn
+		const auto footprint = _renderContext.footprintBounds.find(entity);
+		if (footprint != _renderContext.footprintBounds.end())
+		{
+			const auto mesh = Locator::resources::value().GetMeshes().Handle(registry.Get<const Mesh>(entity).id);
+			AddFootprintDirtyArea(footprint->second);
+			footprint->second = mesh->GetFootprints()[0].bounds.Transform(modelMatrix);
+			AddFootprintDirtyArea(footprint->second);
+		}
+	}
+
+	// Upload contiguous runs of updated slots
+	std::sort(slots.begin(), slots.end());
+	slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+	// Copied, the slots may be rewritten by the next update while the render thread still reads them
+	auto upload = [this, &uniforms](uint32_t start, uint32_t count) {
+		bgfx::update(toBgfx(_renderContext.instanceUniformBuffer), start,
+		             bgfx::copy(&uniforms[start], static_cast<uint32_t>(count * sizeof(glm::mat4))));
+	};
+	for (size_t i = 0; i < slots.size();)
+	{
+		size_t j = i + 1;
+		while (j < slots.size() && slots[j] == slots[j - 1] + 1)
+		{
+			++j;
+		}
+		const auto count = static_cast<uint32_t>(j - i);
+		upload(slots[i], count);
+		if (drawBoundingBox)
+		{
+			upload(slots[i] + boundingBoxOffset, count);
+		}
+		i = j;
+	}
+}
+
+void RenderingSystemCommon::PrepareDrawFootprintBounds()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+
+	std::unordered_set<entt::id_type> footprintMeshIds;
+	for (const auto& [meshId, desc] : _renderContext.instancedDrawDescs)
+	{
+		const auto mesh = meshManager.Handle(meshId);
+		if (mesh->ContainsLandscapeFeature() && !mesh->GetFootprints().empty())
+		{
+			footprintMeshIds.insert(meshId);
+		}
+	}
+
+	// Only the footprints which were added, moved or removed by the rebuild need to be redrawn
+	std::unordered_map<entt::entity, AxisAlignedBoundingBox> footprintBounds;
+	for (const auto& [entity, slot] : _renderContext.instanceSlots)
+	{
+		const auto meshId = registry.Get<const Mesh>(entity).id;
+		if (!footprintMeshIds.contains(meshId))
+		{
+			continue;
+		}
+		const auto& footprint = meshManager.Handle(meshId)->GetFootprints()[0];
+		const auto bounds = footprint.bounds.Transform(_renderContext.instanceUniforms[slot]);
+		footprintBounds.emplace(entity, bounds);
+
+		const auto previous = _renderContext.footprintBounds.find(entity);
+		if (previous == _renderContext.footprintBounds.end())
+		{
+			AddFootprintDirtyArea(bounds);
+			continue;
+		}
+		if (previous->second.minima != bounds.minima || previous->second.maxima != bounds.maxima)
+		{
+			AddFootprintDirtyArea(previous->second);
+			AddFootprintDirtyArea(bounds);
+		}
+		_renderContext.footprintBounds.erase(previous);
+	}
+	// What remains are footprints of entities which were destroyed or lost their mesh
+	for (const auto& [entity, bounds] : _renderContext.footprintBounds)
+	{
+		AddFootprintDirtyArea(bounds);
+	}
+	_renderContext.footprintBounds = std::move(footprintBounds);
+}
+
 void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams)
 {
 	auto& registry = Locator::entitiesRegistry::value();
@@ -57,8 +228,11 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 	if (_renderContext.dirty || _renderContext.hasBoundingBoxes != drawBoundingBox ||
 	    (_renderContext.footpaths != nullptr) != drawFootpaths || (_renderContext.streams != nullptr) != drawStreams)
 	{
+		Locator::profiler::value().Count(Profiler::Counter::RenderContextRebuilds);
 		PrepareDrawDescs(drawBoundingBox);
 		PrepareDrawUploadUniforms(drawBoundingBox);
+		PrepareDrawFootprintBounds();
+		_renderContext.dirtyEntities.clear();
 
 		_renderContext.boundingBox.reset();
 		if (drawBoundingBox)
@@ -125,4 +299,11 @@ void RenderingSystemCommon::PrepareDraw(bool drawBoundingBox, bool drawFootpaths
 		_renderContext.dirty = false;
 		_renderContext.hasBoundingBoxes = drawBoundingBox;
 	}
+	else if (!_renderContext.dirtyEntities.empty())
+	{
+		Locator::profiler::value().Count(Profiler::Counter::RenderEntityUpdates,
+		                                 static_cast<uint32_t>(_renderContext.dirtyEntities.size()));
+		PrepareDrawUpdateUniforms(drawBoundingBox);
+		_renderContext.dirtyEntities.clear();
+	}
 }
@@ -21,6 +21,11 @@
 #error "Locator interface implementations should only be included in Locator.cpp, use interface instead."
 #endif
 
+namespace openblack::ecs::components
+{
+struct Transform;
+}
+
 namespace openblack::ecs::systems
 {
 
@@ -29,14 +34,23 @@ class RenderingSystemCommon: public RenderingSystemInterface
 public:
 	~RenderingSystemCommon();
 	void SetDirty() override;
+	void SetDirty(entt::entity entity) override;
+	void SetFootprintsDirty() override;
+	std::optional<AxisAlignedBoundingBox> TakeFootprintDirtyArea() override;
 	void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) override;
 	const RenderContext& GetContext() override { return _renderContext; }
 
 private:
 	virtual void PrepareDrawDescs(bool drawBoundingBox) = 0;
 	virtual void PrepareDrawUploadUniforms(bool drawBoundingBox) = 0;
+	void PrepareDrawUpdateUniforms(bool drawBoundingBox);
+	void PrepareDrawFootprintBounds();
+	void AddFootprintDirtyArea(const AxisAlignedBoundingBox& area);
 
 protected:
+	[[nodiscard]] static glm::mat4 GetModelMatrix(const components::Transform& transform);
+	[[nodiscard]] static glm::mat4 GetBoundingBoxMatrix(entt::id_type meshId, const glm::mat4& modelMatrix);
+
 	RenderContext _renderContext;
 };
 } // namespace openblack::ecs::systems
@@ -110,27 +110,24 @@ void RenderingSystemTemple::PrepareDrawUploadUniforms(bool drawBoundingBox)
 	std::map<entt::id_type, uint32_t> uniformOffsets;
 
 	// Set transforms for instanced draw at offsets
+	_renderContext.instanceSlots.clear();
 	registry.Each<const Mesh, const Transform, const TempleInteriorPart>(
-	    [this, &uniformOffsets, drawBoundingBox](const Mesh& mesh, const Transform& transform,
+	    [this, &uniformOffsets, drawBoundingBox](entt::entity entity, const Mesh& mesh, const Transform& transform,
 	                                             const TempleInteriorPart& templePart) {
-		    auto l3dMesh = entt::locator<resources::ResourcesInterface>::value().GetMeshes().Handle(mesh.id);
-
 		    if (_loadedRooms.contains(templePart.room))
 		    {
 			    auto offset = uniformOffsets.insert(std::make_pair(mesh.id, 0));
 			    auto desc = _renderContext.instancedDrawDescs.find(mesh.id);
 
-			    auto modelMatrix = glm::mat4(transform.rotation);
-			    modelMatrix = glm::translate(modelMatrix, transform.position * transform.rotation);
-			    modelMatrix = glm::scale(modelMatrix, transform.scale);
+			    const auto modelMatrix = GetModelMatrix(transform);
 
 			    const uint32_t idx = desc->second.offset + offset.first->second;
 			    _renderContext.instanceUniforms[idx] = modelMatrix;
+			    _renderContext.instanceSlots.insert_or_assign(entity, idx);
 			    if (drawBoundingBox)
 			    {
-				    auto box = l3dMesh->GetBoundingBox();
-				    auto boxMatrix = modelMatrix * glm::translate(box.Center()) * glm::scale(box.Size());
-				    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] = boxMatrix;
+				    _renderContext.instanceUniforms[idx + _renderContext.instanceUniforms.size() / 2] =
+				        GetBoundingBoxMatrix(mesh.id, modelMatrix);
 			    }
 			    offset.first->second++;
 		    }
@@ -10,10 +10,14 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include <entt/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "3D/AxisAlignedBoundingBox.h"
 #include "Graphics/GraphicsHandle.h"
 #include "Graphics/Mesh.h"
 
@@ -57,6 +61,17 @@ struct RenderContext
 	/// The values stored are a list of uniforms (model matrix) needed for both
 	/// the instances of entities and their bounding boxes.
 	graphics::DynamicVertexBufferHandle instanceUniformBuffer;
+	/// Index of the model matrix of each drawn entity in \ref instanceUniforms.
+	/// The slots are stable until the next full rebuild in \ref PrepareDraw.
+	std::unordered_map<entt::entity, uint32_t> instanceSlots;
+	/// Entities which had their transform changed without any structural change
+	/// since the last \ref PrepareDraw. Only their slots are rewritten and uploaded.
+	std::vector<entt::entity> dirtyEntities;
+	/// World space bounds of the footprint of each drawn entity with a landscape feature.
+	/// Compared on every \ref PrepareDraw to find out which area of the footprint framebuffer changed.
+	std::unordered_map<entt::entity, AxisAlignedBoundingBox> footprintBounds;
+	/// Area of the footprint framebuffer which is out of date, empty if nothing changed since it was last drawn.
+	std::optional<AxisAlignedBoundingBox> footprintDirtyArea;
 
 	bool dirty {true};
 	bool hasBoundingBoxes {false};
@@ -65,7 +80,14 @@ struct RenderContext
 class RenderingSystemInterface
 {
 public:
+	/// Flag a structural change (entity or component added or removed), all instances are rebuilt
 	virtual void SetDirty() = 0;
+	/// Flag a transform change of a single entity, only its instance uniforms are updated
+	virtual void SetDirty(entt::entity entity) = 0;
+	/// Flag the whole footprint framebuffer as out of date, for example when the island is replaced
+	virtual void SetFootprintsDirty() = 0;
+	/// Return the area of the footprint framebuffer which changed since the last call and mark it as up to date
+	[[nodiscard]] virtual std::optional<AxisAlignedBoundingBox> TakeFootprintDirtyArea() = 0;
 	virtual void PrepareDraw(bool drawBoundingBox, bool drawFootpaths, bool drawStreams) = 0;
 	virtual const RenderContext& GetContext() = 0;
 	inline ~RenderingSystemInterface() = default;
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <filesystem>
 #include <map>
 #include <string_view>
 
@@ -48,6 +49,10 @@ struct EngineConfig
 	bool drawBoundingBoxes {false};
 	bool drawFootpaths {false};
 	bool drawStreams {false};
+	bool frustumCulling {true};
+	/// Pack the skins of the meshes into texture arrays when they are loaded, if the renderer supports them. Only read when
+	/// the meshes are loaded at start-up.
+	bool packMeshSkins {false};
 
 	bool vsync {false};
 	bool running {false};
@@ -61,6 +66,19 @@ struct EngineConfig
 	float cameraNearClip {1.0f};
 	float cameraFarClip {static_cast<float>(0x10000)};
 
+	/// Projected size (bounding radius over half of the view height) under which models use a less detailed lod
+	float lod1ScreenSize {0.1f};
+	float lod2ScreenSize {0.03f};
+
+	/// Fraction of the full 1024x1024 resolution of the water reflection, only read when the ocean is created
+	float reflectionResolutionScale {1.0f};
+	/// The water reflection is redrawn at most once every this many frames
+	uint32_t reflectionUpdateInterval {1};
+	/// Models further than this from the camera are left out of the water reflection, 0 keeps all of them
+	float reflectionModelDistance {0.0f};
+	/// The last water reflection is reused while the camera origin and focus moved less than this, 0 always redraws
+	float reflectionReuseDistance {0.0f};
+
 	float guiScale {1.0f};
 
 	GraphicsBackend graphicsBackend {GraphicsBackend::Noop};
@@ -68,5 +86,9 @@ struct EngineConfig
 	windowing::DisplayMode displayMode {windowing::DisplayMode::Windowed};
 
 	uint32_t numFramesToSimulate {0};
+	/// Threads running jobs, including the main thread, 0 is one per hardware thread. Only read when the engine starts.
+	uint32_t threadCount {0};
+	/// Directory where parsed map scripts are saved and loaded back from when the same script is loaded, empty disables it
+	std::filesystem::path scriptCachePath;
 };
 } // namespace openblack
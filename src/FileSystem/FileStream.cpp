@@ -19,25 +19,25 @@ using namespace openblack::filesystem;
 
 FileStream::FileStream(const std::filesystem::path& path, Stream::Mode mode)
 {
-	std::wstring recognisedMode;
+	std::string recognisedMode;
 
 	switch (mode)
 	{
 	case Stream::Mode::Read:
-		recognisedMode = L"rb";
+		recognisedMode = "rb";
 		break;
 	case Stream::Mode::Write:
-		recognisedMode = L"wb";
+		recognisedMode = "wb";
 		break;
 	case Stream::Mode::Append:
-		recognisedMode = L"ab";
+		recognisedMode = "ab";
 		break;
 	}
 
 #ifdef _WIN32
-	_wfopen_s(&_file, path.wstring().c_str(), recognisedMode.c_str());
+	_wfopen_s(&_file, path.wstring().c_str(), std::wstring(recognisedMode.begin(), recognisedMode.end()).c_str());
 #else
-	_file = std::fopen(path.c_str(), "rb");
+	_file = std::fopen(path.c_str(), recognisedMode.c_str());
 #endif
 
 	if (_file == nullptr)
@@ -9,10 +9,21 @@
 
 #include "Game.h"
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <ANMFile.h>
+#include <L3DFile.h>
 #include <LHVM.h>
+#include <MappedPackFile.h>
 #include <SDL.h>
+#include <bgfx/bgfx.h>
+#include <entt/core/hashed_string.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/euler_angles.hpp>
@@ -32,10 +43,14 @@
 #include "CHLApi.h"
 #include "Camera/Camera.h"
 #include "Common/EventManager.h"
+#include "Common/JobSystem.h"
 #include "Common/StringUtils.h"
+#include "Common/TaskGraph.h"
 #include "Debug/DebugGuiInterface.h"
 #include "ECS/Archetypes/PlayerArchetype.h"
 #include "ECS/Components/CameraBookmark.h"
+#include "ECS/Components/Mobile.h"
+#include "ECS/Components/Transform.h"
 #include "ECS/Map.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/CameraBookmarkSystemInterface.h"
@@ -46,9 +61,12 @@
 #include "ECS/Systems/PlayerSystemInterface.h"
 #include "ECS/Systems/RenderingSystemInterface.h"
 #include "EngineConfig.h"
+#include "FileSystem/FileStream.h"
 #include "FileSystem/FileSystemInterface.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/RendererInterface.h"
+#include "Graphics/SkinArrayPacker.h"
+#include "Graphics/UploadBatch.h"
 #include "Input/GameActionMapInterface.h"
 #include "LHScriptX/Script.h"
 #include "Locator.h"
@@ -68,12 +86,111 @@ using namespace std::chrono_literals;
 
 const std::string k_WindowTitle = "openblack";
 
+namespace
+{
+/// Memory map the pack when it is a file on disk, otherwise read it whole
+pack::PackResult OpenPack(filesystem::FileSystemInterface& fileSystem, const std::filesystem::path& path,
+                          pack::MappedPackFile& pack)
+{
+	const auto result = pack.Open(fileSystem.FindPath(path));
+	if (result != pack::PackResult::ErrCantOpen)
+	{
+		return result;
+	}
+	return pack.Open(fileSystem.ReadAll(path));
+}
+
+/// Load the compiled script from the cache directory, otherwise compile it and save it there. Returns if it was loaded.
+std::pair<CompiledScript, bool> LoadOrCompileScript(Script& script, std::string_view source,
+                                                    const std::filesystem::path& cacheDirectory)
+{
+	if (cacheDirectory.empty())
+	{
+		return {script.Compile(source), false};
+	}
+
+	const auto sourceHash = CompiledScript::HashSource(source);
+	const auto cachePath = cacheDirectory / fmt::format("{:016x}.lhsx", sourceHash);
+	std::error_code error;
+	if (std::filesystem::exists(cachePath, error))
+	{
+		try
+		{
+			filesystem::FileStream stream(cachePath, filesystem::Stream::Mode::Read);
+			std::vector<uint8_t> data(stream.Size());
+			stream.Read(data.data(), data.size());
+			if (auto compiled = CompiledScript::Deserialize(data, sourceHash))
+			{
+				return {std::move(*compiled), true};
+			}
+			SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Compiled script {} is outdated", cachePath.generic_string());
+		}
+		catch (const std::runtime_error& err)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to read compiled script {}: {}", cachePath.generic_string(),
+			                   err.what());
+		}
+	}
+
+	auto compiled = script.Compile(source);
+	try
+	{
+		std::filesystem::create_directories(cacheDirectory);
+		filesystem::FileStream stream(cachePath, filesystem::Stream::Mode::Write);
+		const auto data = compiled.Serialize();
+		stream.Write(data.data(), data.size());
+	}
+	catch (const std::exception& err)
+	{
+		SPDLOG_LOGGER_WARN(spdlog::get("game"), "Failed to save compiled script {}: {}", cachePath.generic_string(),
+		                   err.what());
+	}
+	return {std::move(compiled), false};
+}
+
+/// Systems which don't touch the same components or resources run in parallel. For now this is only scaffolding: every
+/// system after MapUpdate adds and removes components or calls into everything, so they are declared as touching
+/// everything and the turn runs in order. Narrowing one of them down has to keep the map and the renderer resources if
+/// it moves entities, as Registry::SetDirty(entity) queues them in both: "map" as for MapUpdate and "renderer".
+TaskGraph BuildTurnSystems()
+{
+	using namespace ecs::components;
+
+	TaskGraph turn;
+	// Relink moved entities in Map Grid Acceleration Structure
+	turn.Add("MapUpdate", TaskGraph::ComponentIds<Mobile, Transform>(), {entt::hashed_string("map")}, []() {
+		auto mapUpdate = Locator::profiler::value().BeginScoped(Profiler::Stage::MapUpdate);
+		Locator::entitiesMap::value().Update();
+	});
+	turn.Add("Pathfinding", {}, {TaskGraph::k_AllResources}, []() {
+		auto pathfinding = Locator::profiler::value().BeginScoped(Profiler::Stage::PathfindingUpdate);
+		Locator::pathfindingSystem::value().Update();
+	});
+	turn.Add(
+	    "LivingAction", {}, {TaskGraph::k_AllResources},
+	    []() {
+		    auto actions = Locator::profiler::value().BeginScoped(Profiler::Stage::LivingActionUpdate);
+		    Locator::livingActionSystem::value().Update();
+	    },
+	    TaskGraph::Affinity::CallingThread);
+	turn.Add(
+	    "LHVM", {}, {TaskGraph::k_AllResources},
+	    []() {
+		    auto& lhvm = Locator::vm::value();
+		    lhvm.LookIn(lhvm::ScriptType::All);
+	    },
+	    TaskGraph::Affinity::CallingThread);
+	return turn;
+}
+} // namespace
+
 Game* Game::sInstance = nullptr;
 
 Game::Game(Arguments&& args) noexcept
     : _gamePath(args.gamePath)
     , _startMap(args.startLevel)
     , _requestScreenshot(args.requestScreenshot)
+    , _turnSystems(BuildTurnSystems())
 {
 	Locator::camera::emplace(glm::zero<glm::vec3>());
 	std::function<std::shared_ptr<spdlog::logger>(const std::string&)> createLogger;
@@ -112,6 +229,9 @@ Game::Game(Arguments&& args) noexcept
 	config.graphicsBackend = args.graphicsBackend;
 	config.vsync = args.vsync;
 	config.guiScale = args.guiScale;
+	config.threadCount = args.threadCount;
+	config.scriptCachePath = args.scriptCachePath;
+	config.packMeshSkins = args.packMeshSkins;
 }
 
 Game::~Game() noexcept
@@ -253,22 +373,7 @@ bool Game::GameLogicLoop() noexcept
 		return false;
 	}
 
-	// Build Map Grid Acceleration Structure
-	Locator::entitiesMap::value().Rebuild();
-
-	auto& profiler = Locator::profiler::value();
-
-	{
-		auto pathfinding = profiler.BeginScoped(Profiler::Stage::PathfindingUpdate);
-		Locator::pathfindingSystem::value().Update();
-	}
-	{
-		auto actions = profiler.BeginScoped(Profiler::Stage::LivingActionUpdate);
-		Locator::livingActionSystem::value().Update();
-	}
-
-	auto& lhvm = Locator::vm::value();
-	lhvm.LookIn(lhvm::ScriptType::All);
+	_turnSystems.Run(Locator::jobSystem::value());
 
 	_lastGameLoopTime = currentTime;
 	_turnDeltaTime = delta;
@@ -402,7 +507,7 @@ bool Game::Update() noexcept
 				handTransform.rotation = glm::eulerAngleY(camera.GetRotation().y) * modelRotationCorrection;
 				handTransform.rotation = intersectionTransform.rotation * handTransform.rotation;
 				handTransform.position += intersectionTransform.rotation * handOffset;
-				Locator::entitiesRegistry::value().SetDirty();
+				Locator::entitiesRegistry::value().SetDirty(handEntity);
 			}
 		}
 
@@ -440,6 +545,16 @@ bool Game::Initialize() noexcept
 		openblack::InitializeWindow(k_WindowTitle, config.resolution.x, config.resolution.y, config.displayMode, extraFlags);
 	}
 
+	// Startup time breakdown, logged once everything is loaded
+	std::vector<std::pair<std::string_view, std::chrono::duration<float, std::milli>>> startupTimes;
+	auto startupLap = std::chrono::steady_clock::now();
+	const auto startupStart = startupLap;
+	auto lap = [&startupTimes, &startupLap](std::string_view name) {
+		const auto now = std::chrono::steady_clock::now();
+		startupTimes.emplace_back(name, now - startupLap);
+		startupLap = now;
+	};
+
 	using filesystem::Path;
 	if (!InitializeEngine(config.graphicsBackend, config.vsync))
 	{
@@ -500,6 +615,8 @@ bool Game::Initialize() noexcept
 		return false;
 	}
 
+	lap("Engine and game services");
+
 	auto& resources = Locator::resources::value();
 	auto& meshManager = resources.GetMeshes();
 	auto& textureManager = resources.GetTextures();
@@ -508,6 +625,18 @@ bool Game::Initialize() noexcept
 	auto& soundManager = resources.GetSounds();
 	auto& glowManager = resources.GetGlows();
 
+	// Meshes and their textures are flushed to the renderer in a few large batches instead of a frame per resource
+	const auto startupFlushCount = graphics::UploadBatch::GetFlushCount();
+	std::optional<graphics::UploadBatch> uploadBatch;
+	uploadBatch.emplace();
+	// Primitives with skins packed in the same texture array are drawn without changing samplers
+	std::optional<graphics::SkinArrayPacker> skinPacker;
+	if (const auto* caps = bgfx::getCaps(); config.packMeshSkins && (caps->supported & BGFX_CAPS_TEXTURE_2D_ARRAY) != 0)
+	{
+		skinPacker.emplace(static_cast<uint16_t>(
+		    std::min<uint32_t>(caps->limits.maxTextureLayers, graphics::SkinArrayPacker::k_MaxLayersPerArray)));
+	}
+
 	fileSystem.Iterate(
 	    fileSystem.GetPath<Path::Citadel>() / "OutsideMeshes", false, [&meshManager](const std::filesystem::path& f) {
 		    if (f.extension() == ".zzz")
@@ -562,29 +691,76 @@ bool Game::Initialize() noexcept
 		    }
 	    });
 
-	pack::PackFile pack;
+	lap("Temple meshes");
 
-	auto packResult = pack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d"));
+	// Meshes and textures are used in place from the mapped file until they are uploaded
+	pack::MappedPackFile pack;
+	auto packResult = OpenPack(fileSystem, fileSystem.GetPath<Path::Data>() / "AllMeshes.g3d", pack);
+	if (packResult == pack::PackResult::Success)
+	{
+		packResult = pack.ResolveMeshes();
+	}
+	if (packResult == pack::PackResult::Success)
+	{
+		packResult = pack.ResolveTextures();
+	}
 	if (packResult != pack::PackResult::Success)
 	{
 		SPDLOG_LOGGER_CRITICAL(spdlog::get("game"), "Unable to load AllMeshes.g3d: {}", pack::ResultToStr(packResult));
 		return false;
 	}
 
+	lap("Read AllMeshes.g3d");
+
+	// Meshes are parsed and converted on worker threads, their GPU resources have to be created on this thread
+	struct PreparedMesh
+	{
+		l3d::L3DFile file;
+		l3d::L3DResult result {l3d::L3DResult::Success};
+		std::shared_ptr<graphics::L3DMesh> mesh;
+		bool prepared {false};
+	};
 	const auto& meshes = pack.GetMeshes();
+	std::vector<PreparedMesh> preparedMeshes(meshes.size());
+	auto& jobSystem = Locator::jobSystem::value();
+	jobSystem.ParallelFor(meshes.size(), [&meshes, &preparedMeshes](size_t i) {
+		auto& prepared = preparedMeshes[i];
+		prepared.result = prepared.file.Open(meshes[i]);
+		if (prepared.result == l3d::L3DResult::Success)
+		{
+			prepared.mesh = std::make_shared<graphics::L3DMesh>(k_MeshNames.at(i));
+			prepared.prepared = prepared.mesh->Prepare(prepared.file);
+		}
+	});
+	lap("Parse packed meshes");
+
 	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; const auto& mesh : meshes)
+	for (size_t i = 0; const auto& prepared : preparedMeshes)
 	{
+		if (prepared.result != l3d::L3DResult::Success)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d mesh {}: {}", k_MeshNames.at(i),
+			                    l3d::ResultToStr(prepared.result));
+			++i;
+			continue;
+		}
+		if (!prepared.prepared)
+		{
+			SPDLOG_LOGGER_WARN(spdlog::get("game"), "Some issues were seen while loading l3d mesh {}.", k_MeshNames.at(i));
+		}
 		const auto meshId = static_cast<MeshId>(i);
-		meshManager.Load(meshId, resources::L3DLoader::FromBufferTag {}, k_MeshNames.at(i), mesh);
+		meshManager.Load(meshId, resources::L3DLoader::FromPreparedTag {}, prepared.mesh, prepared.file);
 		++i;
 	}
+	preparedMeshes.clear();
+	lap("Upload packed meshes");
 
 	const auto& textures = pack.GetTextures();
 	for (auto const& [name, g3dTexture] : textures)
 	{
 		textureManager.Load(g3dTexture.header.id, resources::Texture2DLoader::FromPackTag {}, name, g3dTexture);
 	}
+	lap("Packed textures");
 
 	pack::PackFile animationPack;
 	packResult = animationPack.ReadFile(*fileSystem.GetData(fileSystem.GetPath<Path::Data>() / "AllAnims.anm"));
@@ -595,11 +771,24 @@ bool Game::Initialize() noexcept
 	}
 
 	const auto& animations = animationPack.GetAnimations();
+	std::vector<anm::ANMFile> anmFiles(animations.size());
+	std::vector<anm::ANMResult> anmResults(animations.size(), anm::ANMResult::Success);
+	jobSystem.ParallelFor(animations.size(),
+	                      [&animations, &anmFiles, &anmResults](size_t i) { anmResults[i] = anmFiles[i].Open(animations[i]); });
+	lap("Parse packed animations");
+
 	// TODO (#749) use std::views::enumerate
-	for (size_t i = 0; i < animations.size(); i++)
+	for (size_t i = 0; i < anmFiles.size(); i++)
 	{
-		animationManager.Load(i, resources::L3DAnimLoader::FromBufferTag {}, animations[i]);
+		if (anmResults[i] != anm::ANMResult::Success)
+		{
+			SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed to open l3d animation {}: {}", i, anm::ResultToStr(anmResults[i]));
+			continue;
+		}
+		animationManager.Load(i, resources::L3DAnimLoader::FromParsedTag {}, anmFiles[i]);
 	}
+	anmFiles.clear();
+	lap("Load packed animations");
 
 	fileSystem.Iterate(fileSystem.GetPath<Path::CreatureMesh>(), false, [&meshManager](const std::filesystem::path& f) {
 		const auto& fileName = f.stem().string();
@@ -634,6 +823,15 @@ bool Game::Initialize() noexcept
 		meshManager.Load("river2", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "river2.l3d");
 		meshManager.Load("metre_sphere", LFromDiskTag {}, fileSystem.GetPath<Path::Data>() / "metre_sphere.l3d");
 	}
+	if (skinPacker.has_value())
+	{
+		SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Packed {} mesh skins into texture arrays", skinPacker->GetSkinCount());
+		skinPacker.reset();
+	}
+	uploadBatch.reset();
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Meshes uploaded in {} frames",
+	                    graphics::UploadBatch::GetFlushCount() - startupFlushCount);
+	lap("Creature and loose meshes");
 
 	// TODO(raffclar): #400: Parse level files within the resource loader
 	// TODO(raffclar): #405: Determine campaign levels from the challenge script file
@@ -687,6 +885,8 @@ bool Game::Initialize() noexcept
 		}
 	});
 
+	lap("Levels");
+
 	// Load all sound packs in the Audio directory
 	auto& audioManager = Locator::audio::value();
 	fileSystem.Iterate(
@@ -696,17 +896,22 @@ bool Game::Initialize() noexcept
 			    return;
 		    }
 
-		    pack::PackFile soundPack;
+		    // Shared by the sounds which point into it
+		    auto soundPack = std::make_shared<pack::MappedPackFile>();
 		    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Opening sound pack {}", f.filename().string());
-		    const auto result = soundPack.ReadFile(*fileSystem.GetData(f));
+		    auto result = OpenPack(fileSystem, f, *soundPack);
+		    if (result == pack::PackResult::Success)
+		    {
+			    result = soundPack->ResolveAudioSamples();
+		    }
 		    if (result != pack::PackResult::Success)
 		    {
 			    SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Unable to load sound pack {}: {}", f.filename().string(),
 			                        pack::ResultToStr(result));
 			    return;
 		    }
-		    const auto& audioHeaders = soundPack.GetAudioSampleHeaders();
-		    const auto& audioData = soundPack.GetAudioSamplesData();
+		    const auto& audioHeaders = soundPack->GetAudioSampleHeaders();
+		    const auto& audioData = soundPack->GetAudioSamplesData();
 		    auto soundName = std::filesystem::path(audioHeaders[0].name.data());
 
 		    if (audioHeaders.empty())
@@ -739,14 +944,15 @@ bool Game::Initialize() noexcept
 
 				    const auto stringId = fmt::format("{}/{}", groupName, audioHeaders[i].id);
 				    const entt::id_type id = entt::hashed_string(stringId.c_str());
-				    const std::vector<std::vector<uint8_t>> buffer = {audioData[i]};
 				    SPDLOG_LOGGER_DEBUG(spdlog::get("audio"), "Loading sound {}: {}", stringId, audioHeaders[i].name.data());
-				    soundManager.Load(id, resources::SoundLoader::FromBufferTag {}, audioHeaders[i], buffer);
+				    soundManager.Load(id, resources::SoundLoader::FromPackTag {}, soundPack, i);
 				    audioManager.AddToSoundGroup(groupName, id);
 			    }
 		    }
 	    });
 
+	lap("Sounds");
+
 	{
 		InfoFile infoFile;
 		auto result = infoFile.LoadFromFile(Locator::filesystem::value().GetPath<filesystem::Path::Scripts>() / "info.dat");
@@ -772,6 +978,14 @@ bool Game::Initialize() noexcept
 			}
 		}
 	});
+	lap("Info and raw textures");
+
+	const std::chrono::duration<float, std::milli> startupTotal = std::chrono::steady_clock::now() - startupStart;
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Initialized in {:.1f}ms:", startupTotal.count());
+	for (const auto& [name, duration] : startupTimes)
+	{
+		SPDLOG_LOGGER_INFO(spdlog::get("game"), "    {}: {:.1f}ms", name, duration.count());
+	}
 
 	return true;
 }
@@ -864,6 +1078,8 @@ bool Game::Run() noexcept
 			    .drawEntities = config.drawEntities,
 			    .drawSprites = config.drawSprites,
 			    .drawBoundingBoxes = config.drawBoundingBoxes,
+			    .frustumCulling = config.frustumCulling,
+			    .maxModelDistance = 0.0f,
 			    .cullBack = false,
 			    .wireframe = config.wireframe,
 			};
@@ -916,7 +1132,7 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 	}
 
 	const auto data = fileSystem.ReadAll(path);
-	const auto source = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+	const auto source = std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
 
 	// Reset everything. Deletes all entities and their components
 	Locator::entitiesRegistry::value().Reset();
@@ -931,7 +1147,16 @@ bool Game::LoadMap(const std::filesystem::path& path) noexcept
 	                                                        config.cameraFarClip);
 
 	Script script;
-	script.Load(source);
+	const auto compileStart = std::chrono::steady_clock::now();
+	const auto [compiled, cached] = LoadOrCompileScript(script, source, config.scriptCachePath);
+	const auto runStart = std::chrono::steady_clock::now();
+	script.Run(compiled);
+	const auto runEnd = std::chrono::steady_clock::now();
+
+	using Milliseconds = std::chrono::duration<float, std::milli>;
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Map script {}: {} {} commands in {:.3f}ms, ran them in {:.3f}ms",
+	                   path.generic_string(), cached ? "loaded" : "parsed", compiled.GetCommands().size(),
+	                   Milliseconds(runStart - compileStart).count(), Milliseconds(runEnd - runStart).count());
 
 	// Each released map comes with an optional .fot file which contains the footpath information for the map
 	const auto stem = string_utils::LowerCase(path.stem().generic_string());
@@ -18,6 +18,7 @@
 #include <glm/mat4x4.hpp>
 #include <spdlog/common.h>
 
+#include "Common/TaskGraph.h"
 #include "EngineConfig.h"
 #include "Windowing/WindowingInterface.h" // For DisplayMode
 
@@ -64,6 +65,9 @@ struct Arguments
 	std::array<spdlog::level::level_enum, k_LoggingSubsystemStrs.size()> logLevels;
 	std::string startLevel;
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> requestScreenshot;
+	uint32_t threadCount;
+	std::filesystem::path scriptCachePath;
+	bool packMeshSkins;
 };
 
 class Game
@@ -116,5 +120,7 @@ class Game
 	glm::ivec2 _mousePosition;
 	bool _handGripping;
 	std::optional<std::pair</* frame number */ uint32_t, /* output */ std::filesystem::path>> _requestScreenshot;
+	/// Built once, run every turn
+	TaskGraph _turnSystems;
 };
 } // namespace openblack
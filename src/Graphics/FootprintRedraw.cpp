@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "FootprintRedraw.h"
+
+#include <glm/common.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/vec4.hpp>
+
+using namespace openblack::graphics;
+
+std::optional<FootprintRedraw> openblack::graphics::GetFootprintRedraw(const AxisAlignedBoundingBox& dirtyArea,
+                                                                       const glm::mat4& view, const glm::mat4& proj,
+                                                                       glm::u16vec2 frameBufferSize, glm::u16vec2 tileCount)
+{
+	const auto size = glm::vec2(frameBufferSize);
+	const auto tileSize = size / glm::vec2(tileCount);
+	const auto viewProj = proj * view;
+	const auto toPixels = [&viewProj, &size](const glm::vec3& position) {
+		const auto clip = viewProj * glm::vec4(position.x, 0.0f, position.z, 1.0f);
+		return glm::clamp(glm::vec2(clip.x * 0.5f + 0.5f, 0.5f - clip.y * 0.5f) * size, glm::vec2(0.0f), size);
+	};
+	const auto corner0 = toPixels(dirtyArea.minima);
+	const auto corner1 = toPixels(dirtyArea.maxima);
+	const auto tileMin = glm::floor(glm::min(corner0, corner1) / tileSize);
+	const auto tileMax = glm::ceil(glm::max(corner0, corner1) / tileSize);
+	if (tileMax.x <= tileMin.x || tileMax.y <= tileMin.y)
+	{
+		return std::nullopt;
+	}
+	const auto rectMin = glm::u16vec2(glm::min(tileMin * tileSize, size));
+	const auto rectMax = glm::u16vec2(glm::min(tileMax * tileSize, size));
+
+	// Scale and move the normalized device coordinates of the rect to fill the view
+	const auto ndcMin = glm::vec2(rectMin.x / size.x * 2.0f - 1.0f, 1.0f - rectMax.y / size.y * 2.0f);
+	const auto ndcMax = glm::vec2(rectMax.x / size.x * 2.0f - 1.0f, 1.0f - rectMin.y / size.y * 2.0f);
+	const auto scale = 2.0f / (ndcMax - ndcMin);
+	const auto offset = -(ndcMin + ndcMax) * 0.5f * scale;
+	const auto crop = glm::translate(glm::vec3(offset, 0.0f)) * glm::scale(glm::vec3(scale, 1.0f));
+
+	return FootprintRedraw {
+	    .rectPosition = rectMin,
+	    .rectSize = rectMax - rectMin,
+	    .proj = crop * proj,
+	    .tileCount = static_cast<uint32_t>((tileMax.x - tileMin.x) * (tileMax.y - tileMin.y)),
+	};
+}
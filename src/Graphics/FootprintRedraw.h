@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <optional>
+
+#include <glm/ext/vector_uint2_sized.hpp>
+#include <glm/mat4x4.hpp>
+
+#include "3D/AxisAlignedBoundingBox.h"
+
+namespace openblack::graphics
+{
+
+/// Part of the footprint framebuffer to redraw after footprints were added, moved or removed
+struct FootprintRedraw
+{
+	/// Top left corner and size in pixels of the land block tiles covered by the change. It is used as the view rect,
+	/// which also limits the view clear, so the rest of the framebuffer keeps its content
+	glm::u16vec2 rectPosition;
+	glm::u16vec2 rectSize;
+	/// Projects the island onto the rect at the same pixels as the island projection does onto the whole framebuffer
+	glm::mat4 proj;
+	uint32_t tileCount;
+};
+
+/// Find the land block tiles covered by the dirty area, returns nothing if the area is outside of the island
+[[nodiscard]] std::optional<FootprintRedraw> GetFootprintRedraw(const AxisAlignedBoundingBox& dirtyArea, const glm::mat4& view,
+                                                                const glm::mat4& proj, glm::u16vec2 frameBufferSize,
+                                                                glm::u16vec2 tileCount);
+
+} // namespace openblack::graphics
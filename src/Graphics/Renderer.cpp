@@ -12,6 +12,9 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <span>
+
 #include <SDL_video.h>
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
@@ -28,12 +31,14 @@
 #include "3D/OceanInterface.h"
 #include "3D/SkyInterface.h"
 #include "Camera/Camera.h"
+#include "Camera/Frustum.h"
 #include "ECS/Components/Mesh.h"
 #include "ECS/Components/Sprite.h"
 #include "ECS/Registry.h"
 #include "ECS/Systems/RenderingSystemInterface.h"
 #include "EngineConfig.h"
 #include "Graphics/DebugLines.h"
+#include "Graphics/FootprintRedraw.h"
 #include "Graphics/FrameBuffer.h"
 #include "Graphics/GraphicsHandleBgfx.h"
 #include "Graphics/IndexBuffer.h"
@@ -277,6 +282,20 @@ Renderer::Renderer(uint32_t bgfxReset, std::unique_ptr<BgfxCallback>&& bgfxCallb
 
 Renderer::~Renderer() noexcept
 {
+	for (auto& visible : _visibleInstances)
+	{
+		if (visible.buffer.size > 0)
+		{
+			bgfx::destroy(toBgfx(visible.buffer.handle));
+		}
+	}
+	for (auto& visible : _visibleSprites)
+	{
+		if (visible.buffer.size > 0)
+		{
+			bgfx::destroy(toBgfx(visible.buffer.handle));
+		}
+	}
 	_plane.reset();
 	_shaderManager.reset();
 	bgfx::frame();
@@ -324,12 +343,19 @@ const Texture2D* GetTexture(uint32_t skinID, const std::unordered_map<SkinId, st
 	return texture;
 }
 
+const SkinLayer* GetSkinLayer(uint32_t skinID, const std::unordered_map<SkinId, SkinLayer>& meshSkinLayers)
+{
+	const auto skinLayer = meshSkinLayers.find(skinID);
+	return skinLayer != meshSkinLayers.end() ? &skinLayer->second : nullptr;
+}
+
 void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc,
                            bool preserveState) const
 {
 	assert(&subMesh.GetMesh());
 	// We don't draw physics meshes, we haven't implemented statuses (building and graves) and modern GPUs can handle high lod
-	if (!desc.drawAll && (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & 1) != 1))
+	if (!desc.drawAll &&
+	    (subMesh.IsPhysics() || subMesh.GetFlags().status != 0 || (subMesh.GetFlags().lodMask & (1u << desc.lod)) == 0))
 	{
 		return;
 	}
@@ -341,6 +367,15 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 	const auto& heightMap = island.GetHeightMap();
 
 	auto const& skins = mesh.GetSkins();
+	// Packed skins are sampled from a layer of a texture array by a different program
+	const auto& skinLayers = mesh.GetSkinLayers();
+	const auto* skinArrayProgram = desc.skinArrayProgram != nullptr || skinLayers.empty()
+	                                   ? desc.skinArrayProgram
+	                                   : _shaderManager->GetShader("ObjectSkinArray");
+	const auto getSkin = [&skins, &skinLayers](uint32_t skinID) -> std::pair<const Texture2D*, const SkinLayer*> {
+		const auto* skinLayer = GetSkinLayer(skinID, skinLayers);
+		return {skinLayer != nullptr ? skinLayer->array.get() : GetTexture(skinID, skins), skinLayer};
+	};
 	bool lastPreserveState = false;
 	const auto& primitives = subMesh.GetPrimitives();
 	for (auto it = primitives.begin(); it != primitives.end(); ++it)
@@ -349,10 +384,14 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 
 		const bool hasNext = std::next(it) != primitives.end();
 
-		const Texture2D* texture = GetTexture(prim.skinID, skins);
-		const Texture2D* nextTexture = !hasNext ? nullptr : GetTexture(std::next(it)->skinID, skins);
+		const auto [texture, skinLayer] = getSkin(prim.skinID);
+		const auto [nextTexture, nextSkinLayer] =
+		    !hasNext ? std::pair<const Texture2D*, const SkinLayer*> {} : getSkin(std::next(it)->skinID);
+		const auto* program = skinLayer != nullptr ? skinArrayProgram : desc.program;
 
-		const bool primitivePreserveState = texture != nullptr && texture == nextTexture && (preserveState || hasNext);
+		// The layer of a packed skin is set with the uniforms which are skipped when preserving state
+		const bool primitivePreserveState = texture != nullptr && texture == nextTexture && skinLayer == nullptr &&
+		                                    nextSkinLayer == nullptr && (preserveState || hasNext);
 
 		uint32_t skip = Mesh::SkipState::SkipNone;
 		if (!lastPreserveState)
@@ -363,22 +402,22 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 			}
 			if (texture != nullptr)
 			{
-				desc.program->SetTextureSampler("s_diffuse", 0, *texture);
+				program->SetTextureSampler("s_diffuse", 0, *texture);
 			}
 			if (desc.morphWithTerrain)
 			{
-				desc.program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
-				desc.program->SetUniformValue("u_islandExtent", &islandExtent); // vs
+				program->SetTextureSampler("s_heightmap", 1, heightMap);   // vs
+				program->SetUniformValue("u_islandExtent", &islandExtent); // vs
 			}
 			if (!desc.isSky)
 			{
 				const glm::vec4 u_skyAlphaThreshold = {
 				    Locator::skySystem::value().GetCurrentSkyType(),
 				    prim.thresholdAlpha ? prim.alphaCutoutThreshold : 0.0f,
-				    0.0f,
+				    skinLayer != nullptr ? static_cast<float>(skinLayer->layer) : 0.0f,
 				    0.0f,
 				};
-				desc.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
+				program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
 			}
 		}
 		else
@@ -406,7 +445,7 @@ void Renderer::DrawSubMesh(const graphics::L3DMesh& mesh, const graphics::L3DSub
 				bgfx::setState(desc.state, desc.rgba);
 			}
 
-			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(desc.program->GetRawHandle()), 0,
+			bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(program->GetRawHandle()), 0,
 			             primitivePreserveState ? BGFX_DISCARD_NONE : BGFX_DISCARD_ALL);
 		}
 		lastPreserveState = primitivePreserveState;
@@ -442,14 +481,312 @@ void Renderer::DrawMesh(const graphics::L3DMesh& mesh, const L3DMeshSubmitDesc&
 	}
 }
 
+void Renderer::UploadInstances(InstanceBuffer& buffer, const void* data, uint32_t count, uint8_t vec4Count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	// Recreate instancing uniform buffer if it is too small
+	if (buffer.size < count)
+	{
+		if (buffer.size > 0)
+		{
+			bgfx::destroy(toBgfx(buffer.handle));
+		}
+		// Instance data is read from TexCoord7 downwards (i_data0, i_data1, ...)
+		bgfx::VertexLayout layout;
+		layout.begin();
+		for (uint8_t i = 0; i < vec4Count; ++i)
+		{
+			layout.add(static_cast<bgfx::Attrib::Enum>(bgfx::Attrib::TexCoord7 - i), 4, bgfx::AttribType::Float);
+		}
+		layout.end();
+		buffer.size = std::max(count, buffer.size * 2);
+		buffer.handle = fromBgfx(bgfx::createDynamicVertexBuffer(buffer.size, layout));
+	}
+	// The instances are refilled every frame while the render thread may still be reading the previous ones
+	bgfx::update(toBgfx(buffer.handle), 0, bgfx::copy(data, count * vec4Count * static_cast<uint32_t>(sizeof(glm::vec4))));
+}
+
+const Renderer::VisibleInstances& Renderer::CullInstances(const DrawSceneDesc& desc, const Frustum& frustum) const
+{
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+	const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
+	auto& visible = _visibleInstances.at(static_cast<size_t>(desc.viewId));
+
+	const auto& config = Locator::config::value();
+	const std::array<float, L3DMesh::k_LodCount - 1> lodScreenSizes = {config.lod1ScreenSize, config.lod2ScreenSize};
+	const auto cameraOrigin = desc.camera->GetOrigin();
+	// Turns the ratio of radius over distance into a fraction of half of the view height
+	const auto projectionScale = desc.camera->GetProjectionMatrix(Camera::Projection::Normal)[1][1];
+
+	visible.uniforms.clear();
+	visible.draws.clear();
+	uint32_t culled = 0;
+	std::array<uint32_t, L3DMesh::k_LodCount> lodCounts {};
+	for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
+	{
+		const auto mesh = meshManager.Handle(meshId);
+		const auto boundingBox = mesh->GetBoundingBox();
+		// Meshes morphing with the terrain are displaced in the vertex shader so their transform does not bound them
+		const bool cull = desc.frustumCulling && !placers.morphWithTerrain;
+
+		for (auto& bucket : visible.lodBuckets)
+		{
+			bucket.clear();
+		}
+		for (const auto& modelMatrix : std::span(renderCtx.instanceUniforms).subspan(placers.offset, placers.count))
+		{
+			const auto worldBox = boundingBox.Transform(modelMatrix);
+			if (cull && !frustum.Intersects(worldBox))
+			{
+				++culled;
+				continue;
+			}
+
+			const auto distance = std::max(glm::distance(cameraOrigin, worldBox.Center()), 1.0f);
+			if (desc.maxModelDistance > 0.0f && distance > desc.maxModelDistance)
+			{
+				++culled;
+				continue;
+			}
+			const auto screenSize = 0.5f * glm::length(worldBox.Size()) * projectionScale / distance;
+			uint8_t lod = 0;
+			while (lod < lodScreenSizes.size() && screenSize < lodScreenSizes.at(lod))
+			{
+				++lod;
+			}
+			visible.lodBuckets.at(mesh->GetAvailableLod(lod)).push_back(modelMatrix);
+		}
+
+		// TODO (#749) use std::views::enumerate
+		for (uint8_t lod = 0; const auto& bucket : visible.lodBuckets)
+		{
+			if (!bucket.empty())
+			{
+				const auto offset = static_cast<uint32_t>(visible.uniforms.size());
+				const auto count = static_cast<uint32_t>(bucket.size());
+				visible.draws.push_back({meshId, offset, count, lod, placers.morphWithTerrain});
+				visible.uniforms.insert(visible.uniforms.end(), bucket.begin(), bucket.end());
+				lodCounts.at(lod) += count;
+			}
+			++lod;
+		}
+	}
+
+	UploadInstances(visible.buffer, visible.uniforms.data(), static_cast<uint32_t>(visible.uniforms.size()),
+	                sizeof(glm::mat4) / sizeof(glm::vec4));
+
+	auto& profiler = Locator::profiler::value();
+	profiler.Count(Profiler::Counter::ModelsVisible, static_cast<uint32_t>(visible.uniforms.size()));
+	profiler.Count(Profiler::Counter::ModelsCulled, culled);
+	profiler.Count(Profiler::Counter::ModelsLod1, lodCounts[1]);
+	profiler.Count(Profiler::Counter::ModelsLod2, lodCounts[2]);
+
+	return visible;
+}
+
+void Renderer::DrawModels(const DrawSceneDesc& desc, const VisibleInstances& visible, uint64_t state) const
+{
+	const auto& meshManager = Locator::resources::value().GetMeshes();
+	auto& submissions = _modelSubmissions.at(static_cast<size_t>(desc.viewId));
+	// Indexed by whether the mesh morphs with the terrain and whether the skin is packed in a texture array
+	const std::array<const ShaderProgram*, 4> programs = {
+	    _shaderManager->GetShader("ObjectInstanced"),
+	    _shaderManager->GetShader("ObjectHeightMapInstanced"),
+	    _shaderManager->GetShader("ObjectInstancedSkinArray"),
+	    _shaderManager->GetShader("ObjectHeightMapInstancedSkinArray"),
+	};
+
+	// Collect the primitives of all visible instanced meshes
+	submissions.clear();
+	// TODO (#749) use std::views::enumerate
+	for (uint32_t drawIndex = 0; const auto& draw : visible.draws)
+	{
+		assert(drawIndex < (1u << 23));
+		const auto mesh = meshManager.Handle(draw.meshId);
+		const auto& skins = mesh->GetSkins();
+		const auto& skinLayers = mesh->GetSkinLayers();
+		// TODO (#749) use std::views::enumerate
+		for (uint8_t subMeshIndex = 0; const auto& subMesh : mesh->GetSubMeshes())
+		{
+			// We don't draw physics meshes and we haven't implemented statuses (building and graves)
+			const auto flags = subMesh->GetFlags();
+			if (subMesh->IsPhysics() || flags.status != 0 || (flags.lodMask & (1u << draw.lod)) == 0)
+			{
+				++subMeshIndex;
+				continue;
+			}
+			// TODO (#749) use std::views::enumerate
+			for (uint16_t primitiveIndex = 0; const auto& primitive : subMesh->GetPrimitives())
+			{
+				assert(primitiveIndex < (1u << 15));
+				const auto* skinLayer = GetSkinLayer(primitive.skinID, skinLayers);
+				const auto* texture = skinLayer != nullptr ? skinLayer->array.get() : GetTexture(primitive.skinID, skins);
+				const uint64_t textureIndex =
+				    texture != nullptr ? toBgfx(texture->GetNativeHandle()).idx : bgfx::kInvalidHandle;
+				const uint64_t programIndex = (skinLayer != nullptr ? 2u : 0u) + (draw.morphWithTerrain ? 1u : 0u);
+				// Sort by program, then texture, then by mesh instance to share transforms, instance and vertex buffers.
+				// Skins packed in the same array only differ by a uniform.
+				const uint64_t sortKey = programIndex << 62u | textureIndex << 46u | static_cast<uint64_t>(drawIndex) << 23u |
+				                         static_cast<uint64_t>(subMeshIndex) << 15u | primitiveIndex;
+				submissions.push_back({
+				    .sortKey = sortKey,
+				    .program = programs.at(programIndex),
+				    .mesh = &*mesh,
+				    .subMesh = subMesh.get(),
+				    .texture = texture,
+				    .instanceOffset = draw.offset,
+				    .instanceCount = draw.count,
+				    .indicesOffset = primitive.indicesOffset,
+				    .indicesCount = primitive.indicesCount,
+				    .alphaCutoutThreshold = primitive.thresholdAlpha ? primitive.alphaCutoutThreshold : 0.0f,
+				    .skinLayer = skinLayer != nullptr ? static_cast<float>(skinLayer->layer) : 0.0f,
+				    .morphWithTerrain = draw.morphWithTerrain,
+				});
+				++primitiveIndex;
+			}
+			++subMeshIndex;
+		}
+		++drawIndex;
+	}
+	std::sort(submissions.begin(), submissions.end(),
+	          [](const ModelSubmission& a, const ModelSubmission& b) { return a.sortKey < b.sortKey; });
+
+	const auto& island = Locator::terrainSystem::value();
+	const auto extent = island.GetExtent();
+	const auto islandExtent = glm::vec4(extent.minimum, extent.maximum);
+	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
+	const static auto identity = glm::mat4(1.0f);
+
+	// Bindings are kept between submissions of the same program and only what differs from the previous one is set
+	uint32_t stateChanges = 0;
+	const ModelSubmission* previous = nullptr;
+	bool bindingsDiscarded = true;
+	for (auto it = submissions.cbegin(); it != submissions.cend(); ++it)
+	{
+		const auto& submission = *it;
+		const bool newProgram = previous == nullptr || previous->program != submission.program;
+		if (newProgram)
+		{
+			bgfx::setState(state, 0);
+			++stateChanges;
+		}
+		if (bindingsDiscarded && submission.morphWithTerrain)
+		{
+			submission.program->SetTextureSampler("s_heightmap", 1, island.GetHeightMap()); // vs
+			submission.program->SetUniformValue("u_islandExtent", &islandExtent);           // vs
+		}
+		if (newProgram || previous->mesh != submission.mesh)
+		{
+			const auto& bones = submission.mesh->GetBoneMatrices();
+			if (submission.mesh->IsBoned())
+			{
+				// TODO(bwrsandman): Get animation frame instead of default
+				bgfx::setTransform(bones.data(), static_cast<uint16_t>(bones.size()));
+			}
+			else
+			{
+				bgfx::setTransform(&identity);
+			}
+			++stateChanges;
+		}
+		if (newProgram || previous->instanceOffset != submission.instanceOffset ||
+		    previous->instanceCount != submission.instanceCount)
+		{
+			bgfx::setInstanceDataBuffer(toBgfx(visible.buffer.handle), submission.instanceOffset, submission.instanceCount);
+			++stateChanges;
+		}
+		if ((bindingsDiscarded || previous->texture != submission.texture) && submission.texture != nullptr)
+		{
+			submission.program->SetTextureSampler("s_diffuse", 0, *submission.texture);
+			++stateChanges;
+		}
+		if (newProgram || previous->subMesh != submission.subMesh)
+		{
+			submission.subMesh->GetMesh().GetVertexBuffer().Bind();
+			++stateChanges;
+		}
+		if (newProgram || previous->alphaCutoutThreshold != submission.alphaCutoutThreshold ||
+		    previous->skinLayer != submission.skinLayer)
+		{
+			const glm::vec4 u_skyAlphaThreshold = {skyType, submission.alphaCutoutThreshold, submission.skinLayer, 0.0f};
+			submission.program->SetUniformValue("u_skyAlphaThreshold", &u_skyAlphaThreshold);
+			++stateChanges;
+		}
+		if (submission.subMesh->GetMesh().IsIndexed())
+		{
+			submission.subMesh->GetMesh().GetIndexBuffer().Bind(submission.indicesCount, submission.indicesOffset);
+		}
+
+		uint8_t discard = BGFX_DISCARD_ALL;
+		if (const auto next = std::next(it); next != submissions.cend() && next->program == submission.program)
+		{
+			discard = BGFX_DISCARD_NONE;
+			// What the next submission doesn't set itself must not leak into it
+			if (!next->subMesh->GetMesh().IsIndexed())
+			{
+				discard |= BGFX_DISCARD_INDEX_BUFFER;
+			}
+			if (next->texture == nullptr && submission.texture != nullptr)
+			{
+				discard |= BGFX_DISCARD_BINDINGS;
+			}
+		}
+		bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(submission.program->GetRawHandle()), 0, discard);
+		bindingsDiscarded = (discard & BGFX_DISCARD_BINDINGS) != 0;
+		previous = &submission;
+	}
+
+	auto& profiler = Locator::profiler::value();
+	const bool reflection = desc.viewId == RenderPass::Reflection;
+	profiler.Count(reflection ? Profiler::Counter::ReflectionModelDraws : Profiler::Counter::MainPassModelDraws,
+	               static_cast<uint32_t>(submissions.size()));
+	profiler.Count(reflection ? Profiler::Counter::ReflectionModelStateChanges : Profiler::Counter::MainPassModelStateChanges,
+	               stateChanges);
+}
+
 void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 {
 	const auto viewId = graphics::RenderPass::Footprint;
 	auto section = Locator::profiler::value().BeginScoped(Profiler::Stage::FootprintPass);
 	if (drawDesc.drawIsland)
 	{
+		auto& profiler = Locator::profiler::value();
+
+		// The framebuffer keeps its content when the view is not submitted to, so it is only redrawn where footprints
+		// were added, moved or removed
+		const auto dirtyArea = Locator::rendereringSystem::value().TakeFootprintDirtyArea();
+		if (!dirtyArea.has_value())
+		{
+			profiler.Count(Profiler::Counter::FootprintPassesSkipped);
+			return;
+		}
+
 		const auto& island = Locator::terrainSystem::value();
-		island.GetFootprintFramebuffer().Bind(viewId);
+		const auto& frameBuffer = island.GetFootprintFramebuffer();
+		const auto view = island.GetOrthoView();
+		uint16_t width;
+		uint16_t height;
+		frameBuffer.GetSize(width, height);
+		const auto indexExtent = island.GetIndexExtent();
+		const auto redraw = GetFootprintRedraw(*dirtyArea, view, island.GetOrthoProj(), {width, height},
+		                                       indexExtent.maximum - indexExtent.minimum + glm::u16vec2(1));
+		if (!redraw.has_value())
+		{
+			// The change is outside of the island
+			profiler.Count(Profiler::Counter::FootprintPassesSkipped);
+			return;
+		}
+		profiler.Count(Profiler::Counter::FootprintTilesRedrawn, redraw->tileCount);
+
+		frameBuffer.Bind(viewId);
+		// The view clear covers the whole view rect, so the view is limited to the redrawn tiles and the rest of the
+		// framebuffer is kept
+		bgfx::setViewRect(static_cast<bgfx::ViewId>(viewId), redraw->rectPosition.x, redraw->rectPosition.y,
+		                  redraw->rectSize.x, redraw->rectSize.y);
 
 		// This dummy draw call is here to make sure that view is cleared if no
 		// other draw calls are submitted to view
@@ -457,9 +794,7 @@ void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 
 		// _shaderManager->SetCamera(viewId, *drawDesc.camera); // TODO
 
-		auto view = island.GetOrthoView();
-		auto proj = island.GetOrthoProj();
-		bgfx::setViewTransform(static_cast<bgfx::ViewId>(viewId), &view, &proj);
+		bgfx::setViewTransform(static_cast<bgfx::ViewId>(viewId), &view, &redraw->proj);
 
 		const auto& meshManager = Locator::resources::value().GetMeshes();
 		const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
@@ -487,15 +822,49 @@ void Renderer::DrawFootprintPass(const DrawSceneDesc& drawDesc) const
 	}
 }
 
+bool Renderer::ReflectionNeedsRedraw(const Camera& camera) const
+{
+	const auto& config = Locator::config::value();
+	const auto origin = camera.GetOrigin();
+	const auto focus = camera.GetFocus();
+
+	++_reflection.framesSinceDraw;
+	if (_reflection.valid)
+	{
+		if (_reflection.framesSinceDraw < config.reflectionUpdateInterval)
+		{
+			return false;
+		}
+		const bool cameraStill = glm::distance(origin, _reflection.origin) < config.reflectionReuseDistance &&
+		                         glm::distance(focus, _reflection.focus) < config.reflectionReuseDistance;
+		// The rest of the scene still moves, so a still camera doesn't keep the reflection forever
+		if (cameraStill && _reflection.framesSinceDraw < k_ReflectionMaxReusedFrames)
+		{
+			return false;
+		}
+	}
+
+	_reflection = {origin, focus, 0, true};
+	return true;
+}
+
 void Renderer::DrawScene(const DrawSceneDesc& drawDesc) const noexcept
 {
-	// TODO(bwrsandman): Footprint framebuffer doesn't need to be updated each frame
 	DrawFootprintPass(drawDesc);
 	// Reflection Pass
 	{
 		auto section = Locator::profiler::value().BeginScoped(Profiler::Stage::ReflectionPass);
-		if (drawDesc.drawWater)
+		if (!drawDesc.drawWater)
+		{
+			_reflection.valid = false;
+		}
+		else if (!ReflectionNeedsRedraw(*drawDesc.camera))
 		{
+			Locator::profiler::value().Count(Profiler::Counter::ReflectionPassesSkipped);
+		}
+		else
+		{
+			const auto& config = Locator::config::value();
 			DrawSceneDesc drawPassDesc = drawDesc;
 
 			const auto& frameBuffer = Locator::oceanSystem::value().GetReflectionFramebuffer();
@@ -506,6 +875,7 @@ void Renderer::DrawScene(const DrawSceneDesc& drawDesc) const noexcept
 			drawPassDesc.frameBuffer = &frameBuffer;
 			drawPassDesc.drawWater = false;
 			drawPassDesc.drawBoundingBoxes = false;
+			drawPassDesc.maxModelDistance = config.reflectionModelDistance;
 			drawPassDesc.cullBack = true;
 
 			DrawPass(drawPassDesc);
@@ -533,15 +903,14 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 	bgfx::touch(static_cast<bgfx::ViewId>(desc.viewId));
 
 	_shaderManager->SetCamera(desc.viewId, *desc.camera);
+	const auto frustum = desc.camera->GetFrustum();
 
 	const auto* skyShader = _shaderManager->GetShader("Sky");
 	const auto* waterShader = _shaderManager->GetShader("Water");
 	const auto* terrainShader = _shaderManager->GetShader("Terrain");
 	const auto* debugShader = _shaderManager->GetShader("DebugLine");
-	const auto* spriteShader = _shaderManager->GetShader("Sprite");
+	const auto* spriteShader = _shaderManager->GetShader("SpriteInstanced");
 	const auto* debugShaderInstanced = _shaderManager->GetShader("DebugLineInstanced");
-	const auto* objectShaderInstanced = _shaderManager->GetShader("ObjectInstanced");
-	const auto* objectShaderHeightMapInstanced = _shaderManager->GetShader("ObjectHeightMapInstanced");
 
 	const auto skyType = Locator::skySystem::value().GetCurrentSkyType();
 
@@ -630,8 +999,17 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			;
 			// clang-format on
 
+			uint32_t visibleBlocks = 0;
+			uint32_t culledBlocks = 0;
 			for (const auto& block : island.GetBlocks())
 			{
+				if (desc.frustumCulling && !frustum.Intersects(block.GetBoundingBox()))
+				{
+					++culledBlocks;
+					continue;
+				}
+				++visibleBlocks;
+
 				// pack uniforms
 				const glm::vec4 mapPositionAndSize = glm::vec4(block.GetMapPosition(), 160.0f, 160.0f);
 				terrainShader->SetUniformValue("u_blockPositionAndSize", &mapPositionAndSize);
@@ -642,6 +1020,8 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 				bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(terrainShader->GetRawHandle()), 0, discard);
 			}
 			bgfx::discard(BGFX_DISCARD_BINDINGS);
+			profiler.Count(Profiler::Counter::LandBlocksVisible, visibleBlocks);
+			profiler.Count(Profiler::Counter::LandBlocksCulled, culledBlocks);
 		}
 	}
 
@@ -650,42 +1030,14 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 		                                                                          : Profiler::Stage::MainPassDrawModels);
 		if (desc.drawEntities)
 		{
-			L3DMeshSubmitDesc submitDesc = {};
-			submitDesc.viewId = desc.viewId;
-			submitDesc.program = objectShaderInstanced;
-			submitDesc.state = 0u                              //
-			                   | BGFX_STATE_WRITE_MASK         //
-			                   | BGFX_STATE_DEPTH_TEST_GREATER //
-			                   | BGFX_STATE_MSAA               //
+			const uint64_t state = 0u                              //
+			                       | BGFX_STATE_WRITE_MASK         //
+			                       | BGFX_STATE_DEPTH_TEST_GREATER //
+			                       | BGFX_STATE_MSAA               //
 			    ;
 			const auto& renderCtx = Locator::rendereringSystem::value().GetContext();
-
-			// Instance meshes
-			for (const auto& [meshId, placers] : renderCtx.instancedDrawDescs)
-			{
-				auto mesh = meshManager.Handle(meshId);
-
-				submitDesc.instanceDesc =
-				    std::make_unique<graphics::InstanceDesc>(renderCtx.instanceUniformBuffer, placers.offset, placers.count);
-				if (mesh->IsBoned())
-				{
-					submitDesc.modelMatrices = mesh->GetBoneMatrices().data();
-					submitDesc.matrixCount = static_cast<uint8_t>(mesh->GetBoneMatrices().size());
-					// TODO(bwrsandman): Get animation frame instead of default
-				}
-				else
-				{
-					const static auto identity = glm::mat4(1.0f);
-					submitDesc.modelMatrices = &identity;
-					submitDesc.matrixCount = 1;
-				}
-				submitDesc.isSky = false;
-				submitDesc.morphWithTerrain = placers.morphWithTerrain;
-				submitDesc.program = submitDesc.morphWithTerrain ? objectShaderHeightMapInstanced : objectShaderInstanced;
-
-				// TODO(bwrsandman): choose the correct LOD
-				DrawMesh(*mesh, submitDesc, std::numeric_limits<uint8_t>::max());
-			}
+			const auto& visible = CullInstances(desc, frustum);
+			DrawModels(desc, visible, state);
 
 			// Debug
 			if (desc.viewId == graphics::RenderPass::Main)
@@ -731,29 +1083,61 @@ void Renderer::DrawPass(const DrawSceneDesc& desc) const
 			{
 				using namespace ecs::components;
 
+				auto& sprites = _visibleSprites.at(static_cast<size_t>(desc.viewId));
+				sprites.unsorted.clear();
+				sprites.instances.clear();
+				sprites.draws.clear();
+
+				uint32_t culledSprites = 0;
 				auto& registry = Locator::entitiesRegistry::value();
 				registry.Each<const Sprite, const Transform>(
-				    [this, &spriteShader, &desc](const Sprite& sprite, const Transform& transform) {
-					    glm::mat4 modelMatrix = glm::mat4(1.0f);
-					    modelMatrix = glm::translate(modelMatrix, transform.position);
-					    modelMatrix *= glm::mat4(transform.rotation);
-					    modelMatrix = glm::scale(modelMatrix, transform.scale);
-
-					    glm::vec4 u_sampleRect(sprite.uvExtent, sprite.uvMin);
-
-					    bgfx::setTransform(glm::value_ptr(modelMatrix));
-					    spriteShader->SetUniformValue("u_sampleRect", glm::value_ptr(u_sampleRect));
-					    spriteShader->SetUniformValue("u_tint", glm::value_ptr(sprite.tint));
-					    spriteShader->SetTextureSampler("s_diffuse", 0, sprite.texture);
+				    [&sprites, &desc, &frustum, &culledSprites](const Sprite& sprite, const Transform& transform) {
+					    // The sprite plane spans [-1, 1] before scaling
+					    if (desc.frustumCulling && !frustum.Intersects(transform.position, glm::length(transform.scale)))
+					    {
+						    ++culledSprites;
+						    return;
+					    }
+
+					    sprites.unsorted.emplace_back(sprite.texture,
+					                                  SpriteInstance {
+					                                      .axisX = glm::vec4(transform.rotation[0] * transform.scale.x, 0.0f),
+					                                      .axisY = glm::vec4(transform.rotation[1] * transform.scale.y, 0.0f),
+					                                      .translation = glm::vec4(transform.position, 1.0f),
+					                                      .sampleRect = glm::vec4(sprite.uvExtent, sprite.uvMin),
+					                                      .tint = sprite.tint,
+					                                  });
+				    });
 
-					    _plane->GetVertexBuffer().Bind();
+				// Batch sprites sharing a texture, the blending is additive so draw order does not matter
+				std::sort(sprites.unsorted.begin(), sprites.unsorted.end(),
+				          [](const auto& a, const auto& b) { return a.first.id < b.first.id; });
+				for (const auto& [texture, instance] : sprites.unsorted)
+				{
+					if (sprites.draws.empty() || sprites.draws.back().texture.id != texture.id)
+					{
+						sprites.draws.push_back({texture, static_cast<uint32_t>(sprites.instances.size()), 0});
+					}
+					++sprites.draws.back().count;
+					sprites.instances.push_back(instance);
+				}
+				UploadInstances(sprites.buffer, sprites.instances.data(), static_cast<uint32_t>(sprites.instances.size()),
+				                sizeof(SpriteInstance) / sizeof(glm::vec4));
 
-					    bgfx::setState(0 | BGFX_STATE_DEPTH_TEST_GREATER | BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
-					                   BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE) |
-					                   BGFX_STATE_BLEND_EQUATION(BGFX_STATE_BLEND_EQUATION_ADD));
+				for (const auto& draw : sprites.draws)
+				{
+					spriteShader->SetTextureSampler("s_diffuse", 0, draw.texture);
+					_plane->GetVertexBuffer().Bind();
+					bgfx::setInstanceDataBuffer(toBgfx(sprites.buffer.handle), draw.offset, draw.count);
+					bgfx::setState(0 | BGFX_STATE_DEPTH_TEST_GREATER | BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
+					               BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_SRC_ALPHA, BGFX_STATE_BLEND_ONE) |
+					               BGFX_STATE_BLEND_EQUATION(BGFX_STATE_BLEND_EQUATION_ADD));
+					bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(spriteShader->GetRawHandle()));
+				}
 
-					    bgfx::submit(static_cast<bgfx::ViewId>(desc.viewId), toBgfx(spriteShader->GetRawHandle()));
-				    });
+				profiler.Count(Profiler::Counter::SpritesVisible, static_cast<uint32_t>(sprites.instances.size()));
+				profiler.Count(Profiler::Counter::SpritesCulled, culledSprites);
+				profiler.Count(Profiler::Counter::SpriteBatches, static_cast<uint32_t>(sprites.draws.size()));
 			}
 		}
 	}
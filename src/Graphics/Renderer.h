@@ -19,9 +19,11 @@
 #include <vector>
 
 #include <SDL.h>
+#include <entt/core/fwd.hpp>
 #include <glm/fwd.hpp>
 #include <glm/mat4x4.hpp>
 
+#include "3D/L3DMesh.h"
 #include "Graphics/RenderPass.h"
 #include "Graphics/RendererInterface.h"
 
@@ -32,6 +34,7 @@
 namespace openblack
 {
 struct BgfxCallback;
+class Frustum;
 class Game;
 
 namespace ecs
@@ -66,6 +69,99 @@ class Renderer final: public RendererInterface
 	void Reset(glm::u16vec2 resolution) const noexcept final;
 
 private:
+	/// GPU-side copy of per-instance data which is rewritten every frame. It grows to fit but never shrinks.
+	struct InstanceBuffer
+	{
+		DynamicVertexBufferHandle handle;
+		/// Size of \ref handle in instances, 0 if it has not been created yet
+		uint32_t size {0};
+	};
+
+	/// Model instances of a pass which are inside the camera frustum, compacted into their own instance buffer and
+	/// bucketed by the level of detail selected from their projected size
+	struct VisibleInstances
+	{
+		struct Draw
+		{
+			entt::id_type meshId;
+			uint32_t offset;
+			uint32_t count;
+			uint8_t lod;
+			bool morphWithTerrain;
+		};
+
+		/// Visible instances of a mesh and per level of detail, sorted by mesh then lod
+		std::vector<glm::mat4> uniforms;
+		std::vector<Draw> draws;
+		/// Scratch space used to sort the visible instances of one mesh by lod
+		std::array<std::vector<glm::mat4>, L3DMesh::k_LodCount> lodBuckets;
+		InstanceBuffer buffer;
+	};
+
+	/// One primitive of an instanced mesh, collected by \ref DrawModels and submitted in the order of its sort key
+	struct ModelSubmission
+	{
+		uint64_t sortKey;
+		const ShaderProgram* program;
+		const L3DMesh* mesh;
+		const L3DSubMesh* subMesh;
+		const Texture2D* texture;
+		uint32_t instanceOffset;
+		uint32_t instanceCount;
+		uint32_t indicesOffset;
+		uint32_t indicesCount;
+		float alphaCutoutThreshold;
+		float skinLayer; ///< Layer of the texture array if the skin is packed
+		bool morphWithTerrain;
+	};
+
+	/// Per-instance data of vs_sprite_instanced
+	struct SpriteInstance
+	{
+		glm::vec4 axisX; ///< Rotated and scaled x axis of the sprite plane
+		glm::vec4 axisY; ///< Rotated and scaled y axis of the sprite plane
+		glm::vec4 translation;
+		glm::vec4 sampleRect;
+		glm::vec4 tint;
+	};
+
+	/// Sprites of a pass which are inside the camera frustum, batched by texture
+	struct VisibleSprites
+	{
+		struct Draw
+		{
+			TextureHandle texture;
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		/// Scratch space used to sort the visible sprites by texture
+		std::vector<std::pair<TextureHandle, SpriteInstance>> unsorted;
+		std::vector<SpriteInstance> instances;
+		std::vector<Draw> draws;
+		InstanceBuffer buffer;
+	};
+
+	/// Camera at the time the reflection framebuffer was last drawn and how many frames it was reused for since
+	struct ReflectionState
+	{
+		glm::vec3 origin;
+		glm::vec3 focus;
+		uint32_t framesSinceDraw;
+		bool valid;
+	};
+
+	/// A reflection is reused for at most this many frames when the camera is still
+	static constexpr uint32_t k_ReflectionMaxReusedFrames = 60;
+
+	/// Upload a copy of count instances of vec4Count vec4 each, recreating the buffer if it is too small
+	static void UploadInstances(InstanceBuffer& buffer, const void* data, uint32_t count, uint8_t vec4Count);
+
+	const VisibleInstances& CullInstances(const DrawSceneDesc& desc, const Frustum& frustum) const;
+	/// Whether the reflection framebuffer is out of date according to the reflection settings of the engine config
+	[[nodiscard]] bool ReflectionNeedsRedraw(const Camera& camera) const;
+	/// Sort the primitives of the visible instances by program and texture and submit them reusing bindings
+	void DrawModels(const DrawSceneDesc& desc, const VisibleInstances& visible, uint64_t state) const;
 	void DrawFootprintPass(const DrawSceneDesc& drawDesc) const;
 	void DrawSubMesh(const L3DMesh& mesh, const L3DSubMesh& subMesh, const L3DMeshSubmitDesc& desc, bool preserveState) const;
 	void DrawPass(const DrawSceneDesc& desc) const;
@@ -76,6 +172,14 @@ class Renderer final: public RendererInterface
 	bool _bgfxDebug = false;
 	bool _bgfxProfile = false;
 	std::unique_ptr<Mesh> _plane;
+	/// Refilled every frame by \ref CullInstances for each pass drawing models
+	mutable std::array<VisibleInstances, static_cast<size_t>(RenderPass::_count)> _visibleInstances;
+	/// Refilled every frame for each pass drawing sprites
+	mutable std::array<VisibleSprites, static_cast<size_t>(RenderPass::_count)> _visibleSprites;
+	/// Refilled every frame by \ref DrawModels for each pass drawing models
+	mutable std::array<std::vector<ModelSubmission>, static_cast<size_t>(RenderPass::_count)> _modelSubmissions;
+	/// Used by \ref ReflectionNeedsRedraw to decide when the reflection framebuffer can be reused
+	mutable ReflectionState _reflection {};
 };
 } // namespace graphics
 } // namespace openblack
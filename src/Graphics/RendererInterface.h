@@ -59,6 +59,8 @@ class RendererInterface
 		bool drawEntities;
 		bool drawSprites;
 		bool drawBoundingBoxes;
+		bool frustumCulling;
+		float maxModelDistance; ///< Models further than this from the camera are not drawn, 0 draws all of them
 		bool cullBack;
 		bool wireframe;
 	};
@@ -67,6 +69,8 @@ class RendererInterface
 	{
 		graphics::RenderPass viewId;
 		const graphics::ShaderProgram* program;
+		/// Used instead of program for primitives with a skin packed in a texture array, the plain object one if null
+		const graphics::ShaderProgram* skinArrayProgram;
 		uint64_t state;
 		uint32_t rgba;
 		const glm::mat4* modelMatrices;
@@ -77,6 +81,7 @@ class RendererInterface
 		bool isSky;
 		bool drawAll; ///< For use in the mesh viewer
 		bool morphWithTerrain;
+		uint8_t lod; ///< Only submeshes with this level of detail in their lod mask are drawn
 	};
 
 	static std::unique_ptr<RendererInterface> Create(GraphicsBackend backend, bool vsync) noexcept;
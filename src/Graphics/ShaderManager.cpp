@@ -60,6 +60,8 @@
 #include "ShaderIncluder.h"
 #define SHADER_NAME fs_object
 #include "ShaderIncluder.h"
+#define SHADER_NAME fs_object_skin_array
+#include "ShaderIncluder.h"
 #define SHADER_NAME fs_sky
 #include "ShaderIncluder.h"
 
@@ -77,6 +79,10 @@
 #include "ShaderIncluder.h"
 #define SHADER_NAME fs_sprite
 #include "ShaderIncluder.h"
+#define SHADER_NAME vs_sprite_instanced
+#include "ShaderIncluder.h"
+#define SHADER_NAME fs_sprite_instanced
+#include "ShaderIncluder.h"
 
 #define SHADER_NAME vs_footprint_instanced
 #include "ShaderIncluder.h"
@@ -94,14 +100,15 @@ struct ShaderDefinition
 	const std::string_view fragmentShaderName;
 };
 
-const std::array<bgfx::EmbeddedShader, 17> k_EmbeddedShaders = {{
+const std::array<bgfx::EmbeddedShader, 20> k_EmbeddedShaders = {{
     BGFX_EMBEDDED_SHADER(vs_line), BGFX_EMBEDDED_SHADER(vs_line_instanced),                                                   //
     BGFX_EMBEDDED_SHADER(fs_line),                                                                                            //
     BGFX_EMBEDDED_SHADER(vs_object), BGFX_EMBEDDED_SHADER(vs_object_instanced), BGFX_EMBEDDED_SHADER(vs_object_hm_instanced), //
-    BGFX_EMBEDDED_SHADER(fs_object), BGFX_EMBEDDED_SHADER(fs_sky),                                                            //
+    BGFX_EMBEDDED_SHADER(fs_object), BGFX_EMBEDDED_SHADER(fs_object_skin_array), BGFX_EMBEDDED_SHADER(fs_sky),                //
     BGFX_EMBEDDED_SHADER(vs_terrain), BGFX_EMBEDDED_SHADER(fs_terrain),                                                       //
     BGFX_EMBEDDED_SHADER(vs_water), BGFX_EMBEDDED_SHADER(fs_water),                                                           //
     BGFX_EMBEDDED_SHADER(vs_sprite), BGFX_EMBEDDED_SHADER(fs_sprite),                                                         //
+    BGFX_EMBEDDED_SHADER(vs_sprite_instanced), BGFX_EMBEDDED_SHADER(fs_sprite_instanced),                                     //
     BGFX_EMBEDDED_SHADER(vs_footprint_instanced), BGFX_EMBEDDED_SHADER(fs_footprint),                                         //
     BGFX_EMBEDDED_SHADER_END()                                                                                                //
 }};
@@ -113,9 +120,13 @@ constexpr std::array k_Shaders {
     ShaderDefinition {"Object", "vs_object", "fs_object"},
     ShaderDefinition {"ObjectInstanced", "vs_object_instanced", "fs_object"},
     ShaderDefinition {"ObjectHeightMapInstanced", "vs_object_hm_instanced", "fs_object"},
+    ShaderDefinition {"ObjectSkinArray", "vs_object", "fs_object_skin_array"},
+    ShaderDefinition {"ObjectInstancedSkinArray", "vs_object_instanced", "fs_object_skin_array"},
+    ShaderDefinition {"ObjectHeightMapInstancedSkinArray", "vs_object_hm_instanced", "fs_object_skin_array"},
     ShaderDefinition {"Sky", "vs_object", "fs_sky"},
     ShaderDefinition {"Water", "vs_water", "fs_water"},
     ShaderDefinition {"Sprite", "vs_sprite", "fs_sprite"},
+    ShaderDefinition {"SpriteInstanced", "vs_sprite_instanced", "fs_sprite_instanced"},
     ShaderDefinition {"FootprintInstanced", "vs_footprint_instanced", "fs_footprint"},
 };
 
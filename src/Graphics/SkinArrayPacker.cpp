@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "SkinArrayPacker.h"
+
+#include <cassert>
+
+#include <algorithm>
+#include <string>
+
+#include <L3DFile.h>
+#include <bgfx/bgfx.h>
+
+#include "Texture2D.h"
+
+using namespace openblack::graphics;
+
+namespace
+{
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): packers are scoped on the main thread
+SkinArrayPacker* g_ActivePacker = nullptr;
+
+constexpr size_t k_TexelsPerSkin = openblack::l3d::L3DTexture::k_Width * openblack::l3d::L3DTexture::k_Height;
+} // namespace
+
+SkinArrayPacker::SkinArrayPacker(uint16_t layersPerArray) noexcept
+    : _layersPerArray(std::clamp<uint16_t>(layersPerArray, k_MinLayersPerArray, k_MaxLayersPerArray))
+{
+	assert(g_ActivePacker == nullptr);
+	g_ActivePacker = this;
+}
+
+SkinArrayPacker::~SkinArrayPacker() noexcept
+{
+	Flush();
+	assert(g_ActivePacker == this);
+	g_ActivePacker = nullptr;
+}
+
+SkinArrayPacker* SkinArrayPacker::GetActive() noexcept
+{
+	return g_ActivePacker;
+}
+
+SkinLayer SkinArrayPacker::Add(const l3d::L3DTexture& skin)
+{
+	if (_array == nullptr)
+	{
+		_array = std::make_shared<Texture2D>("skins/" + std::to_string(_arrayCount));
+		_staging.reserve(k_TexelsPerSkin * _layersPerArray);
+	}
+
+	const auto* texels = reinterpret_cast<const uint16_t*>(skin.texels.data());
+	_staging.insert(_staging.end(), texels, texels + k_TexelsPerSkin);
+	const SkinLayer result {_array, _layerCount};
+	++_layerCount;
+	++_skinCount;
+
+	if (_layerCount == _layersPerArray)
+	{
+		Flush();
+	}
+	return result;
+}
+
+void SkinArrayPacker::Flush() noexcept
+{
+	if (_array == nullptr)
+	{
+		return;
+	}
+
+	const auto layerCount = std::max(_layerCount, k_MinLayersPerArray);
+	_staging.resize(k_TexelsPerSkin * layerCount);
+	_array->Create(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height, layerCount, TextureFormat::BGRA4, Wrapping::Repeat,
+	               Filter::Linear, bgfx::copy(_staging.data(), static_cast<uint32_t>(_staging.size() * sizeof(_staging[0]))));
+	_array.reset();
+	_staging.clear();
+	_layerCount = 0;
+	++_arrayCount;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#include <vector>
+
+namespace openblack::l3d
+{
+struct L3DTexture;
+}
+
+namespace openblack::graphics
+{
+class Texture2D;
+
+/// Where a packed L3D skin is stored
+struct SkinLayer
+{
+	std::shared_ptr<const Texture2D> array;
+	uint16_t layer;
+};
+
+/// Scope during which the skins of loaded L3D meshes are packed into texture arrays instead of a texture each.
+///
+/// All L3D skins share the same size and format, so any of them can be packed together. Primitives sampling skins from
+/// the same array can then be drawn one after the other with only a change of layer uniform. An array is created once
+/// it is full or when the packer is destroyed, skins are not drawable before that. Only one packer may exist at a time
+/// and it is main thread only.
+class SkinArrayPacker
+{
+public:
+	/// Bounds the size of the staging memory of an array
+	static constexpr uint16_t k_MaxLayersPerArray = 64;
+	/// bgfx only creates an array texture with more than one layer, a shorter array is padded with blank layers
+	static constexpr uint16_t k_MinLayersPerArray = 2;
+
+	explicit SkinArrayPacker(uint16_t layersPerArray = k_MaxLayersPerArray) noexcept;
+	~SkinArrayPacker() noexcept;
+	SkinArrayPacker(const SkinArrayPacker&) = delete;
+	SkinArrayPacker& operator=(const SkinArrayPacker&) = delete;
+	SkinArrayPacker(SkinArrayPacker&&) = delete;
+	SkinArrayPacker& operator=(SkinArrayPacker&&) = delete;
+
+	/// The packer in scope, nullptr if skins should get a texture each
+	[[nodiscard]] static SkinArrayPacker* GetActive() noexcept;
+
+	/// Copy a skin to the array being filled
+	[[nodiscard]] SkinLayer Add(const l3d::L3DTexture& skin);
+	/// Number of skins packed and arrays created so far
+	[[nodiscard]] uint32_t GetSkinCount() const noexcept { return _skinCount; }
+	[[nodiscard]] uint32_t GetArrayCount() const noexcept { return _arrayCount; }
+
+private:
+	/// Create the array being filled from the staged skins
+	void Flush() noexcept;
+
+	const uint16_t _layersPerArray;
+	std::shared_ptr<Texture2D> _array;
+	std::vector<uint16_t> _staging;
+	uint16_t _layerCount {0};
+	uint32_t _skinCount {0};
+	uint32_t _arrayCount {0};
+};
+
+} // namespace openblack::graphics
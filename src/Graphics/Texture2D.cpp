@@ -17,6 +17,7 @@
 #include <stb_image_write.h>
 
 #include "GraphicsHandleBgfx.h"
+#include "UploadBatch.h"
 
 namespace openblack::graphics
 {
@@ -66,7 +67,6 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Texture
 	_handle = fromBgfx(bgfx::createTexture2D(width, height, false, layers, toBgfx(format), flags,
 	                                         reinterpret_cast<const bgfx::Memory*>(memory)));
 	bgfx::setName(toBgfx(_handle), _name.c_str());
-	bgfx::frame();
 
 	bgfx::TextureInfo textureInfo;
 	bgfx::calcTextureSize(textureInfo, width, height, 1, false, false, layers, toBgfx(format));
@@ -76,7 +76,7 @@ void Texture2D::Create(uint16_t width, uint16_t height, uint16_t layers, Texture
 	_stride = textureInfo.width * textureInfo.bitsPerPixel / 8;
 	_storageSize = textureInfo.storageSize;
 
-	bgfx::frame();
+	UploadBatch::ResourcesCreated();
 }
 
 void Texture2D::DumpTexture() const
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "UploadBatch.h"
+
+#include <cassert>
+
+#include <bgfx/bgfx.h>
+
+using namespace openblack::graphics;
+
+namespace
+{
+struct UploadBatchState
+{
+	uint32_t depth;
+	uint32_t pendingResources;
+	uint32_t flushCount;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): batches are scoped on the main thread
+UploadBatchState g_State {0, 0, 0};
+
+void Flush() noexcept
+{
+	bgfx::frame();
+	g_State.pendingResources = 0;
+	++g_State.flushCount;
+}
+} // namespace
+
+UploadBatch::UploadBatch() noexcept
+{
+	++g_State.depth;
+}
+
+UploadBatch::~UploadBatch() noexcept
+{
+	assert(g_State.depth > 0);
+	--g_State.depth;
+	if (g_State.depth == 0 && g_State.pendingResources > 0)
+	{
+		Flush();
+	}
+}
+
+void UploadBatch::ResourcesCreated(uint32_t count) noexcept
+{
+	g_State.pendingResources += count;
+	if (g_State.depth == 0 || g_State.pendingResources >= k_MaxPendingResources)
+	{
+		Flush();
+	}
+}
+
+uint32_t UploadBatch::GetFlushCount() noexcept
+{
+	return g_State.flushCount;
+}
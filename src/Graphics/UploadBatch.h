@@ -0,0 +1,41 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace openblack::graphics
+{
+
+/// Scope during which creating GPU resources doesn't submit a frame after every resource.
+///
+/// Outside of a batch, resources created from bgfx::makeRef memory are flushed right away with a frame so the caller may
+/// free the memory. Inside a batch, a frame is only submitted every k_MaxPendingResources resources and when the
+/// outermost batch ends, so referenced memory has to outlive the batch. Batches nest and are main thread only.
+class UploadBatch
+{
+public:
+	/// Bounds the renderer command buffer usage of a batch
+	static constexpr uint32_t k_MaxPendingResources = 256;
+
+	UploadBatch() noexcept;
+	~UploadBatch() noexcept;
+	UploadBatch(const UploadBatch&) = delete;
+	UploadBatch& operator=(const UploadBatch&) = delete;
+	UploadBatch(UploadBatch&&) = delete;
+	UploadBatch& operator=(UploadBatch&&) = delete;
+
+	/// Call after creating count resources, submits a frame if they can't be deferred
+	static void ResourcesCreated(uint32_t count = 1) noexcept;
+	/// Number of frames submitted so far to flush created resources
+	[[nodiscard]] static uint32_t GetFlushCount() noexcept;
+};
+
+} // namespace openblack::graphics
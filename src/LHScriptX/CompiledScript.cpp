@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "CompiledScript.h"
+
+#include <cstring>
+
+#include <array>
+#include <type_traits>
+
+#include "FeatureScriptCommands.h"
+
+using namespace openblack::lhscriptx;
+
+namespace
+{
+
+struct Header
+{
+	std::array<char, 4> magic;
+	uint32_t version;
+	uint64_t sourceHash;
+	/// Command indices are only valid for the same signature table
+	uint64_t signaturesHash;
+	uint32_t commandCount;
+	uint32_t argumentCount;
+	uint32_t stringSize;
+	uint32_t padding;
+};
+
+constexpr std::array<char, 4> k_Magic = {'L', 'H', 'S', 'X'};
+constexpr uint32_t k_Version = 1;
+
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(std::is_trivially_copyable_v<CompiledScript::Command>);
+static_assert(std::is_trivially_copyable_v<CompiledScript::Argument>);
+
+constexpr uint64_t k_FnvOffsetBasis = 0xcbf29ce484222325;
+constexpr uint64_t k_FnvPrime = 0x100000001b3;
+
+uint64_t Fnv1a(std::span<const uint8_t> data, uint64_t hash = k_FnvOffsetBasis)
+{
+	for (const auto byte : data)
+	{
+		hash = (hash ^ byte) * k_FnvPrime;
+	}
+	return hash;
+}
+
+uint64_t HashSignatures()
+{
+	static const auto k_Hash = []() {
+		auto hash = k_FnvOffsetBasis;
+		for (const auto& signature : FeatureScriptCommands::k_Signatures)
+		{
+			const auto name = std::string_view(signature.name.data());
+			hash = Fnv1a({reinterpret_cast<const uint8_t*>(name.data()), name.size() + 1}, hash);
+			hash = Fnv1a({reinterpret_cast<const uint8_t*>(signature.parameters.data()), sizeof(signature.parameters)}, hash);
+		}
+		return hash;
+	}();
+	return k_Hash;
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, std::span<const T> values)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+	data.insert(data.end(), bytes, bytes + values.size_bytes());
+}
+
+} // namespace
+
+CompiledScript::CompiledScript(uint64_t sourceHash)
+    : _sourceHash(sourceHash)
+{
+}
+
+uint64_t CompiledScript::HashSource(std::string_view source)
+{
+	return Fnv1a({reinterpret_cast<const uint8_t*>(source.data()), source.size()});
+}
+
+void CompiledScript::AddCommand(uint16_t signature)
+{
+	_commands.emplace_back(Command {signature, 0, static_cast<uint32_t>(_arguments.size())});
+}
+
+CompiledScript::Argument& CompiledScript::AddArgument(ParameterType type)
+{
+	++_commands.back().argumentCount;
+	return _arguments.emplace_back(Argument {type, 0, 0.0f, 0.0f, 0, 0});
+}
+
+void CompiledScript::AddNumber(int32_t value)
+{
+	AddArgument(ParameterType::Number).number = value;
+}
+
+void CompiledScript::AddFloat(float value)
+{
+	AddArgument(ParameterType::Float).x = value;
+}
+
+void CompiledScript::AddVector(float x, float z)
+{
+	auto& argument = AddArgument(ParameterType::Vector);
+	argument.x = x;
+	argument.z = z;
+}
+
+void CompiledScript::AddString(std::string_view value)
+{
+	auto& argument = AddArgument(ParameterType::String);
+	argument.stringOffset = static_cast<uint32_t>(_strings.size());
+	argument.stringSize = static_cast<uint32_t>(value.size());
+	_strings.append(value);
+}
+
+std::span<const CompiledScript::Argument> CompiledScript::GetArguments(const Command& command) const
+{
+	return std::span(_arguments).subspan(command.firstArgument, command.argumentCount);
+}
+
+std::string_view CompiledScript::GetString(const Argument& argument) const
+{
+	return std::string_view(_strings).substr(argument.stringOffset, argument.stringSize);
+}
+
+std::vector<uint8_t> CompiledScript::Serialize() const
+{
+	const Header header {
+	    .magic = k_Magic,
+	    .version = k_Version,
+	    .sourceHash = _sourceHash,
+	    .signaturesHash = HashSignatures(),
+	    .commandCount = static_cast<uint32_t>(_commands.size()),
+	    .argumentCount = static_cast<uint32_t>(_arguments.size()),
+	    .stringSize = static_cast<uint32_t>(_strings.size()),
+	    .padding = 0,
+	};
+
+	std::vector<uint8_t> data;
+	data.reserve(sizeof(header) + _commands.size() * sizeof(Command) + _arguments.size() * sizeof(Argument) +
+	             _strings.size());
+	Append(data, std::span(&header, 1));
+	Append(data, std::span(_commands));
+	Append(data, std::span(_arguments));
+	Append(data, std::span(_strings));
+	return data;
+}
+
+std::optional<CompiledScript> CompiledScript::Deserialize(std::span<const uint8_t> data, uint64_t sourceHash)
+{
+	Header header;
+	if (data.size() < sizeof(header))
+	{
+		return std::nullopt;
+	}
+	std::memcpy(&header, data.data(), sizeof(header));
+	if (header.magic != k_Magic || header.version != k_Version || header.sourceHash != sourceHash ||
+	    header.signaturesHash != HashSignatures())
+	{
+		return std::nullopt;
+	}
+
+	const auto commandsSize = static_cast<size_t>(header.commandCount) * sizeof(Command);
+	const auto argumentsSize = static_cast<size_t>(header.argumentCount) * sizeof(Argument);
+	if (data.size() != sizeof(header) + commandsSize + argumentsSize + header.stringSize)
+	{
+		return std::nullopt;
+	}
+
+	CompiledScript script(sourceHash);
+	script._commands.resize(header.commandCount);
+	script._arguments.resize(header.argumentCount);
+	auto remaining = data.subspan(sizeof(header));
+	std::memcpy(script._commands.data(), remaining.data(), commandsSize);
+	remaining = remaining.subspan(commandsSize);
+	std::memcpy(script._arguments.data(), remaining.data(), argumentsSize);
+	remaining = remaining.subspan(argumentsSize);
+	script._strings.assign(reinterpret_cast<const char*>(remaining.data()), remaining.size());
+
+	for (const auto& command : script._commands)
+	{
+		if (command.signature >= FeatureScriptCommands::k_Signatures.size() ||
+		    static_cast<size_t>(command.firstArgument) + command.argumentCount > script._arguments.size())
+		{
+			return std::nullopt;
+		}
+	}
+	for (const auto& argument : script._arguments)
+	{
+		if (argument.type == ParameterType::String &&
+		    static_cast<size_t>(argument.stringOffset) + argument.stringSize > script._strings.size())
+		{
+			return std::nullopt;
+		}
+	}
+
+	return script;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CommandSignature.h"
+
+namespace openblack::lhscriptx
+{
+
+/// Commands of a land script parsed ahead of time with their typed arguments.
+///
+/// It can be saved and loaded back to skip lexing and parsing when the same script is loaded again. Vector arguments keep
+/// their x and z, the height is sampled from the land when the script is run.
+class CompiledScript
+{
+public:
+	struct Command
+	{
+		/// Index in FeatureScriptCommands::k_Signatures
+		uint16_t signature;
+		uint16_t argumentCount;
+		uint32_t firstArgument;
+	};
+
+	struct Argument
+	{
+		ParameterType type;
+		int32_t number;
+		/// The value of floats and the x and z of vectors
+		float x;
+		float z;
+		/// Strings are stored after one another in the string data
+		uint32_t stringOffset;
+		uint32_t stringSize;
+	};
+
+	explicit CompiledScript(uint64_t sourceHash);
+
+	/// 64-bit FNV-1a of the script source, compiled scripts are only loaded back for the same source
+	[[nodiscard]] static uint64_t HashSource(std::string_view source);
+
+	void AddCommand(uint16_t signature);
+	/// Arguments are added to the last command
+	void AddNumber(int32_t value);
+	void AddFloat(float value);
+	void AddVector(float x, float z);
+	void AddString(std::string_view value);
+
+	[[nodiscard]] uint64_t GetSourceHash() const { return _sourceHash; }
+	[[nodiscard]] const std::vector<Command>& GetCommands() const { return _commands; }
+	[[nodiscard]] std::span<const Argument> GetArguments(const Command& command) const;
+	[[nodiscard]] std::string_view GetString(const Argument& argument) const;
+
+	[[nodiscard]] std::vector<uint8_t> Serialize() const;
+	/// Returns nullopt if data was not serialized from a script with the same source hash by this version of the game
+	[[nodiscard]] static std::optional<CompiledScript> Deserialize(std::span<const uint8_t> data, uint64_t sourceHash);
+
+private:
+	Argument& AddArgument(ParameterType type);
+
+	uint64_t _sourceHash;
+	std::vector<Command> _commands;
+	std::vector<Argument> _arguments;
+	std::string _strings;
+};
+
+} // namespace openblack::lhscriptx
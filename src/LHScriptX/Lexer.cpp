@@ -10,16 +10,37 @@
 #include "Lexer.h"
 
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
 
-#include <utility>
+#include <charconv>
+#include <string>
 
 using namespace openblack::lhscriptx;
 
-Lexer::Lexer(std::string source)
-    : _source(std::move(source))
+namespace
+{
+/// Parse all of [begin, end) as a float. std::from_chars for floats is missing from libc++ before LLVM 20, where
+/// __cpp_lib_to_chars isn't defined, std::strtof is used on a null terminated copy instead.
+bool ParseFloat(const char* begin, const char* end, float& value)
+{
+#if defined(__cpp_lib_to_chars)
+	const auto [ptr, error] = std::from_chars(begin, end, value);
+	return error == std::errc() && ptr == end;
+#else
+	const std::string copy(begin, end);
+	char* copyEnd = nullptr;
+	errno = 0;
+	value = std::strtof(copy.c_str(), &copyEnd);
+	return errno != ERANGE && copyEnd != copy.c_str() && copyEnd == copy.c_str() + copy.size();
+#endif
+}
+} // namespace
+
+Lexer::Lexer(std::string_view source)
+    : _current(source.data())
+    , _end(source.data() + source.size())
 {
-	_current = _source.begin();
-	_end = _source.end();
 }
 
 Token Lexer::GetToken()
@@ -36,13 +57,15 @@ Token Lexer::GetToken()
 		{
 		case '/':
 			// Comment syntax. Ignore the rest of the line
-			if (*(_current + 1) == '/')
+			if (Remaining() < 2 || _current[1] != '/')
 			{
-				// Skip line
-				while (*_current != '\n' && _current != _end)
-				{
-					_current++;
-				}
+				_current++;
+				throw LexerException("unexpected character: /");
+			}
+			// Skip line
+			while (HasMore() && *_current != '\n')
+			{
+				_current++;
 			}
 			break;
 		case ' ':
@@ -51,7 +74,7 @@ Token Lexer::GetToken()
 			_current++;
 
 			// skip over whitespace quickly
-			while (*_current == ' ' || *_current == '\t' || *_current == '\r')
+			while (HasMore() && (*_current == ' ' || *_current == '\t' || *_current == '\r'))
 			{
 				_current++;
 			}
@@ -64,7 +87,7 @@ Token Lexer::GetToken()
 		// not sure if it's **** or just *, this can be drastically improved on
 		// though
 		case '*':
-			while (*_current != '\n')
+			while (HasMore() && *_current != '\n')
 			{
 				_current++;
 			}
@@ -73,10 +96,9 @@ Token Lexer::GetToken()
 		// handle potential rem/REM
 		case 'R':
 		case 'r':
-			// todo: potential out of bounds here:
-			if ((_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
+			if (Remaining() >= 3 && (_current[1] == 'e' || _current[1] == 'E') && (_current[2] == 'm' || _current[2] == 'M'))
 			{
-				while (*_current != '\n')
+				while (HasMore() && *_current != '\n')
 				{
 					_current++;
 				}
@@ -200,22 +222,19 @@ Token Lexer::GatherIdentifer()
 		_current++;
 	}
 
-	return Token::MakeIdentifierToken(std::string(idStart, _current));
+	return Token::MakeIdentifierToken(std::string_view(idStart, _current));
 }
 
 Token Lexer::GatherNumber()
 {
 	bool isFloat = false;
-	bool isNeg = false;
 
+	const auto* numberStart = _current;
 	if (*_current == '-')
 	{
 		_current++;
-		isNeg = true;
 	}
 
-	auto numberStart = _current;
-
 	// consume all digits and .
 	while (HasMore())
 	{
@@ -236,18 +255,19 @@ Token Lexer::GatherNumber()
 
 	if (isFloat)
 	{
-		float value = std::stof(std::string(numberStart, _current));
-		if (isNeg)
+		float value;
+		if (!ParseFloat(numberStart, _current, value))
 		{
-			value = -value;
+			throw LexerException("invalid number " + std::string(numberStart, _current));
 		}
 		return Token::MakeFloatToken(value);
 	}
 
-	int value = std::stoi(std::string(numberStart, _current));
-	if (isNeg)
+	int value;
+	const auto [end, error] = std::from_chars(numberStart, _current, value);
+	if (error != std::errc() || end != _current)
 	{
-		value = -value;
+		throw LexerException("invalid number " + std::string(numberStart, _current));
 	}
 	return Token::MakeIntegerToken(value);
 }
@@ -256,13 +276,16 @@ Token Lexer::GatherString()
 {
 	auto stringStart = ++_current;
 
-	// todo: we should check for unterminated strings
 	while (HasMore() && *_current != '"')
 	{
 		_current++;
 	}
+	if (!HasMore())
+	{
+		throw LexerException("unterminated string");
+	}
 
-	return Token::MakeStringToken(std::string(stringStart, _current++));
+	return Token::MakeStringToken(std::string_view(stringStart, _current++));
 }
 
 void Token::Print(FILE* file) const
@@ -279,10 +302,10 @@ void Token::Print(FILE* file) const
 		fprintf(file, "\n");
 		break;
 	case Type::Identifier:
-		fprintf(file, "identifier \"%s\"", this->_s.c_str());
+		fprintf(file, "identifier \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::String:
-		fprintf(file, "quoted string \"%s\"", this->_s.c_str());
+		fprintf(file, "quoted string \"%.*s\"", static_cast<int>(this->_s.size()), this->_s.data());
 		break;
 	case Type::Integer:
 		fprintf(file, "integer %d", this->_u.integerValue);
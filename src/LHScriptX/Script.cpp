@@ -9,9 +9,15 @@
 
 #include "Script.h"
 
+#include <cassert>
+#include <cstdlib>
+
 #include <algorithm>
 #include <ranges>
+#include <string>
+#include <vector>
 
+#include <entt/core/hashed_string.hpp>
 #include <glm/vec2.hpp>
 
 #include "3D/LandIslandInterface.h"
@@ -22,11 +28,60 @@
 using namespace openblack;
 using namespace openblack::lhscriptx;
 
+namespace
+{
+
+struct CommandHash
+{
+	entt::id_type hash;
+	uint16_t signature;
+};
+
+/// Hashes of the command names sorted for a binary search. Signatures hold std::functions so this is built on first use.
+const std::vector<CommandHash>& GetCommandHashes()
+{
+	static const auto k_Hashes = []() {
+		std::vector<CommandHash> hashes;
+		hashes.reserve(FeatureScriptCommands::k_Signatures.size());
+		// TODO (#749) use std::views::enumerate
+		for (uint16_t i = 0; const auto& signature : FeatureScriptCommands::k_Signatures)
+		{
+			hashes.emplace_back(CommandHash {entt::hashed_string::value(signature.name.data()), i});
+			++i;
+		}
+		std::sort(hashes.begin(), hashes.end(), [](const auto& a, const auto& b) { return a.hash < b.hash; });
+		// Names are checked after the lookup, but a collision would hide one of the commands
+		assert(std::adjacent_find(hashes.begin(), hashes.end(),
+		                          [](const auto& a, const auto& b) { return a.hash == b.hash; }) == hashes.end());
+		return hashes;
+	}();
+	return k_Hashes;
+}
+
+/// Parse all of str as a float. Like std::strtof, leading whitespace and a '+' sign are allowed. An empty str isn't a float.
+bool ParseFloat(std::string_view str, float& value)
+{
+	// std::strtof needs a null terminated string, short numbers fit in the copy's small string buffer
+	const std::string copy(str);
+	char* end = nullptr;
+	value = std::strtof(copy.c_str(), &end);
+	return end != copy.c_str() && end == copy.c_str() + copy.size();
+}
+
+} // namespace
+
 Script::Script() = default;
 
-void Script::Load(const std::string& source)
+void Script::Load(std::string_view source)
+{
+	Run(Compile(source));
+}
+
+CompiledScript Script::Compile(std::string_view source)
 {
+	CompiledScript script(CompiledScript::HashSource(source));
 	Lexer lexer(source);
+	_token = Token::MakeInvalidToken();
 
 	const Token* token = this->PeekToken(lexer);
 	while (!token->IsEOF())
@@ -35,29 +90,28 @@ void Script::Load(const std::string& source)
 
 		if (token->IsIdentifier())
 		{
-			const std::string identifier = token->Identifier();
+			const auto identifier = token->Identifier();
 
-			if (!IsCommand(identifier))
+			const auto signature = FindCommand(identifier);
+			if (!signature.has_value())
 			{
-				throw std::runtime_error("unknown command: " + identifier);
+				throw std::runtime_error("unknown command: " + std::string(identifier));
 			}
+			script.AddCommand(*signature);
 
 			token = this->AdvanceToken(lexer);
 			if (!token->IsOP(Operator::LeftParentheses))
 			{
-				throw std::runtime_error("expected ( after identifier " + identifier);
+				throw std::runtime_error("expected ( after identifier " + std::string(identifier));
 			}
 
-			std::vector<Token> args;
-
 			// if it's an immediate right parentheses there are no args
 			token = this->AdvanceToken(lexer);
 			if (!token->IsOP(Operator::RightParentheses))
 			{
 				while (true)
 				{
-					const Token* peekToken = this->PeekToken(lexer);
-					args.push_back(*peekToken);
+					AddArgument(*this->PeekToken(lexer), script);
 
 					// consume the ,
 					token = this->AdvanceToken(lexer);
@@ -78,21 +132,30 @@ void Script::Load(const std::string& source)
 			// move token to whatever is after ')'
 			this->AdvanceToken(lexer);
 
-			RunCommand(identifier, args);
+			ValidateCommand(script, script.GetCommands().back());
 		}
 
 		this->AdvanceToken(lexer);
 	}
+
+	return script;
 }
 
-bool Script::IsCommand(const std::string& identifier) const
+std::optional<uint16_t> Script::FindCommand(std::string_view identifier)
 {
-	// TODO(handsomematt): this could be done a lot better
-	return std::any_of(FeatureScriptCommands::k_Signatures.cbegin(), FeatureScriptCommands::k_Signatures.cend(),
-	                   [&identifier](const auto& s) { return s.name.data() == identifier; });
+	const auto& hashes = GetCommandHashes();
+	const auto hash = entt::hashed_string::value(identifier.data(), identifier.size());
+	const auto iter = std::lower_bound(hashes.begin(), hashes.end(), hash,
+	                                   [](const auto& entry, entt::id_type value) { return entry.hash < value; });
+	if (iter == hashes.end() || iter->hash != hash ||
+	    std::string_view(FeatureScriptCommands::k_Signatures.at(iter->signature).name.data()) != identifier)
+	{
+		return std::nullopt;
+	}
+	return iter->signature;
 }
 
-ScriptCommandParameter GetParameter(Token& argument)
+void Script::AddArgument(const Token& argument, CompiledScript& script)
 {
 	const auto type = argument.GetType();
 
@@ -105,33 +168,32 @@ ScriptCommandParameter GetParameter(Token& argument)
 	case Token::Type::EndOfLine:
 		throw std::runtime_error("Unexpected EOL in script");
 	case Token::Type::Identifier:
-		return ScriptCommandParameter(argument.Identifier());
+		script.AddString(argument.Identifier());
+		return;
 	case Token::Type::String:
 	{
-		const auto& str = argument.StringValue();
+		const auto str = argument.StringValue();
 		// Check if it's a vector
-		if (std::count_if(str.cbegin(), str.cend(), [](char c) { return c == ','; }) == 1)
+		const auto delim = str.find(',');
+		if (delim != std::string_view::npos && str.find(',', delim + 1) == std::string_view::npos)
 		{
-			const auto delim = str.find(',');
-			char* floatEnd;
-			const auto x = std::strtof(str.c_str(), &floatEnd);
-			if (str.c_str() + delim == floatEnd)
+			float x;
+			float z;
+			if (ParseFloat(str.substr(0, delim), x) && ParseFloat(str.substr(delim + 1), z))
 			{
-				const auto z = std::strtof(floatEnd + 1, &floatEnd);
-				if (static_cast<size_t>(floatEnd - str.c_str()) == static_cast<size_t>(str.length()))
-				{
-					const auto& island = Locator::terrainSystem::value();
-
-					return {x, island.GetHeightAt(glm::vec2(x, z)), z};
-				}
+				script.AddVector(x, z);
+				return;
 			}
 		}
-		return ScriptCommandParameter(str);
+		script.AddString(str);
+		return;
 	}
 	case Token::Type::Integer:
-		return ScriptCommandParameter(*argument.IntegerValue());
+		script.AddNumber(*argument.IntegerValue());
+		return;
 	case Token::Type::Float:
-		return ScriptCommandParameter(*argument.FloatValue());
+		script.AddFloat(*argument.FloatValue());
+		return;
 	case Token::Type::Operator:
 		throw std::runtime_error("Operator token as an argument is currently not supported");
 	default:
@@ -139,39 +201,15 @@ ScriptCommandParameter GetParameter(Token& argument)
 	}
 }
 
-void Script::RunCommand(const std::string& identifier, const std::vector<Token>& args)
+void Script::ValidateCommand(const CompiledScript& script, const CompiledScript::Command& command)
 {
-	const ScriptCommandSignature* commandSignature = nullptr;
+	const auto& commandSignature = FeatureScriptCommands::k_Signatures.at(command.signature);
+	const auto arguments = script.GetArguments(command);
 
-	for (const auto& signature : FeatureScriptCommands::k_Signatures)
-	{
-		if (signature.name.data() != identifier)
-		{
-			continue;
-		}
-
-		commandSignature = &signature;
-		break;
-	}
-
-	if (commandSignature == nullptr)
-	{
-		throw std::runtime_error("Missing script command signature");
-	}
-
-	// Turn tokens into parameters
-	auto parameters = ScriptCommandParameters();
-
-	for (auto arg : args)
-	{
-		const ScriptCommandParameter param = GetParameter(arg);
-		parameters.push_back(param);
-	}
-
-	const auto expectedParameters = commandSignature->parameters;
+	const auto expectedParameters = commandSignature.parameters;
 	uint32_t expectedSize;
 	// TODO (#749) use std::views::enumerate
-	for (expectedSize = 0; const auto& p : commandSignature->parameters)
+	for (expectedSize = 0; const auto& p : commandSignature.parameters)
 	{
 		// Looping until None because parameters is a fixed sized array.
 		// Last Argument is the one before the first None or the 9th
@@ -183,21 +221,56 @@ void Script::RunCommand(const std::string& identifier, const std::vector<Token>&
 	}
 
 	// Validate the number of given arguments against what is expected
-	if (parameters.size() != expectedSize)
+	if (arguments.size() != expectedSize)
 	{
 		throw std::runtime_error("Invalid number of script arguments");
 	}
 
 	// Validate the typing of the given arguments against what is expected
-	for (const auto& [param, expected] : std::views::zip(parameters, expectedParameters))
+	for (const auto& [argument, expected] : std::views::zip(arguments, expectedParameters))
 	{
-		if (param.GetType() != expected)
+		if (argument.type != expected)
 		{
 			throw std::runtime_error("Invalid script argument type");
 		}
 	}
+}
 
-	commandSignature->command(parameters);
+void Script::Run(const CompiledScript& script) const
+{
+	auto parameters = ScriptCommandParameters();
+
+	for (const auto& command : script.GetCommands())
+	{
+		// Turn arguments into parameters
+		parameters.clear();
+		for (const auto& argument : script.GetArguments(command))
+		{
+			switch (argument.type)
+			{
+			case ParameterType::String:
+				parameters.emplace_back(std::string(script.GetString(argument)));
+				break;
+			case ParameterType::Float:
+				parameters.emplace_back(argument.x);
+				break;
+			case ParameterType::Number:
+				parameters.emplace_back(argument.number);
+				break;
+			case ParameterType::Vector:
+			{
+				// Commands earlier in the script may have changed the land
+				const auto& island = Locator::terrainSystem::value();
+				parameters.emplace_back(argument.x, island.GetHeightAt(glm::vec2(argument.x, argument.z)), argument.z);
+				break;
+			}
+			default:
+				throw std::runtime_error("Missing switch case for script argument");
+			}
+		}
+
+		FeatureScriptCommands::k_Signatures.at(command.signature).command(parameters);
+	}
 }
 
 const Token* Script::PeekToken(Lexer& lexer)
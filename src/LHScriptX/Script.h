@@ -9,8 +9,12 @@
 
 #pragma once
 
-#include <vector>
+#include <cstdint>
 
+#include <optional>
+#include <string_view>
+
+#include "CompiledScript.h"
 #include "Lexer.h"
 
 namespace openblack::lhscriptx
@@ -21,11 +25,17 @@ class Script
 public:
 	Script();
 
-	void Load(const std::string&);
+	/// Compile and run the script
+	void Load(std::string_view source);
+	/// Parse the commands of the script and check their arguments without running them
+	CompiledScript Compile(std::string_view source);
+	void Run(const CompiledScript& script) const;
 
 private:
-	[[nodiscard]] bool IsCommand(const std::string& identifier) const;
-	void RunCommand(const std::string& identifier, const std::vector<Token>& args);
+	/// Index of the command in FeatureScriptCommands::k_Signatures
+	[[nodiscard]] static std::optional<uint16_t> FindCommand(std::string_view identifier);
+	static void AddArgument(const Token& argument, CompiledScript& script);
+	static void ValidateCommand(const CompiledScript& script, const CompiledScript::Command& command);
 
 	const Token* PeekToken(Lexer&);
 	const Token* AdvanceToken(Lexer&);
@@ -22,6 +22,7 @@
 #include "Audio/AudioManagerNoOp.h"
 #include "CHLApi.h"
 #include "Common/EventManager.h"
+#include "Common/JobSystem.h"
 #include "Common/RandomNumberManagerProduction.h"
 #include "Debug/DebugGuiInterface.h"
 #include "ECS/Archetypes/PlayerArchetype.h"
@@ -35,6 +36,7 @@
 #include "ECS/Systems/Implementations/PlayerSystem.h"
 #include "ECS/Systems/Implementations/RenderingSystem.h"
 #include "ECS/Systems/Implementations/TownSystem.h"
+#include "EngineConfig.h"
 #include "Graphics/RendererInterface.h"
 #include "Input/GameActionMap.h"
 #include "LHVM.h"
@@ -83,6 +85,8 @@ bool openblack::InitializeEngine(GraphicsBackend backend, bool vsync) noexcept
 	SPDLOG_LOGGER_INFO(spdlog::get("game"), GLM_VERSION_COMPLETE);
 
 	Locator::profiler::emplace();
+	Locator::jobSystem::emplace(Locator::config::value().threadCount);
+	SPDLOG_LOGGER_INFO(spdlog::get("game"), "Running jobs on {} threads", Locator::jobSystem::value().GetThreadCount());
 
 	Locator::rendererInterface::reset(RendererInterface::Create(backend, vsync).release());
 	if (!Locator::rendererInterface::has_value())
@@ -124,7 +128,7 @@ bool openblack::InitializeGame() noexcept
 	Locator::entitiesRegistry::emplace<Registry>();
 	Locator::handSystem::emplace<HandSystem>();
 	Locator::temple::emplace<TempleInterior>();
-	Locator::oceanSystem::emplace<Ocean>();
+	Locator::oceanSystem::emplace<Ocean>(Locator::config::value().reflectionResolutionScale);
 	Locator::skySystem::emplace<Sky>();
 
 	return true;
@@ -139,6 +143,11 @@ void openblack::InitializeLevel(const std::filesystem::path& path)
 	Locator::pathfindingSystem::emplace<PathfindingSystem>();
 	Locator::cameraBookmarkSystem::emplace<CameraBookmarkSystem>();
 	Locator::terrainSystem::emplace<LandIsland>(path);
+	// The footprints of the new island have never been drawn
+	if (Locator::rendereringSystem::has_value())
+	{
+		Locator::rendereringSystem::value().SetFootprintsDirty();
+	}
 }
 
 void openblack::ShutDownServices()
@@ -172,6 +181,7 @@ void openblack::ShutDownServices()
 	Locator::townSystem::reset();
 	Locator::handSystem::reset();
 	Locator::pathfindingSystem::reset();
+	Locator::entitiesMap::reset();
 	Locator::terrainSystem::reset();
 	Locator::filesystem::reset();
 	Locator::gameActionSystem::reset();
@@ -187,6 +197,7 @@ void openblack::ShutDownServices()
 	Locator::config::reset();
 	Locator::infoConstants::reset();
 	Locator::profiler::reset();
+	Locator::jobSystem::reset();
 
 	Locator::vm::reset();
 }
@@ -23,6 +23,7 @@ namespace openblack
 struct EngineConfig;
 class Camera;
 class EventManager;
+class JobSystem;
 class LandIslandInterface;
 class OceanInterface;
 class Profiler;
@@ -112,6 +113,7 @@ struct Locator
 	using infoConstants = entt::locator<const InfoConstants>;
 	using profiler = entt::locator<Profiler>;
 	using events = entt::locator<EventManager>;
+	using jobSystem = entt::locator<JobSystem>;
 	using windowing = entt::locator<windowing::WindowingInterface>;
 	using debugGui = entt::locator<debug::gui::DebugGuiInterface>;
 	using filesystem = entt::locator<filesystem::FileSystemInterface>;
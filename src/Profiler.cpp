@@ -32,9 +32,15 @@ void openblack::Profiler::End(Stage stage)
 	entry.finalized = true;
 }
 
+void openblack::Profiler::Count(Counter counter, uint32_t value)
+{
+	_entries.at(_currentEntry).counters.at(static_cast<uint8_t>(counter)) += value;
+}
+
 void openblack::Profiler::Frame()
 {
 	auto& prevEntry = _entries.at(_currentEntry);
 	_currentEntry = (_currentEntry + 1) % k_BufferSize;
 	prevEntry.frameEnd = _entries.at(_currentEntry).frameStart = std::chrono::system_clock::now();
+	_entries.at(_currentEntry).counters.fill(0);
 }
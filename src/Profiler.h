@@ -33,6 +33,7 @@ class Profiler
 		UpdateAudio,
 		GuiLoop,
 		GameLogic,
+		MapUpdate,
 		SceneDraw,
 		FootprintPass,
 		ReflectionPass,
@@ -63,6 +64,7 @@ class Profiler
 	    "Audio",                //
 	    "GUI Loop",             //
 	    "Game Logic",           //
+	    "Map Update",           //
 	    "Encode Draw Scene",    //
 	    "Footprint Pass",       //
 	    "Reflection Pass",      //
@@ -81,6 +83,55 @@ class Profiler
 	    "Renderer Frame",       //
 	};
 
+	enum class Counter : uint8_t
+	{
+		MapRebuilds,
+		MapMobileRelinks,
+		RenderContextRebuilds,
+		RenderEntityUpdates,
+		ModelsVisible,
+		ModelsCulled,
+		ModelsLod1,
+		ModelsLod2,
+		LandBlocksVisible,
+		LandBlocksCulled,
+		SpritesVisible,
+		SpritesCulled,
+		SpriteBatches,
+		FootprintPassesSkipped,
+		FootprintTilesRedrawn,
+		ReflectionPassesSkipped,
+		MainPassModelDraws,
+		MainPassModelStateChanges,
+		ReflectionModelDraws,
+		ReflectionModelStateChanges,
+
+		_count,
+	};
+
+	constexpr static std::array<std::string_view, static_cast<uint8_t>(Counter::_count)> k_CounterNames = {
+	    "Map Full Rebuilds",              //
+	    "Map Mobile Relinks",             //
+	    "Render Context Rebuilds",        //
+	    "Render Entity Updates",          //
+	    "Models Visible",                 //
+	    "Models Culled",                  //
+	    "Models LOD 1",                   //
+	    "Models LOD 2",                   //
+	    "Land Blocks Visible",            //
+	    "Land Blocks Culled",             //
+	    "Sprites Visible",                //
+	    "Sprites Culled",                 //
+	    "Sprite Batches",                 //
+	    "Footprint Passes Skipped",       //
+	    "Footprint Tiles Redrawn",        //
+	    "Reflection Passes Skipped",      //
+	    "Main Pass Model Draws",          //
+	    "Main Pass Model State Changes",  //
+	    "Reflection Model Draws",         //
+	    "Reflection Model State Changes", //
+	};
+
 private:
 	struct ScopedSection
 	{
@@ -110,12 +161,15 @@ class Profiler
 		std::chrono::system_clock::time_point frameStart;
 		std::chrono::system_clock::time_point frameEnd;
 		std::array<Scope, static_cast<uint8_t>(Stage::_count)> stages;
+		std::array<uint32_t, static_cast<uint8_t>(Counter::_count)> counters;
 	};
 
 	void Frame();
 	void Begin(Stage stage);
 	void End(Stage stage);
 	inline ScopedSection BeginScoped(Stage stage) { return ScopedSection(this, stage); }
+	/// Accumulate a value into a counter of the current entry. Counters are reset at every frame.
+	void Count(Counter counter, uint32_t value = 1);
 
 	[[nodiscard]] uint8_t GetEntryIndex(int8_t offset) const { return (_currentEntry + k_BufferSize + offset) % k_BufferSize; }
 
@@ -13,7 +13,10 @@
 #include <ranges>
 #include <utility>
 
+#include <ANMFile.h>
 #include <GLWFile.h>
+#include <L3DFile.h>
+#include <MappedPackFile.h>
 #include <PackFile.h>
 #include <bgfx/bgfx.h>
 #include <spdlog/spdlog.h>
@@ -43,6 +46,12 @@ L3DLoader::result_type L3DLoader::operator()(FromBufferTag, const std::string& d
 	return mesh;
 }
 
+L3DLoader::result_type L3DLoader::operator()(FromPreparedTag, result_type mesh, const l3d::L3DFile& l3d) const
+{
+	mesh->Upload(l3d);
+	return mesh;
+}
+
 L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem::path& path) const
 {
 	auto mesh = std::make_shared<graphics::L3DMesh>(path.stem().string());
@@ -73,7 +82,7 @@ L3DLoader::result_type L3DLoader::operator()(FromDiskTag, const std::filesystem:
 }
 
 Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std::string& name,
-                                                         const pack::G3DTexture& g3dTexture) const
+                                                         const pack::G3DTextureView& g3dTexture) const
 {
 	// some assumptions:
 	// - no mipmaps
@@ -101,7 +110,7 @@ Texture2DLoader::result_type Texture2DLoader::operator()(FromPackTag, const std:
 
 	texture2D->Create(static_cast<uint16_t>(g3dTexture.ddsHeader.width), static_cast<uint16_t>(g3dTexture.ddsHeader.height), 1,
 	                  internalFormat, graphics::Wrapping::Repeat, graphics::Filter::Linear,
-	                  bgfx::makeRef(g3dTexture.ddsData.data(), static_cast<uint32_t>(g3dTexture.ddsData.size())));
+	                  bgfx::copy(g3dTexture.ddsData.data(), static_cast<uint32_t>(g3dTexture.ddsData.size())));
 	return texture2D;
 }
 
@@ -156,6 +165,13 @@ L3DAnimLoader::result_type L3DAnimLoader::operator()(FromBufferTag, const std::v
 	return animation;
 }
 
+L3DAnimLoader::result_type L3DAnimLoader::operator()(FromParsedTag, const anm::ANMFile& anm) const
+{
+	auto animation = std::make_shared<L3DAnim>();
+	animation->Load(anm);
+	return animation;
+}
+
 L3DAnimLoader::result_type L3DAnimLoader::operator()(FromDiskTag, const std::filesystem::path& path) const
 {
 	auto animation = std::make_shared<L3DAnim>();
@@ -180,7 +196,7 @@ CreatureMindLoader::result_type CreatureMindLoader::operator()(FromDiskTag, cons
 
 SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromBufferTag,
                                                  const pack::AudioBankSampleHeader& header,
-                                                 const std::vector<std::vector<uint8_t>>& buffer) const
+                                                 std::vector<std::span<const uint8_t>> buffer) const
 {
 	auto sound = std::make_shared<audio::Sound>();
 	// Let's clean up the names as they're very difficult to read from the debug GUI
@@ -193,7 +209,16 @@ SoundLoader::result_type SoundLoader::operator()(BaseLoader<audio::Sound>::FromB
 	sound->pitch = header.pitch;
 	sound->pitchDeviation = header.pitchDeviation;
 	sound->playType = static_cast<audio::PlayType>(header.loopType);
-	sound->buffer = buffer;
+	sound->buffer = std::move(buffer);
+	return sound;
+}
+
+SoundLoader::result_type SoundLoader::operator()(FromPackTag, std::shared_ptr<const pack::MappedPackFile> pack,
+                                                 size_t index) const
+{
+	auto sound = (*this)(FromBufferTag {}, pack->GetAudioSampleHeaders().at(index),
+	                     std::vector<std::span<const uint8_t>> {pack->GetAudioSamplesData().at(index)});
+	sound->pack = std::move(pack);
 	return sound;
 }
 
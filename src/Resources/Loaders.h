@@ -19,6 +19,16 @@
 #include "Creature/CreatureMind.h"
 #include "Level.h"
 
+namespace openblack::anm
+{
+class ANMFile;
+}
+
+namespace openblack::l3d
+{
+class L3DFile;
+}
+
 namespace openblack::graphics
 {
 class L3DMesh;
@@ -28,7 +38,8 @@ class Texture2D;
 namespace openblack::pack
 {
 struct AudioBankSampleHeader;
-struct G3DTexture;
+struct G3DTextureView;
+class MappedPackFile;
 } // namespace openblack::pack
 
 namespace openblack::resources
@@ -49,7 +60,13 @@ struct BaseLoader
 
 struct L3DLoader final: BaseLoader<graphics::L3DMesh>
 {
+	/// From a mesh which was already prepared from the file, possibly on another thread. Only creates the GPU resources.
+	struct FromPreparedTag
+	{
+	};
+
 	[[nodiscard]] result_type operator()(FromBufferTag, const std::string& debugName, const std::vector<uint8_t>& data) const;
+	[[nodiscard]] result_type operator()(FromPreparedTag, result_type mesh, const l3d::L3DFile& l3d) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 
@@ -59,13 +76,19 @@ struct Texture2DLoader final: BaseLoader<graphics::Texture2D>
 	{
 	};
 
-	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const pack::G3DTexture& g3dTexture) const;
+	[[nodiscard]] result_type operator()(FromPackTag, const std::string& name, const pack::G3DTextureView& g3dTexture) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& rawTexturePath) const;
 };
 
 struct L3DAnimLoader final: BaseLoader<L3DAnim>
 {
+	/// From a file which was already parsed, possibly on another thread
+	struct FromParsedTag
+	{
+	};
+
 	[[nodiscard]] result_type operator()(FromBufferTag, const std::vector<uint8_t>& data) const;
+	[[nodiscard]] result_type operator()(FromParsedTag, const anm::ANMFile& anm) const;
 	[[nodiscard]] result_type operator()(FromDiskTag, const std::filesystem::path& path) const;
 };
 
@@ -81,8 +104,15 @@ struct CreatureMindLoader final: BaseLoader<creature::CreatureMind>
 
 struct SoundLoader final: BaseLoader<audio::Sound>
 {
+	/// From a sample of a pack with resolved audio samples, the sound shares ownership of the pack instead of copying
+	struct FromPackTag
+	{
+	};
+
+	/// The encoded buffers are not copied and must outlive the sound
 	[[nodiscard]] result_type operator()(FromBufferTag, const pack::AudioBankSampleHeader& header,
-	                                     const std::vector<std::vector<uint8_t>>& buffer) const;
+	                                     std::vector<std::span<const uint8_t>> buffer) const;
+	[[nodiscard]] result_type operator()(FromPackTag, std::shared_ptr<const pack::MappedPackFile> pack, size_t index) const;
 };
 
 struct LightLoader final: BaseLoader<Lights>
@@ -9,18 +9,75 @@
 
 #include "FotFile.h"
 
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
 #include <spdlog/spdlog.h>
 
 #include "3D/LandIslandInterface.h"
 #include "ECS/Components/Footpath.h"
 #include "ECS/Registry.h"
 #include "FileSystem/FileSystemInterface.h"
-#include "GameThingSerializer.h"
+#include "GameThingReader.h"
 #include "Locator.h"
 
 using namespace openblack;
 using namespace openblack::filesystem;
 
+namespace
+{
+bool SameThing(const serializer::GameThingReader::Thing& first, const serializer::GameThingReader::Thing& second)
+{
+	return first.unknown1 == second.unknown1 && first.unknown2 == second.unknown2;
+}
+
+/// Compare two footpaths of reader by content, as the footpaths of links may be copies of those of the footpath list
+bool SameFootpath(const serializer::GameThingReader& reader, uint32_t first, uint32_t second)
+{
+	const auto& firstFootpath = reader.GetFootpaths()[first];
+	const auto& secondFootpath = reader.GetFootpaths()[second];
+	const auto nodes = reader.GetFootpathNodes();
+	return SameThing(firstFootpath, secondFootpath) && firstFootpath.unknown == secondFootpath.unknown &&
+	       std::ranges::equal(reader.GetFootpathNodeIndices(firstFootpath), reader.GetFootpathNodeIndices(secondFootpath),
+	                          [nodes](uint32_t firstNode, uint32_t secondNode) {
+		                          const auto& a = nodes[firstNode];
+		                          const auto& b = nodes[secondNode];
+		                          return SameThing(a, b) && a.coords == b.coords && a.unknown == b.unknown;
+	                          });
+}
+
+/// Hash of what SameFootpath compares
+uint64_t HashFootpath(const serializer::GameThingReader& reader, uint32_t index)
+{
+	constexpr uint64_t k_FnvOffsetBasis = 0xcbf29ce484222325;
+	constexpr uint64_t k_FnvPrime = 0x100000001b3;
+	auto hash = k_FnvOffsetBasis;
+	const auto combine = [&hash](uint64_t value) { hash = (hash ^ value) * k_FnvPrime; };
+	const auto combineThing = [&combine](const serializer::GameThingReader::Thing& thing) {
+		combine(thing.unknown1);
+		combine(thing.unknown2);
+	};
+
+	const auto& footpath = reader.GetFootpaths()[index];
+	combineThing(footpath);
+	combine(footpath.unknown);
+	const auto nodes = reader.GetFootpathNodes();
+	for (const auto nodeIndex : reader.GetFootpathNodeIndices(footpath))
+	{
+		const auto& node = nodes[nodeIndex];
+		combineThing(node);
+		combine(node.coords.x);
+		combine(node.coords.z);
+		combine(std::hash<float> {}(node.coords.altitude));
+		combine(node.unknown);
+	}
+	return hash;
+}
+} // namespace
+
 FotFile::FotFile(Game& game)
     : _game(game)
 {
@@ -28,55 +85,116 @@ FotFile::FotFile(Game& game)
 
 void FotFile::Load(const std::filesystem::path& path)
 {
-	auto stream = Locator::filesystem::value().Open(path, Stream::Mode::Read);
-	serializer::GameThingSerializer serializer(*stream);
-	auto footpathLinkSaves = serializer.DeserializeList<serializer::GameThingSerializer::FootpathLinkSave>();
-	auto footpaths = serializer.DeserializeList<serializer::GameThingSerializer::Footpath>();
+	const auto data = Locator::filesystem::value().ReadAll(path);
+	serializer::GameThingReader reader;
+	reader.ReadFot(data);
+	const auto footpathList = reader.GetFootpathList();
+	const auto footpaths = reader.GetFootpaths();
+	const auto nodes = reader.GetFootpathNodes();
 	auto& registry = Locator::entitiesRegistry::value();
 	const auto& island = Locator::terrainSystem::value();
 
-	// Keep track of footpath entities in order to associate them to the footpath link saves later
-	std::vector<ecs::components::Footpath::Id> footpathEntities;
+	std::vector<entt::entity> footpathEntities(footpathList.size());
+	registry.Create(footpathEntities.begin(), footpathEntities.end());
 
-	for (const auto& footpath : footpaths)
+	// Sample the land under all nodes at once
+	size_t nodeCount = 0;
+	for (const auto footpathIndex : footpathList)
 	{
-		const auto entity = registry.Create();
-		auto& footpathEntt = registry.Assign<ecs::components::Footpath>(entity);
-		footpathEntt.nodes.reserve(footpath.nodes.size());
-		for (const auto& node : footpath.nodes)
+		nodeCount += footpaths[footpathIndex].nodes.count;
+	}
+	std::vector<glm::vec2> nodePositions;
+	nodePositions.reserve(nodeCount);
+	for (const auto footpathIndex : footpathList)
+	{
+		for (const auto nodeIndex : reader.GetFootpathNodeIndices(footpaths[footpathIndex]))
 		{
-			glm::vec3 position = glm::vec3 {
-			    10.0f * node.coords.x / static_cast<float>(0xFFFF),
-			    node.coords.altitude,
-			    10.0f * node.coords.z / static_cast<float>(0xFFFF),
-			};
+			const auto& coords = nodes[nodeIndex].coords;
+			nodePositions.emplace_back(10.0f * coords.x / static_cast<float>(0xFFFF),
+			                           10.0f * coords.z / static_cast<float>(0xFFFF));
+		}
+	}
+	std::vector<float> nodeHeights(nodeCount);
+	island.GetHeightsAt(nodePositions, nodeHeights);
 
+	// Links refer to the same footpaths as the footpath list, keep track of their entities to associate them later
+	std::vector<entt::entity> entityOfFootpath(footpaths.size(), entt::null);
+
+	size_t positionIndex = 0;
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto footpathIndex : footpathList)
+	{
+		const auto entity = footpathEntities[i];
+		const auto nodeIndices = reader.GetFootpathNodeIndices(footpaths[footpathIndex]);
+		auto& footpathEntt = registry.Assign<ecs::components::Footpath>(entity);
+		footpathEntt.nodes.reserve(nodeIndices.size());
+		for (const auto nodeIndex : nodeIndices)
+		{
+			const auto& position = nodePositions[positionIndex];
 			// This bit is mainly for visualization, it could be that using these offsets causes uses for path planning
 			// if that is the case, this bit should be moved to rendering code
-			position.y += island.GetHeightAt({position.x, position.z});
-
-			footpathEntt.nodes.push_back({position});
+			const auto altitude = nodes[nodeIndex].coords.altitude + nodeHeights[positionIndex];
+			footpathEntt.nodes.push_back({glm::vec3(position.x, altitude, position.y)});
+			++positionIndex;
 		}
-		footpathEntities.push_back(static_cast<ecs::components::Footpath::Id>(entity));
+		entityOfFootpath[footpathIndex] = entity;
+		++i;
 	}
 
-	for (const auto& save : footpathLinkSaves)
+	const auto linkSaveList = reader.GetFootpathLinkSaveList();
+	const auto linkSaves = reader.GetFootpathLinkSaves();
+	const auto links = reader.GetFootpathLinks();
+	std::vector<entt::entity> linkEntities(linkSaveList.size());
+	registry.Create(linkEntities.begin(), linkEntities.end());
+	// Footpaths of the list by their content, only built once a link has a copy of one
+	std::unordered_multimap<uint64_t, uint32_t> footpathListByContent;
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto linkSaveIndex : linkSaveList)
 	{
+		const auto& save = linkSaves[linkSaveIndex];
 		std::vector<ecs::components::Footpath::Id> linkFootpathEntities;
-		for (const auto& footpath : save.link.footpaths)
+		if (save.link != serializer::GameThingReader::k_Null)
 		{
-			// Save links have duplicates to entries in footpaths
-			const auto footpathListItr = std::find(footpaths.cbegin(), footpaths.cend(), footpath);
-			assert(footpathListItr != footpaths.cend());
-			const auto footpathIndex = std::distance(footpaths.cbegin(), footpathListItr);
-			linkFootpathEntities.push_back(footpathEntities[footpathIndex]);
+			const auto footpathIndices = reader.GetLinkFootpathIndices(links[save.link]);
+			linkFootpathEntities.reserve(footpathIndices.size());
+			for (const auto footpathIndex : footpathIndices)
+			{
+				auto entity = entityOfFootpath[footpathIndex];
+				if (entity == entt::null)
+				{
+					// The link has a copy of a footpath of the list rather than a reference to it
+					if (footpathListByContent.empty())
+					{
+						footpathListByContent.reserve(footpathList.size());
+						for (const auto listIndex : footpathList)
+						{
+							footpathListByContent.emplace(HashFootpath(reader, listIndex), listIndex);
+						}
+					}
+					const auto [first, last] = footpathListByContent.equal_range(HashFootpath(reader, footpathIndex));
+					const auto match = std::find_if(first, last, [&reader, footpathIndex](const auto& candidate) {
+						return SameFootpath(reader, candidate.second, footpathIndex);
+					});
+					if (match == last)
+					{
+						SPDLOG_LOGGER_ERROR(spdlog::get("game"), "{}: footpath {} of link {} isn't in the footpath list",
+						                    path.generic_string(), reader.GetFootpaths()[footpathIndex].id,
+						                    links[save.link].id);
+						continue;
+					}
+					entity = entityOfFootpath[match->second];
+					entityOfFootpath[footpathIndex] = entity;
+				}
+				linkFootpathEntities.push_back(static_cast<ecs::components::Footpath::Id>(entity));
+			}
 		}
 		glm::vec3 position = glm::vec3 {
 		    10.0f * save.coords.x / static_cast<float>(0xFFFF),
 		    save.coords.altitude,
 		    10.0f * save.coords.z / static_cast<float>(0xFFFF),
 		};
-		const auto entity = registry.Create();
-		registry.Assign<ecs::components::FootpathLink>(entity, position, std::move(linkFootpathEntities));
+		registry.Assign<ecs::components::FootpathLink>(linkEntities[i], position, std::move(linkFootpathEntities));
+		++i;
 	}
 }
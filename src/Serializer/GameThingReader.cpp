@@ -0,0 +1,216 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include "GameThingReader.h"
+
+#include <cassert>
+#include <cstring>
+
+#include <stdexcept>
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+using namespace openblack::serializer;
+
+void GameThingReader::ReadFot(std::span<const uint8_t> data)
+{
+	Clear();
+	_data = data;
+
+	ReadList(GameThingType::FootpathLinkSave, _footpathLinkSaveList);
+	ReadList(GameThingType::Footpath, _footpathList);
+
+	SPDLOG_LOGGER_DEBUG(spdlog::get("game"), "Read {} things, {} footpaths and {} footpath link saves", _slots.size(),
+	                    _footpathList.size(), _footpathLinkSaveList.size());
+	_data = {};
+}
+
+std::span<const uint32_t> GameThingReader::GetFootpathNodeIndices(const Footpath& footpath) const
+{
+	return std::span<const uint32_t>(_footpathNodeIndices).subspan(footpath.nodes.first, footpath.nodes.count);
+}
+
+std::span<const uint32_t> GameThingReader::GetLinkFootpathIndices(const FootpathLink& link) const
+{
+	return std::span<const uint32_t>(_linkFootpathIndices).subspan(link.footpaths.first, link.footpaths.count);
+}
+
+void GameThingReader::Clear()
+{
+	_position = 0;
+	_checkSum = 0;
+	_slots.clear();
+	_footpathNodes.clear();
+	_footpaths.clear();
+	_footpathLinks.clear();
+	_footpathLinkSaves.clear();
+	_footpathNodeIndices.clear();
+	_linkFootpathIndices.clear();
+	_footpathLinkSaveList.clear();
+	_footpathList.clear();
+}
+
+template <typename T>
+T GameThingReader::ReadValue()
+{
+	if (_data.size() - _position < sizeof(T))
+	{
+		throw std::runtime_error(fmt::format("Unexpected end of data while parsing GameThing at 0x{:08x}", _position));
+	}
+	T result;
+	std::memcpy(&result, _data.data() + _position, sizeof(T));
+	_checkSum += static_cast<uint32_t>(_data[_position]) + sizeof(T);
+	_position += sizeof(T);
+	return result;
+}
+
+void GameThingReader::ReadChecksum()
+{
+	auto expectedSum = _checkSum;
+	auto readSum = ReadValue<uint32_t>();
+	if (expectedSum != readSum)
+	{
+		SPDLOG_LOGGER_ERROR(spdlog::get("game"), "Failed checksum (expected={:08X}, read={:08X}) at {:08X}", expectedSum,
+		                    readSum, _position);
+		assert(false);
+	}
+}
+
+uint32_t GameThingReader::ReadOne(GameThingType type)
+{
+	const auto id = ReadValue<uint32_t>();
+	if (id == 0)
+	{
+		return k_Null;
+	}
+
+	if (id <= _slots.size())
+	{
+		// referring to a previously seen entry
+		const auto& slot = _slots[id - 1];
+		if (slot.type != type)
+		{
+			throw std::runtime_error(fmt::format("Type mismatch referring to GameThing {}: got {} but expected {} at 0x{:08x}",
+			                                     id, static_cast<uint32_t>(slot.type), static_cast<uint32_t>(type),
+			                                     _position - sizeof(id)));
+		}
+		return slot.index;
+	}
+
+	if (id != _slots.size() + 1)
+	{
+		throw std::runtime_error(fmt::format("Unexpected GameThing index {} after {} things at 0x{:08x}", id, _slots.size(),
+		                                     _position - sizeof(id)));
+	}
+
+	const auto readType = ReadValue<GameThingType>();
+	if (readType != type)
+	{
+		throw std::runtime_error(fmt::format("Type mismatch while parsing GameThing: got {} but expected {} at 0x{:08x}",
+		                                     static_cast<uint32_t>(readType), static_cast<uint32_t>(type),
+		                                     _position - sizeof(GameThingType)));
+	}
+	[[maybe_unused]] const auto playerId = ReadValue<uint32_t>();
+	ReadChecksum();
+
+	switch (type)
+	{
+	case GameThingType::Footpath:
+		return ReadFootpath(id);
+	case GameThingType::FootpathLink:
+		return ReadFootpathLink(id);
+	case GameThingType::FootpathNode:
+		return ReadFootpathNode(id);
+	case GameThingType::FootpathLinkSave:
+		return ReadFootpathLinkSave(id);
+	default:
+		throw std::runtime_error(fmt::format("Unsupported GameThing type {}", static_cast<uint32_t>(type)));
+	}
+}
+
+GameThingReader::Range GameThingReader::ReadList(GameThingType type, std::vector<uint32_t>& indices)
+{
+	const auto count = ReadValue<uint32_t>();
+	const auto first = static_cast<uint32_t>(indices.size());
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// Things in the list may themselves contain lists, they are stored in other index arrays so this range stays whole
+		const auto index = ReadOne(type);
+		if (index != k_Null)
+		{
+			indices.push_back(index);
+		}
+	}
+	return {first, static_cast<uint32_t>(indices.size()) - first};
+}
+
+GameThingReader::Thing GameThingReader::ReadThing(uint32_t id)
+{
+	Thing thing {};
+	thing.id = id;
+	thing.unknown1 = ReadValue<uint32_t>();
+	thing.unknown2 = ReadValue<uint8_t>();
+	return thing;
+}
+
+uint32_t GameThingReader::ReadFootpathNode(uint32_t id)
+{
+	const auto index = static_cast<uint32_t>(_footpathNodes.size());
+	_slots.push_back({GameThingType::FootpathNode, index});
+
+	FootpathNode node {};
+	static_cast<Thing&>(node) = ReadThing(id);
+	node.coords = ReadValue<MapCoords>();
+	node.unknown = ReadValue<uint8_t>();
+	_footpathNodes.push_back(node);
+	return index;
+}
+
+uint32_t GameThingReader::ReadFootpath(uint32_t id)
+{
+	const auto index = static_cast<uint32_t>(_footpaths.size());
+	_slots.push_back({GameThingType::Footpath, index});
+	_footpaths.emplace_back();
+
+	// The array may grow while reading the contents, only write to the footpath once done
+	Footpath footpath {};
+	static_cast<Thing&>(footpath) = ReadThing(id);
+	footpath.nodes = ReadList(GameThingType::FootpathNode, _footpathNodeIndices);
+	footpath.unknown = ReadValue<uint32_t>();
+	_footpaths[index] = footpath;
+	return index;
+}
+
+uint32_t GameThingReader::ReadFootpathLink(uint32_t id)
+{
+	const auto index = static_cast<uint32_t>(_footpathLinks.size());
+	_slots.push_back({GameThingType::FootpathLink, index});
+	_footpathLinks.emplace_back();
+
+	FootpathLink link {};
+	static_cast<Thing&>(link) = ReadThing(id);
+	link.footpaths = ReadList(GameThingType::Footpath, _linkFootpathIndices);
+	_footpathLinks[index] = link;
+	return index;
+}
+
+uint32_t GameThingReader::ReadFootpathLinkSave(uint32_t id)
+{
+	const auto index = static_cast<uint32_t>(_footpathLinkSaves.size());
+	_slots.push_back({GameThingType::FootpathLinkSave, index});
+	_footpathLinkSaves.emplace_back();
+
+	FootpathLinkSave save {};
+	static_cast<Thing&>(save) = ReadThing(id);
+	save.coords = ReadValue<MapCoords>();
+	save.link = ReadOne(GameThingType::FootpathLink);
+	_footpathLinkSaves[index] = save;
+	return index;
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "Common.h"
+#include "GameThingSerializer.h"
+
+namespace openblack::serializer
+{
+
+/// Reads GameThings from a contiguous buffer into flat arrays of plain structs, one array per type.
+///
+/// Unlike GameThingSerializer, there is no stream, no virtual dispatch and no allocation per thing. Things containing
+/// other things refer to them by a range of an index array, so things referred to more than once are only stored once.
+/// The arrays keep their capacity between reads, reading file after file stops allocating once they are large enough.
+/// Spans returned by the getters are invalidated by the next read.
+class GameThingReader
+{
+public:
+	static constexpr uint32_t k_Null = std::numeric_limits<uint32_t>::max();
+
+	struct Range
+	{
+		uint32_t first;
+		uint32_t count;
+	};
+
+	struct Thing
+	{
+		/// Index of the thing in the file
+		uint32_t id;
+		uint32_t unknown1;
+		uint8_t unknown2;
+	};
+
+	struct FootpathNode: Thing
+	{
+		MapCoords coords;
+		uint8_t unknown;
+	};
+
+	struct Footpath: Thing
+	{
+		/// See GetFootpathNodeIndices
+		Range nodes;
+		uint32_t unknown;
+	};
+
+	struct FootpathLink: Thing
+	{
+		/// See GetLinkFootpathIndices
+		Range footpaths;
+	};
+
+	struct FootpathLinkSave: Thing
+	{
+		MapCoords coords;
+		/// Index in GetFootpathLinks or k_Null
+		uint32_t link;
+	};
+
+	/// Read a .fot file: a list of footpath link saves followed by a list of footpaths.
+	/// Throws std::runtime_error on truncated or inconsistent data.
+	void ReadFot(std::span<const uint8_t> data);
+
+	[[nodiscard]] std::span<const FootpathNode> GetFootpathNodes() const { return _footpathNodes; }
+	[[nodiscard]] std::span<const Footpath> GetFootpaths() const { return _footpaths; }
+	[[nodiscard]] std::span<const FootpathLink> GetFootpathLinks() const { return _footpathLinks; }
+	[[nodiscard]] std::span<const FootpathLinkSave> GetFootpathLinkSaves() const { return _footpathLinkSaves; }
+
+	/// Indices in GetFootpathNodes of the nodes of footpath
+	[[nodiscard]] std::span<const uint32_t> GetFootpathNodeIndices(const Footpath& footpath) const;
+	/// Indices in GetFootpaths of the footpaths of link
+	[[nodiscard]] std::span<const uint32_t> GetLinkFootpathIndices(const FootpathLink& link) const;
+
+	/// Indices in GetFootpathLinkSaves of the footpath link save list of the .fot file
+	[[nodiscard]] std::span<const uint32_t> GetFootpathLinkSaveList() const { return _footpathLinkSaveList; }
+	/// Indices in GetFootpaths of the footpath list of the .fot file
+	[[nodiscard]] std::span<const uint32_t> GetFootpathList() const { return _footpathList; }
+
+private:
+	struct Slot
+	{
+		GameThingType type;
+		/// Index in the array of the type
+		uint32_t index;
+	};
+
+	void Clear();
+
+	template <typename T>
+	T ReadValue();
+	void ReadChecksum();
+
+	/// Index in the array of the type of the thing or k_Null for empty entries
+	uint32_t ReadOne(GameThingType type);
+	/// Append the indices of the things of the list to indices, empty entries are skipped
+	Range ReadList(GameThingType type, std::vector<uint32_t>& indices);
+
+	Thing ReadThing(uint32_t id);
+	uint32_t ReadFootpathNode(uint32_t id);
+	uint32_t ReadFootpath(uint32_t id);
+	uint32_t ReadFootpathLink(uint32_t id);
+	uint32_t ReadFootpathLinkSave(uint32_t id);
+
+	std::span<const uint8_t> _data;
+	size_t _position {0};
+	uint32_t _checkSum {0};
+
+	std::vector<Slot> _slots;
+	std::vector<FootpathNode> _footpathNodes;
+	std::vector<Footpath> _footpaths;
+	std::vector<FootpathLink> _footpathLinks;
+	std::vector<FootpathLinkSave> _footpathLinkSaves;
+
+	std::vector<uint32_t> _footpathNodeIndices;
+	std::vector<uint32_t> _linkFootpathIndices;
+	std::vector<uint32_t> _footpathLinkSaveList;
+	std::vector<uint32_t> _footpathList;
+};
+} // namespace openblack::serializer
@@ -57,6 +57,9 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		("l,log-file", "Output file for logs, 'stdout'/'logcat' for terminal output.", cxxopts::value<std::string>()->default_value(defaultLogFile))
 		("L,log-level", "Level (trace, debug, info, warning, error, critical, off) of logging per subsystem (" + loggingSubsystems + ").",
 		    cxxopts::value<std::vector<std::string>>()->default_value("all=debug"))
+		("t,threads", "Number of threads running game jobs, including the main thread. 0 for one per hardware thread.", cxxopts::value<uint32_t>()->default_value("0"))
+		("script-cache", "Directory where parsed map scripts are saved to load them faster the next time. Disabled if empty.", cxxopts::value<std::filesystem::path>()->default_value(""))
+		("pack-skins", "Pack the skins of the meshes into texture arrays when they are loaded, if the renderer supports them.")
 		("screenshot-frame", "Request a screenshot of the backbuffer at a certain frame number.", cxxopts::value<uint32_t>())
 		("screenshot-path", "Path of the request a screenshot of the backbuffer.", cxxopts::value<std::filesystem::path>()->default_value("screenshot.png"))
 	;
@@ -183,6 +186,9 @@ bool parseOptions(int argc, char** argv, openblack::Arguments& args, int& return
 		args.logFile = result["log-file"].as<std::string>();
 		args.logLevels = logLevels;
 		args.startLevel = result["start-level"].as<std::string>();
+		args.threadCount = result["threads"].as<uint32_t>();
+		args.scriptCachePath = result["script-cache"].as<std::filesystem::path>();
+		args.packMeshSkins = result["pack-skins"].as<bool>();
 	}
 	catch (cxxopts::exceptions::parsing& err)
 	{
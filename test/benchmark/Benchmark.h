@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <Game.h>
+#include <fmt/format.h>
+
+namespace openblack::benchmark
+{
+
+/// Game on the mock data which only logs errors, nullptr if it failed to initialize
+inline std::unique_ptr<Game> CreateGame(std::string startLevel = "", uint32_t threadCount = 0)
+{
+	static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+	auto args = Arguments {
+	    .graphicsBackend = GraphicsBackend::Noop,
+	    .gamePath = mockGamePath.string(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	    .startLevel = std::move(startLevel),
+	    .threadCount = threadCount,
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::err);
+	auto game = std::make_unique<Game>(std::move(args));
+	if (!game->Initialize())
+	{
+		return nullptr;
+	}
+	return game;
+}
+
+/// Shortest of a few runs of func, the others were slowed down by something else
+template <typename Func>
+std::chrono::nanoseconds Best(uint32_t runs, Func func)
+{
+	auto best = std::chrono::nanoseconds::max();
+	for (uint32_t i = 0; i < runs; ++i)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		func();
+		best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+	}
+	return best;
+}
+
+/// Print how long each of count items took and how many of them are done in a second
+inline void Report(std::string_view name, size_t count, std::string_view items, std::chrono::nanoseconds duration)
+{
+	const auto nanoseconds = static_cast<double>(duration.count());
+	fmt::print("{:<40} {:>10.2f} ns/{} {:>14.0f} {}/s\n", name, nanoseconds / static_cast<double>(count), items,
+	           1e9 * static_cast<double>(count) / nanoseconds, items);
+}
+
+} // namespace openblack::benchmark
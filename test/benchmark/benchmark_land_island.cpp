@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <3D/LandBlock.h>
+#include <3D/LandIslandInterface.h>
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <LNDFile.h>
+#include <Locator.h>
+
+#include "Benchmark.h"
+
+using namespace openblack;
+
+namespace
+{
+constexpr uint32_t k_Runs = 16;
+constexpr size_t k_PositionCount = 1 << 16;
+constexpr size_t k_RayCount = 1 << 14;
+constexpr float k_RayLength = 10000.0f;
+
+/// Heights of the land at positions spread over the whole map, one at a time and in a batch
+void BenchmarkHeights(const LandIslandInterface& island)
+{
+	std::mt19937 generator(0x1234); // NOLINT(cert-msc32-c,cert-msc51-cpp): reproducible on purpose
+	std::uniform_real_distribution<float> distribution(0.0f, 5120.0f);
+	std::vector<glm::vec2> positions(k_PositionCount);
+	for (auto& position : positions)
+	{
+		position = {distribution(generator), distribution(generator)};
+	}
+	std::vector<float> heights(positions.size());
+
+	// How GetHeightAt was done before the height field, the altitude of the nearest cell
+	const auto nearestCell = benchmark::Best(k_Runs, [&island, &positions, &heights]() {
+		// TODO (#749) use std::views::enumerate
+		for (size_t i = 0; const auto& position : positions)
+		{
+			heights[i] = island.GetCell(glm::u16vec2(position * 0.1f)).altitude * LandIslandInterface::k_HeightUnit;
+			++i;
+		}
+	});
+	benchmark::Report("GetCell of the nearest cell", positions.size(), "position", nearestCell);
+
+	const auto single = benchmark::Best(k_Runs, [&island, &positions, &heights]() {
+		// TODO (#749) use std::views::enumerate
+		for (size_t i = 0; const auto& position : positions)
+		{
+			heights[i] = island.GetHeightAt(position);
+			++i;
+		}
+	});
+	benchmark::Report("GetHeightAt", positions.size(), "position", single);
+
+	const auto batched =
+	    benchmark::Best(k_Runs, [&island, &positions, &heights]() { island.GetHeightsAt(positions, heights); });
+	benchmark::Report("GetHeightsAt", positions.size(), "position", batched);
+}
+
+/// Picking rays from high above the map to the ground, on the height field and on the land blocks in a Bullet world
+void BenchmarkRayCasts(LandIslandInterface& island)
+{
+	std::mt19937 generator(0x1234); // NOLINT(cert-msc32-c,cert-msc51-cpp): reproducible on purpose
+	std::uniform_real_distribution<float> distribution(0.0f, 5120.0f);
+	std::vector<std::pair<glm::vec3, glm::vec3>> rays(k_RayCount);
+	for (auto& [origin, direction] : rays)
+	{
+		origin = {distribution(generator), 2000.0f, distribution(generator)};
+		direction = glm::normalize(glm::vec3(distribution(generator), 0.0f, distribution(generator)) - origin);
+	}
+
+	size_t landHits = 0;
+	const auto heightField = benchmark::Best(k_Runs, [&island, &rays, &landHits]() {
+		landHits = 0;
+		for (const auto& [origin, direction] : rays)
+		{
+			landHits += island.RayCast(origin, direction, k_RayLength).has_value() ? 1 : 0;
+		}
+	});
+	benchmark::Report("RayCast on the height field", rays.size(), "ray", heightField);
+
+	// The land blocks in a Bullet world of their own, as they were ray cast before the height field
+	std::vector<std::unique_ptr<btCollisionObject>> objects;
+	btDefaultCollisionConfiguration configuration;
+	btCollisionDispatcher dispatcher(&configuration);
+	btDbvtBroadphase broadphase;
+	btCollisionWorld world(&dispatcher, &broadphase, &configuration);
+	for (auto& block : island.GetBlocks())
+	{
+		const auto& object = objects.emplace_back(std::make_unique<btCollisionObject>());
+		object->setCollisionShape(block.GetRigidBody()->getCollisionShape());
+		object->setWorldTransform(block.GetRigidBody()->getWorldTransform());
+		world.addCollisionObject(object.get());
+	}
+
+	size_t bulletHits = 0;
+	const auto bullet = benchmark::Best(k_Runs, [&world, &rays, &bulletHits]() {
+		bulletHits = 0;
+		for (const auto& [origin, direction] : rays)
+		{
+			const auto from = btVector3(origin.x, origin.y, origin.z);
+			const auto to = from + k_RayLength * btVector3(direction.x, direction.y, direction.z);
+			btCollisionWorld::ClosestRayResultCallback callback(from, to);
+			world.rayTest(from, to, callback);
+			bulletHits += callback.hasHit() ? 1 : 0;
+		}
+	});
+	benchmark::Report("rayTest on the Bullet land blocks", rays.size(), "ray", bullet);
+	fmt::print("{} rays hit the height field and {} the land blocks\n", landHits, bulletHits);
+
+	for (auto& object : objects)
+	{
+		world.removeCollisionObject(object.get());
+	}
+}
+} // namespace
+
+int main()
+{
+	const auto game = benchmark::CreateGame("Land1.txt");
+	if (game == nullptr)
+	{
+		return EXIT_FAILURE;
+	}
+	auto& island = Locator::terrainSystem::value();
+	BenchmarkHeights(island);
+	BenchmarkRayCasts(island);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <LHScriptX/Lexer.h>
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+
+using namespace openblack;
+
+namespace
+{
+constexpr uint32_t k_Runs = 16;
+/// The mock scripts are small, they are lexed this many times per run
+constexpr uint32_t k_PassesPerRun = 256;
+
+size_t CountTokens(std::string_view source)
+{
+	size_t tokens = 0;
+	lhscriptx::Lexer lexer(source);
+	for (auto token = lexer.GetToken(); !token.IsEOF(); token = lexer.GetToken())
+	{
+		++tokens;
+	}
+	return tokens;
+}
+} // namespace
+
+/// Tokens per second of the lexer over the land scripts of the mock data
+int main()
+{
+	const auto scriptsPath = std::filesystem::path(TEST_BINARY_DIR) / "mock" / "Scripts";
+	std::string source;
+	for (const auto& entry : std::filesystem::directory_iterator(scriptsPath))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".txt")
+		{
+			std::ifstream file(entry.path(), std::ios::binary);
+			source.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			source.push_back('\n');
+		}
+	}
+	if (source.empty())
+	{
+		fmt::print("No scripts in {}\n", scriptsPath.generic_string());
+		return EXIT_FAILURE;
+	}
+
+	const auto tokensPerPass = CountTokens(source);
+	size_t tokens = 0;
+	const auto duration = benchmark::Best(k_Runs, [&source, &tokens]() {
+		for (uint32_t i = 0; i < k_PassesPerRun; ++i)
+		{
+			tokens += CountTokens(source);
+		}
+	});
+	fmt::print("{} tokens in {} bytes of scripts\n", tokensPerPass, source.size());
+	benchmark::Report("Lexer", tokensPerPass * k_PassesPerRun, "token", duration);
+	return tokens == tokensPerPass * k_PassesPerRun * k_Runs ? EXIT_SUCCESS : EXIT_FAILURE;
+}
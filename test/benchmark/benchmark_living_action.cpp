@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <array>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include <ECS/Components/LivingAction.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/LivingActionSystemInterface.h>
+#include <Locator.h>
+
+#include "Benchmark.h"
+
+using openblack::ecs::components::LivingAction;
+using openblack::ecs::components::Villager;
+using namespace openblack;
+
+namespace
+{
+constexpr uint32_t k_VillagerCount = 1 << 16;
+constexpr uint32_t k_Runs = 16;
+constexpr size_t k_FunctionsPerState = 9;
+
+uint32_t CountTurn(LivingAction& action, [[maybe_unused]] LivingAction::Index index)
+{
+	++action.turnsSinceStateChange;
+	return action.turnsSinceStateChange;
+}
+
+/// Cost of a call through the state table, with the entries of a table of std::function against function pointers
+template <typename Function>
+void BenchmarkDispatch(std::string_view name)
+{
+	const std::array<Function, k_FunctionsPerState> table {CountTurn, CountTurn, CountTurn, CountTurn, CountTurn,
+	                                                       CountTurn, CountTurn, CountTurn, CountTurn};
+	std::vector<LivingAction> actions(k_VillagerCount, LivingAction(VillagerStates::Created, 0));
+	uint32_t sum = 0;
+	const auto duration = benchmark::Best(k_Runs, [&table, &actions, &sum]() {
+		// TODO (#749) use std::views::enumerate
+		for (size_t i = 0; auto& action : actions)
+		{
+			sum += table[i % table.size()](action, LivingAction::Index::Top);
+			++i;
+		}
+	});
+	benchmark::Report(name, actions.size(), "call", duration);
+	// Keeps the calls from being optimized away
+	if (sum == 0)
+	{
+		std::abort();
+	}
+}
+
+/// Cost of LivingActionSystem::Update for each villager in topState
+void BenchmarkUpdate(std::string_view name, VillagerStates topState)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	std::vector<entt::entity> villagers(k_VillagerCount);
+	registry.Create(villagers.begin(), villagers.end());
+	for (const auto entity : villagers)
+	{
+		registry.Assign<Villager>(entity);
+		// Created villagers wait for as long as the benchmark runs before deciding what to do
+		registry.Assign<LivingAction>(entity, topState, static_cast<uint16_t>(k_Runs));
+	}
+
+	auto& livingActionSystem = Locator::livingActionSystem::value();
+	const auto duration = benchmark::Best(k_Runs, [&livingActionSystem]() { livingActionSystem.Update(); });
+	benchmark::Report(name, villagers.size(), "villager", duration);
+
+	registry.Destroy(villagers.begin(), villagers.end());
+}
+} // namespace
+
+int main()
+{
+	BenchmarkDispatch<std::function<uint32_t(LivingAction&, LivingAction::Index)>>("Dispatch std::function");
+	BenchmarkDispatch<uint32_t (*)(LivingAction&, LivingAction::Index)>("Dispatch function pointer");
+
+	const auto game = benchmark::CreateGame("Land1.txt");
+	if (game == nullptr)
+	{
+		return EXIT_FAILURE;
+	}
+	BenchmarkUpdate("LivingActionSystem::Update Created", VillagerStates::Created);
+	// Every function of the state is counted as unimplemented
+	BenchmarkUpdate("LivingActionSystem::Update MoveToPos", VillagerStates::MoveToPos);
+	return EXIT_SUCCESS;
+}
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <optional>
 
@@ -69,6 +70,14 @@ class MockTerrain final: public openblack::LandIslandInterface
 {
 	[[nodiscard]] float GetHeightAt(glm::vec2) const final { return 0.0f; }
 	[[nodiscard]] glm::vec3 GetNormalAt(glm::vec2) const final { return {0.0f, 1.0f, 0.0f}; }
+	void GetHeightsAt(std::span<const glm::vec2>, std::span<float> heights) const final
+	{
+		std::fill(heights.begin(), heights.end(), 0.0f);
+	}
+	[[nodiscard]] std::optional<RayHit> RayCast(const glm::vec3&, const glm::vec3&, float) const final
+	{
+		return std::nullopt;
+	}
 	[[nodiscard]] const openblack::lnd::LNDCell& GetCell(const glm::u16vec2&) const final { assert(false); }
 	void DumpTextures() const final { assert(false); }
 	void DumpMaps() const final { assert(false); }
@@ -137,6 +146,14 @@ class MockDynamicsSystem: public openblack::ecs::systems::DynamicsSystemInterfac
 		}
 		return {{{{hit->x, terrain.GetHeightAt(*hit), hit->y}}, {}}};
 	}
+	void RayCastClosestHits(std::span<const openblack::Ray> rays,
+	                        std::span<openblack::ecs::systems::RayCastHit> hits) const override
+	{
+		for (size_t i = 0; i < rays.size(); ++i)
+		{
+			hits[i] = RayCastClosestHit(rays[i].origin, rays[i].direction, rays[i].tMax);
+		}
+	}
 
 	[[nodiscard]] std::optional<glm::u16vec2> GetWindowCoordinates(const glm::vec3& position) const
 	{
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <Camera/Frustum.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtx/transform.hpp>
+#include <gtest/gtest.h>
+
+using openblack::AxisAlignedBoundingBox;
+using openblack::Frustum;
+
+class TestFrustum: public ::testing::Test
+{
+protected:
+	// Looking down +z with a 90 degree field of view: visible points have |x| <= z and |y| <= z with z in [1, 100]
+	const Frustum _frustum {glm::perspectiveLH_NO(glm::half_pi<float>(), 1.0f, 1.0f, 100.0f)};
+};
+
+TEST_F(TestFrustum, BoxInside)
+{
+	ASSERT_TRUE(_frustum.Intersects(AxisAlignedBoundingBox {{-1.0f, -1.0f, 10.0f}, {1.0f, 1.0f, 12.0f}}));
+}
+
+TEST_F(TestFrustum, BoxOutside)
+{
+	// Behind
+	ASSERT_FALSE(_frustum.Intersects(AxisAlignedBoundingBox {{-1.0f, -1.0f, -12.0f}, {1.0f, 1.0f, -10.0f}}));
+	// Right
+	ASSERT_FALSE(_frustum.Intersects(AxisAlignedBoundingBox {{50.0f, -1.0f, 10.0f}, {52.0f, 1.0f, 12.0f}}));
+	// Above
+	ASSERT_FALSE(_frustum.Intersects(AxisAlignedBoundingBox {{-1.0f, 50.0f, 10.0f}, {1.0f, 52.0f, 12.0f}}));
+	// Past far plane
+	ASSERT_FALSE(_frustum.Intersects(AxisAlignedBoundingBox {{-1.0f, -1.0f, 200.0f}, {1.0f, 1.0f, 210.0f}}));
+}
+
+TEST_F(TestFrustum, BoxStraddlingPlane)
+{
+	ASSERT_TRUE(_frustum.Intersects(AxisAlignedBoundingBox {{-12.0f, -1.0f, 10.0f}, {-8.0f, 1.0f, 12.0f}}));
+	ASSERT_TRUE(_frustum.Intersects(AxisAlignedBoundingBox {{-1.0f, -1.0f, 90.0f}, {1.0f, 1.0f, 110.0f}}));
+}
+
+TEST_F(TestFrustum, Sphere)
+{
+	ASSERT_TRUE(_frustum.Intersects(glm::vec3(0.0f, 0.0f, 50.0f), 1.0f));
+	ASSERT_FALSE(_frustum.Intersects(glm::vec3(0.0f, 0.0f, -2.0f), 1.0f));
+	ASSERT_TRUE(_frustum.Intersects(glm::vec3(0.0f, 0.0f, -2.0f), 5.0f));
+}
+
+TEST(TestAxisAlignedBoundingBox, Transform)
+{
+	const AxisAlignedBoundingBox box {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+
+	const auto translated = box.Transform(glm::translate(glm::vec3(10.0f, 0.0f, 0.0f)));
+	ASSERT_FLOAT_EQ(translated.minima.x, 9.0f);
+	ASSERT_FLOAT_EQ(translated.maxima.x, 11.0f);
+
+	const auto rotated = box.Transform(glm::rotate(glm::quarter_pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f)));
+	ASSERT_FLOAT_EQ(rotated.maxima.x, glm::root_two<float>());
+	ASSERT_FLOAT_EQ(rotated.maxima.z, glm::root_two<float>());
+	ASSERT_FLOAT_EQ(rotated.maxima.y, 1.0f);
+
+	const auto scaled = box.Transform(glm::scale(glm::vec3(2.0f, 3.0f, 4.0f)));
+	ASSERT_FLOAT_EQ(scaled.minima.y, -3.0f);
+	ASSERT_FLOAT_EQ(scaled.maxima.z, 4.0f);
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include <Common/JobSystem.h>
+#include <ECS/CommandBuffer.h>
+#include <ECS/Registry.h>
+#include <gtest/gtest.h>
+
+struct Counter
+{
+	uint32_t value;
+};
+
+TEST(TestCommandBuffer, AppliedInEntityOrder)
+{
+	openblack::ecs::Registry registry;
+	std::vector<entt::entity> entities(3);
+	registry.Create(entities.begin(), entities.end());
+	std::sort(entities.begin(), entities.end());
+
+	std::vector<int> order;
+	std::vector<openblack::ecs::CommandBuffer> buffers(2);
+	buffers[0].Record(entities[2], [&order](openblack::ecs::Registry&) { order.push_back(2); });
+	buffers[0].Record(entities[0], [&order](openblack::ecs::Registry&) { order.push_back(0); });
+	buffers[1].Record(entities[1], [&order](openblack::ecs::Registry&) { order.push_back(1); });
+	buffers[1].Record(entities[1],
+	                  [entity = entities[1]](openblack::ecs::Registry& target) { target.Assign<Counter>(entity, 7u); });
+	buffers[1].Record(entities[1], [&order](openblack::ecs::Registry&) { order.push_back(3); });
+	buffers[0].Record(entities[1],
+	                  [entity = entities[1]](openblack::ecs::Registry& target) { target.Remove<Counter>(entity); });
+
+	openblack::ecs::CommandBuffer::Apply(buffers, registry);
+
+	ASSERT_EQ(order, (std::vector<int> {0, 1, 3, 2}));
+	ASSERT_TRUE(buffers[0].Empty());
+	ASSERT_TRUE(buffers[1].Empty());
+	// Commands of an entity recorded on several buffers are applied in the order of the buffers
+	ASSERT_TRUE(registry.AllOf<Counter>(entities[1]));
+	ASSERT_EQ(registry.Get<Counter>(entities[1]).value, 7);
+}
+
+TEST(TestCommandBuffer, RecordedFromJobs)
+{
+	openblack::JobSystem jobs(4);
+	openblack::ecs::Registry registry;
+	std::vector<entt::entity> entities(10000);
+	registry.Create(entities.begin(), entities.end());
+
+	std::vector<openblack::ecs::CommandBuffer> buffers(jobs.GetThreadCount());
+	jobs.ParallelFor(entities.size(), [&buffers, &entities](size_t i) {
+		const auto entity = entities[i];
+		buffers.at(openblack::JobSystem::GetThreadIndex()).Record(entity, [entity, i](openblack::ecs::Registry& target) {
+			target.Assign<Counter>(entity, static_cast<uint32_t>(i));
+		});
+	});
+	openblack::ecs::CommandBuffer::Apply(buffers, registry);
+
+	ASSERT_EQ(registry.Size<Counter>(), entities.size());
+	// TODO (#749) use std::views::enumerate
+	for (uint32_t i = 0; const auto entity : entities)
+	{
+		ASSERT_EQ(registry.Get<Counter>(entity).value, i);
+		++i;
+	}
+}
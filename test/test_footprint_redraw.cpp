@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <array>
+#include <optional>
+#include <utility>
+
+#include <Graphics/FootprintRedraw.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtx/transform.hpp>
+#include <gtest/gtest.h>
+
+using openblack::AxisAlignedBoundingBox;
+using namespace openblack::graphics;
+
+namespace
+{
+constexpr float k_IslandSize = 2560.0f;
+constexpr uint16_t k_TileCount = 10;
+constexpr uint16_t k_TilePixels = 32;
+constexpr uint16_t k_FrameBufferSize = k_TileCount * k_TilePixels;
+
+/// Normalized device coordinates of a point on the land
+glm::vec2 ToNdc(const glm::mat4& viewProj, float x, float z)
+{
+	const auto clip = viewProj * glm::vec4(x, 0.0f, z, 1.0f);
+	return glm::vec2(clip) / clip.w;
+}
+
+/// Pixel of a view rect at normalized device coordinates, with the origin at the top left
+glm::vec2 ToPixels(glm::vec2 ndc, glm::vec2 rectPosition, glm::vec2 rectSize)
+{
+	return rectPosition + glm::vec2(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f) * rectSize;
+}
+} // namespace
+
+class TestFootprintRedraw: public ::testing::Test
+{
+protected:
+	/// Same island projection as LandIsland
+	const glm::mat4 _view {glm::rotate(glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f))};
+	const glm::mat4 _proj {glm::ortho(0.0f, k_IslandSize, 0.0f, k_IslandSize)};
+
+	[[nodiscard]] std::optional<FootprintRedraw> Find(glm::vec2 minima, glm::vec2 maxima) const
+	{
+		const auto area = AxisAlignedBoundingBox {{minima.x, 0.0f, minima.y}, {maxima.x, 10.0f, maxima.y}};
+		return GetFootprintRedraw(area, _view, _proj, glm::u16vec2(k_FrameBufferSize), glm::u16vec2(k_TileCount));
+	}
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestFootprintRedraw, outsideIslandIsSkipped)
+{
+	EXPECT_FALSE(Find({-500.0f, 100.0f}, {-400.0f, 200.0f}).has_value());
+	EXPECT_FALSE(Find({100.0f, k_IslandSize + 100.0f}, {200.0f, k_IslandSize + 200.0f}).has_value());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestFootprintRedraw, wholeIsland)
+{
+	const auto redraw = Find({-100.0f, -100.0f}, {k_IslandSize + 100.0f, k_IslandSize + 100.0f});
+	ASSERT_TRUE(redraw.has_value());
+	EXPECT_EQ(redraw->rectPosition, glm::u16vec2(0));
+	EXPECT_EQ(redraw->rectSize, glm::u16vec2(k_FrameBufferSize));
+	EXPECT_EQ(redraw->tileCount, k_TileCount * k_TileCount);
+	for (glm::length_t column = 0; column < 4; ++column)
+	{
+		for (glm::length_t row = 0; row < 4; ++row)
+		{
+			EXPECT_NEAR(redraw->proj[column][row], _proj[column][row], 1e-6f);
+		}
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestFootprintRedraw, partialRedrawKeepsUntouchedTiles)
+{
+	const glm::vec2 size(k_FrameBufferSize);
+	const auto fullViewProj = _proj * _view;
+	// Within a tile, across a tile border and across a corner of four tiles
+	const std::array<std::pair<glm::vec2, glm::vec2>, 3> areas = {{
+	    {{990.0f, 1490.0f}, {1010.0f, 1510.0f}},
+	    {{1010.0f, 1490.0f}, {1040.0f, 1510.0f}},
+	    {{1010.0f, 1010.0f}, {1040.0f, 1040.0f}},
+	}};
+	const std::array<uint32_t, 3> tileCounts = {1, 2, 4};
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; i < areas.size(); ++i)
+	{
+		const auto& [minima, maxima] = areas[i];
+		const auto redraw = Find(minima, maxima);
+		ASSERT_TRUE(redraw.has_value());
+		EXPECT_EQ(redraw->tileCount, tileCounts[i]);
+		EXPECT_EQ(static_cast<uint32_t>(redraw->rectSize.x * redraw->rectSize.y / (k_TilePixels * k_TilePixels)),
+		          tileCounts[i]);
+		EXPECT_EQ(redraw->rectPosition % k_TilePixels, glm::u16vec2(0));
+		EXPECT_EQ(redraw->rectSize % k_TilePixels, glm::u16vec2(0));
+
+		const auto rectPosition = glm::vec2(redraw->rectPosition);
+		const auto rectSize = glm::vec2(redraw->rectSize);
+		const auto viewProj = redraw->proj * _view;
+		for (uint16_t tileX = 0; tileX < k_TileCount; ++tileX)
+		{
+			for (uint16_t tileY = 0; tileY < k_TileCount; ++tileY)
+			{
+				// Land at the center of the tile in the framebuffer
+				const auto center = (glm::vec2(tileX, tileY) + 0.5f) * static_cast<float>(k_TilePixels);
+				const auto x = center.x / size.x * k_IslandSize;
+				const auto z = (1.0f - center.y / size.y) * k_IslandSize;
+				ASSERT_LT(glm::distance(ToPixels(ToNdc(fullViewProj, x, z), {}, size), center), 1e-2f);
+
+				const auto ndc = ToNdc(viewProj, x, z);
+				const bool inRect = glm::all(glm::greaterThanEqual(center, rectPosition)) &&
+				                    glm::all(glm::lessThan(center, rectPosition + rectSize));
+				if (inRect)
+				{
+					// Redrawn tiles are drawn at the same pixels as when drawing the whole framebuffer
+					EXPECT_LT(glm::distance(ToPixels(ndc, rectPosition, rectSize), center), 1e-2f);
+				}
+				else
+				{
+					// The rest is outside of the view, so it is neither cleared nor drawn to
+					EXPECT_GT(glm::max(glm::abs(ndc.x), glm::abs(ndc.y)), 1.0f);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,279 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <ECS/Components/Footpath.h>
+#include <ECS/Registry.h>
+#include <FileSystem/MemoryStream.h>
+#include <Game.h>
+#include <Locator.h>
+#include <Serializer/FotFile.h>
+#include <Serializer/GameThingReader.h>
+#include <Serializer/GameThingSerializer.h>
+#include <gtest/gtest.h>
+
+using openblack::ecs::components::Footpath;
+using openblack::ecs::components::FootpathLink;
+using openblack::serializer::GameThingType;
+using openblack::serializer::MapCoords;
+
+namespace
+{
+constexpr uint32_t k_LinkCount = 1 << 13;
+constexpr uint32_t k_FootpathsPerLink = 2;
+constexpr uint32_t k_FootpathCount = k_LinkCount * k_FootpathsPerLink;
+constexpr uint32_t k_NodesPerFootpath = 4;
+
+/// Writes things the way GameThingSerializer reads them, including the running checksum
+class FotWriter
+{
+public:
+	template <typename T>
+	void Write(const T& value)
+	{
+		const auto offset = _data.size();
+		_data.resize(offset + sizeof(value));
+		std::memcpy(_data.data() + offset, &value, sizeof(value));
+		_checkSum += static_cast<uint32_t>(_data[offset]) + sizeof(value);
+	}
+
+	/// Start a new thing and return its index
+	uint32_t BeginThing(GameThingType type)
+	{
+		const auto index = ++_thingCount;
+		Write(index);
+		Write(type);
+		Write(uint32_t {0}); // player
+		Write(_checkSum);
+		Write(uint32_t {0}); // unknown1
+		Write(uint8_t {0});  // unknown2
+		return index;
+	}
+
+	uint32_t WriteFootpath(uint32_t firstNodeX, uint32_t nodeCount)
+	{
+		const auto index = BeginThing(GameThingType::Footpath);
+		Write(nodeCount);
+		for (uint32_t i = 0; i < nodeCount; ++i)
+		{
+			BeginThing(GameThingType::FootpathNode);
+			Write(MapCoords {firstNodeX + i, i, 1.0f});
+			Write(uint8_t {0});
+		}
+		Write(uint32_t {0}); // unknown
+		return index;
+	}
+
+	[[nodiscard]] const std::vector<uint8_t>& GetData() const { return _data; }
+
+	void Save(const std::filesystem::path& path) const
+	{
+		std::ofstream stream(path, std::ios::binary);
+		stream.write(reinterpret_cast<const char*>(_data.data()), static_cast<std::streamsize>(_data.size()));
+	}
+
+private:
+	std::vector<uint8_t> _data;
+	uint32_t _checkSum {0};
+	uint32_t _thingCount {0};
+};
+
+/// Like in the game's files, the footpaths are defined inside of the links and the footpath list refers to them.
+/// Footpath k of the file starts at x = k * k_NodesPerFootpath, links are made of consecutive footpaths.
+FotWriter WriteSyntheticFot()
+{
+	FotWriter writer;
+	std::vector<uint32_t> footpathIndices;
+	footpathIndices.reserve(k_FootpathCount);
+	writer.Write(k_LinkCount);
+	for (uint32_t i = 0; i < k_LinkCount; ++i)
+	{
+		writer.BeginThing(GameThingType::FootpathLinkSave);
+		writer.Write(MapCoords {i, i, 0.0f});
+		writer.BeginThing(GameThingType::FootpathLink);
+		writer.Write(k_FootpathsPerLink);
+		for (uint32_t j = 0; j < k_FootpathsPerLink; ++j)
+		{
+			const auto footpath = static_cast<uint32_t>(footpathIndices.size());
+			footpathIndices.push_back(writer.WriteFootpath(footpath * k_NodesPerFootpath, k_NodesPerFootpath));
+		}
+	}
+	writer.Write(k_FootpathCount);
+	for (const auto index : footpathIndices)
+	{
+		writer.Write(index);
+	}
+	return writer;
+}
+
+void ExpectSameNodes(const openblack::serializer::GameThingReader& reader, uint32_t footpathIndex,
+                     const openblack::serializer::GameThingSerializer::Footpath& footpath)
+{
+	const auto nodeIndices = reader.GetFootpathNodeIndices(reader.GetFootpaths()[footpathIndex]);
+	ASSERT_EQ(nodeIndices.size(), footpath.nodes.size());
+	for (size_t i = 0; i < nodeIndices.size(); ++i)
+	{
+		EXPECT_EQ(reader.GetFootpathNodes()[nodeIndices[i]].coords, footpath.nodes[i].coords);
+	}
+}
+} // namespace
+
+class FotFileTest: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::info);
+		game_ = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(game_->Initialize());
+	}
+	void TearDown() override { game_.reset(); }
+
+	std::unique_ptr<openblack::Game> game_;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(FotFileTest, loadLargeFile)
+{
+	const auto writer = WriteSyntheticFot();
+	const auto path = std::filesystem::temp_directory_path() / "test_fot_file.fot";
+	writer.Save(path);
+
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	const auto footpathsBefore = registry.Size<Footpath>();
+	const auto linksBefore = registry.Size<FootpathLink>();
+
+	openblack::FotFile(*game_).Load(path);
+	std::filesystem::remove(path);
+
+	ASSERT_EQ(registry.Size<Footpath>() - footpathsBefore, k_FootpathCount);
+	ASSERT_EQ(registry.Size<FootpathLink>() - linksBefore, k_LinkCount);
+
+	registry.Each<const FootpathLink>([&registry](const FootpathLink& link) {
+		ASSERT_EQ(link.footpaths.size(), k_FootpathsPerLink);
+		const auto linkIndex = static_cast<uint32_t>(link.position.z * static_cast<float>(0xFFFF) / 10.0f + 0.5f);
+		for (uint32_t j = 0; const auto id : link.footpaths)
+		{
+			const auto& footpath = registry.Get<const Footpath>(static_cast<entt::entity>(id));
+			ASSERT_EQ(footpath.nodes.size(), k_NodesPerFootpath);
+			const auto firstNodeX = (linkIndex * k_FootpathsPerLink + j) * k_NodesPerFootpath;
+			ASSERT_FLOAT_EQ(footpath.nodes.front().position.x, 10.0f * firstNodeX / static_cast<float>(0xFFFF));
+			++j;
+		}
+	});
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(FotFileTest, linksToCopiedAndMissingFootpaths)
+{
+	// One link whose footpaths aren't referred to by the footpath list: the list has a copy of the first and not the second
+	FotWriter writer;
+	writer.Write(uint32_t {1});
+	writer.BeginThing(GameThingType::FootpathLinkSave);
+	writer.Write(MapCoords {0xFFFF, 0xFFFF, 7.0f});
+	writer.BeginThing(GameThingType::FootpathLink);
+	writer.Write(uint32_t {2});
+	writer.WriteFootpath(0, k_NodesPerFootpath);
+	writer.WriteFootpath(100, k_NodesPerFootpath);
+	writer.Write(uint32_t {1});
+	writer.WriteFootpath(0, k_NodesPerFootpath);
+	const auto path = std::filesystem::temp_directory_path() / "test_fot_file_copies.fot";
+	writer.Save(path);
+
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	const auto footpathsBefore = registry.Size<Footpath>();
+	const auto linksBefore = registry.Size<FootpathLink>();
+
+	openblack::FotFile(*game_).Load(path);
+	std::filesystem::remove(path);
+
+	ASSERT_EQ(registry.Size<Footpath>() - footpathsBefore, 1);
+	ASSERT_EQ(registry.Size<FootpathLink>() - linksBefore, 1);
+	size_t found = 0;
+	registry.Each<const FootpathLink>([&registry, &found](const FootpathLink& link) {
+		if (link.position != glm::vec3(10.0f, 7.0f, 10.0f))
+		{
+			return;
+		}
+		++found;
+		// The copy is matched by content, the missing footpath is skipped
+		ASSERT_EQ(link.footpaths.size(), 1);
+		const auto& footpath = registry.Get<const Footpath>(static_cast<entt::entity>(link.footpaths.front()));
+		ASSERT_EQ(footpath.nodes.size(), k_NodesPerFootpath);
+		EXPECT_FLOAT_EQ(footpath.nodes.front().position.x, 0.0f);
+	});
+	EXPECT_EQ(found, 1);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(FotFileTest, readerMatchesSerializer)
+{
+	using openblack::serializer::GameThingReader;
+	using openblack::serializer::GameThingSerializer;
+
+	const auto writer = WriteSyntheticFot();
+	const auto& data = writer.GetData();
+
+	openblack::filesystem::MemoryStream stream {std::vector<uint8_t>(data)};
+	GameThingSerializer serializer(stream);
+	const auto linkSaves = serializer.DeserializeList<GameThingSerializer::FootpathLinkSave>();
+	const auto footpaths = serializer.DeserializeList<GameThingSerializer::Footpath>();
+
+	GameThingReader reader;
+	reader.ReadFot(data);
+	// Reading again reuses the arrays
+	reader.ReadFot(data);
+
+	ASSERT_EQ(reader.GetFootpathLinkSaveList().size(), linkSaves.size());
+	ASSERT_EQ(reader.GetFootpathList().size(), footpaths.size());
+	// Footpaths are defined in the links, the list refers to them
+	ASSERT_EQ(reader.GetFootpaths().size(), k_FootpathCount);
+	ASSERT_EQ(reader.GetFootpathNodes().size(), k_FootpathCount * k_NodesPerFootpath);
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto index : reader.GetFootpathList())
+	{
+		ExpectSameNodes(reader, index, footpaths[i]);
+		++i;
+	}
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto index : reader.GetFootpathLinkSaveList())
+	{
+		const auto& save = reader.GetFootpathLinkSaves()[index];
+		ASSERT_EQ(save.coords, linkSaves[i].coords);
+		const auto footpathIndices = reader.GetLinkFootpathIndices(reader.GetFootpathLinks()[save.link]);
+		ASSERT_EQ(footpathIndices.size(), linkSaves[i].link.footpaths.size());
+		for (size_t j = 0; j < footpathIndices.size(); ++j)
+		{
+			ExpectSameNodes(reader, footpathIndices[j], linkSaves[i].link.footpaths[j]);
+		}
+		++i;
+	}
+
+	const auto truncated = std::span<const uint8_t>(data).first(data.size() / 2);
+	ASSERT_THROW(reader.ReadFot(truncated), std::runtime_error);
+}
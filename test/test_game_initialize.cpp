@@ -8,6 +8,7 @@
  *******************************************************************************/
 
 #include <Game.h>
+#include <Graphics/UploadBatch.h>
 #include <gtest/gtest.h>
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
@@ -44,3 +45,23 @@ TEST(GameInitialize, run0Frames)
 	ASSERT_TRUE(game->Run());
 	game.reset();
 }
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(GameInitialize, batchedMeshUpload)
+{
+	static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+	auto args = openblack::Arguments {
+	    .graphicsBackend = openblack::GraphicsBackend::Noop,
+	    .gamePath = mockGamePath.string(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	    .startLevel = "Land1.txt",
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::debug);
+	auto game = std::make_unique<openblack::Game>(std::move(args));
+	const auto flushCount = openblack::graphics::UploadBatch::GetFlushCount();
+	ASSERT_TRUE(game->Initialize());
+	// The mock AllMeshes.g3d holds 626 meshes which used to take at least a frame each
+	EXPECT_LT(openblack::graphics::UploadBatch::GetFlushCount() - flushCount, 64u);
+	game.reset();
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <Common/JobSystem.h>
+#include <Common/TaskGraph.h>
+#include <entt/core/hashed_string.hpp>
+#include <gtest/gtest.h>
+
+struct Position
+{
+	float x;
+};
+struct Velocity
+{
+	float x;
+};
+
+TEST(TestJobSystem, ParallelForVisitsEveryIndexOnce)
+{
+	openblack::JobSystem jobs(4);
+	std::vector<std::atomic<uint32_t>> visits(10000);
+	jobs.ParallelFor(visits.size(), [&visits](size_t i) { visits[i].fetch_add(1); });
+	for (const auto& visit : visits)
+	{
+		ASSERT_EQ(visit.load(), 1);
+	}
+}
+
+TEST(TestJobSystem, NestedWait)
+{
+	openblack::JobSystem jobs(2);
+	std::atomic<uint32_t> count {0};
+	jobs.ParallelFor(16, [&jobs, &count](size_t) {
+		jobs.ParallelFor(16, [&count](size_t) { count.fetch_add(1); });
+	});
+	ASSERT_EQ(count.load(), 16 * 16);
+}
+
+TEST(TestJobSystem, SingleThread)
+{
+	openblack::JobSystem jobs(1);
+	ASSERT_EQ(jobs.GetThreadCount(), 1);
+	size_t sum = 0;
+	jobs.ParallelFor(100, [&sum](size_t i) { sum += i; });
+	ASSERT_EQ(sum, 4950);
+}
+
+TEST(TestTaskGraph, Dependencies)
+{
+	using openblack::TaskGraph;
+	TaskGraph graph;
+	std::mutex mutex;
+	std::vector<std::string_view> order;
+	auto record = [&mutex, &order](std::string_view name) {
+		return [&mutex, &order, name]() {
+			const std::lock_guard lock(mutex);
+			order.push_back(name);
+		};
+	};
+	graph.Add("integrate", TaskGraph::ComponentIds<Velocity>(), TaskGraph::ComponentIds<Position>(), record("integrate"));
+	graph.Add("damp", {}, TaskGraph::ComponentIds<Velocity>(), record("damp"));
+	graph.Add("sound", {}, {entt::hashed_string("audio")}, record("sound"));
+	graph.Add("draw", TaskGraph::ComponentIds<Position>(), {}, record("draw"), TaskGraph::Affinity::CallingThread);
+	graph.Add("script", {}, {TaskGraph::k_AllResources}, record("script"));
+
+	ASSERT_EQ(graph.GetDependencyCount(0), 0);
+	ASSERT_EQ(graph.GetDependencyCount(1), 1); // writes what integrate reads
+	ASSERT_EQ(graph.GetDependencyCount(2), 0);
+	ASSERT_EQ(graph.GetDependencyCount(3), 1); // reads what integrate writes
+	ASSERT_EQ(graph.GetDependencyCount(4), 4);
+
+	openblack::JobSystem jobs(4);
+	for (int run = 0; run < 10; ++run)
+	{
+		order.clear();
+		graph.Run(jobs);
+		ASSERT_EQ(order.size(), 5);
+		const auto indexOf = [&order](std::string_view name) { return std::ranges::find(order, name) - order.begin(); };
+		ASSERT_LT(indexOf("integrate"), indexOf("damp"));
+		ASSERT_LT(indexOf("integrate"), indexOf("draw"));
+		ASSERT_EQ(order.back(), "script");
+	}
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cmath>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <3D/LandBlock.h>
+#include <3D/LandIslandInterface.h>
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletDynamics/Dynamics/btRigidBody.h>
+#include <Game.h>
+#include <LNDFile.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+class LandIslandTest: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::debug);
+		game_ = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(game_->Initialize());
+	}
+	void TearDown() override { game_.reset(); }
+
+	/// Random positions spread over the whole map and a bit past its edges
+	static std::vector<glm::vec2> RandomPositions(size_t count)
+	{
+		std::mt19937 generator(0x1234); // NOLINT(cert-msc32-c,cert-msc51-cpp): reproducible on purpose
+		std::uniform_real_distribution<float> distribution(-100.0f, 5220.0f);
+		std::vector<glm::vec2> positions(count);
+		for (auto& position : positions)
+		{
+			position = {distribution(generator), distribution(generator)};
+		}
+		return positions;
+	}
+
+	/// Bilinear interpolation of the cell altitudes around position, with empty cells outside of the map
+	static float ExpectedHeightAt(const openblack::LandIslandInterface& island, glm::vec2 position)
+	{
+		const auto cellHeight = [&island](int x, int z) {
+			if (x < 0 || z < 0 || x >= 512 || z >= 512)
+			{
+				return 0.0f;
+			}
+			const auto cell = glm::u16vec2(static_cast<uint16_t>(x), static_cast<uint16_t>(z));
+			return island.GetCell(cell).altitude * openblack::LandIslandInterface::k_HeightUnit;
+		};
+		const auto coordinates = position / openblack::LandIslandInterface::k_CellSize;
+		const auto x = static_cast<int>(std::floor(coordinates.x));
+		const auto z = static_cast<int>(std::floor(coordinates.y));
+		const auto weightX = coordinates.x - static_cast<float>(x);
+		const auto weightZ = coordinates.y - static_cast<float>(z);
+		const auto back = cellHeight(x, z) * (1.0f - weightX) + cellHeight(x + 1, z) * weightX;
+		const auto forward = cellHeight(x, z + 1) * (1.0f - weightX) + cellHeight(x + 1, z + 1) * weightX;
+		return back * (1.0f - weightZ) + forward * weightZ;
+	}
+
+	std::unique_ptr<openblack::Game> game_;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LandIslandTest, heightAtCellCorners)
+{
+	const auto& island = openblack::Locator::terrainSystem::value();
+	for (uint16_t z = 0; z < 512; z += 7)
+	{
+		for (uint16_t x = 0; x < 512; x += 7)
+		{
+			const auto position = glm::vec2(x, z) * openblack::LandIslandInterface::k_CellSize;
+			const auto expected = island.GetCell({x, z}).altitude * openblack::LandIslandInterface::k_HeightUnit;
+			ASSERT_FLOAT_EQ(island.GetHeightAt(position), expected) << x << ", " << z;
+		}
+	}
+	EXPECT_FLOAT_EQ(island.GetHeightAt({-1000.0f, -1000.0f}), 0.0f);
+	EXPECT_FLOAT_EQ(island.GetHeightAt({6000.0f, 6000.0f}), 0.0f);
+	EXPECT_GT(island.GetNormalAt({-1000.0f, 6000.0f}).y, 0.0f);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LandIslandTest, batchedHeights)
+{
+	const auto& island = openblack::Locator::terrainSystem::value();
+	const auto positions = RandomPositions(1 << 16);
+
+	std::vector<float> heights(positions.size());
+	island.GetHeightsAt(positions, heights);
+	// Within the rounding of the weights, on the steepest slopes
+	constexpr float k_Tolerance = 0.02f;
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		const auto& position = positions[i];
+		ASSERT_NEAR(heights[i], ExpectedHeightAt(island, position), k_Tolerance) << position.x << ", " << position.y;
+		ASSERT_FLOAT_EQ(heights[i], island.GetHeightAt(position)) << position.x << ", " << position.y;
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LandIslandTest, rayCastMatchesBullet)
+{
+	auto& island = openblack::Locator::terrainSystem::value();
+
+	// The land blocks in a Bullet world of their own, as they were ray cast before the height field
+	std::vector<std::unique_ptr<btCollisionObject>> objects;
+	btDefaultCollisionConfiguration configuration;
+	btCollisionDispatcher dispatcher(&configuration);
+	btDbvtBroadphase broadphase;
+	btCollisionWorld world(&dispatcher, &broadphase, &configuration);
+	for (auto& block : island.GetBlocks())
+	{
+		const auto& object = objects.emplace_back(std::make_unique<btCollisionObject>());
+		object->setCollisionShape(block.GetRigidBody()->getCollisionShape());
+		object->setWorldTransform(block.GetRigidBody()->getWorldTransform());
+		world.addCollisionObject(object.get());
+	}
+
+	// Picking rays from high above the map to the ground
+	constexpr float k_RayLength = 10000.0f;
+	std::vector<std::pair<glm::vec3, glm::vec3>> rays(1 << 14);
+	std::mt19937 generator(0x1234); // NOLINT(cert-msc32-c,cert-msc51-cpp): reproducible on purpose
+	std::uniform_real_distribution<float> distribution(0.0f, 5120.0f);
+	for (auto& [origin, direction] : rays)
+	{
+		origin = {distribution(generator), 2000.0f, distribution(generator)};
+		direction = glm::normalize(glm::vec3(distribution(generator), 0.0f, distribution(generator)) - origin);
+	}
+
+	std::vector<std::optional<glm::vec3>> landHits(rays.size());
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		if (const auto hit = island.RayCast(rays[i].first, rays[i].second, k_RayLength))
+		{
+			landHits[i] = hit->position;
+		}
+	}
+
+	std::vector<std::optional<glm::vec3>> bulletHits(rays.size());
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		const auto from = btVector3(rays[i].first.x, rays[i].first.y, rays[i].first.z);
+		const auto to = from + k_RayLength * btVector3(rays[i].second.x, rays[i].second.y, rays[i].second.z);
+		btCollisionWorld::ClosestRayResultCallback callback(from, to);
+		world.rayTest(from, to, callback);
+		if (callback.hasHit())
+		{
+			bulletHits[i] = glm::vec3(callback.m_hitPointWorld.x(), callback.m_hitPointWorld.y(), callback.m_hitPointWorld.z());
+		}
+	}
+
+	for (auto& object : objects)
+	{
+		world.removeCollisionObject(object.get());
+	}
+
+	// Rays grazing the edges of triangles may go either way
+	size_t mismatches = 0;
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		if (landHits[i].has_value() != bulletHits[i].has_value() ||
+		    (landHits[i].has_value() && glm::distance(*landHits[i], *bulletHits[i]) > 0.1f))
+		{
+			++mismatches;
+		}
+	}
+	EXPECT_LE(mismatches, rays.size() / 1000);
+}
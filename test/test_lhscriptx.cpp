@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <LHScriptX/CompiledScript.h>
+#include <LHScriptX/Lexer.h>
+#include <LHScriptX/Script.h>
+#include <gtest/gtest.h>
+
+using openblack::lhscriptx::CompiledScript;
+using openblack::lhscriptx::ParameterType;
+using openblack::lhscriptx::Script;
+
+namespace
+{
+const std::string k_Source = "CREATE_TOWN(1, \"1000.00,2000.00\", \"PLAYER_ONE\", 0, \"NORSE\")\n"
+                             "SET_TOWN_BELIEF(1, \"PLAYER_ONE\", 1.5)\n";
+} // namespace
+
+TEST(TestCompiledScript, Compile)
+{
+	Script script;
+	const auto compiled = script.Compile(k_Source);
+
+	ASSERT_EQ(compiled.GetSourceHash(), CompiledScript::HashSource(k_Source));
+	ASSERT_EQ(compiled.GetCommands().size(), 2);
+	const auto town = compiled.GetArguments(compiled.GetCommands()[0]);
+	ASSERT_EQ(town.size(), 5);
+	ASSERT_EQ(town[0].type, ParameterType::Number);
+	ASSERT_EQ(town[0].number, 1);
+	ASSERT_EQ(town[1].type, ParameterType::Vector);
+	ASSERT_FLOAT_EQ(town[1].x, 1000.0f);
+	ASSERT_FLOAT_EQ(town[1].z, 2000.0f);
+	ASSERT_EQ(compiled.GetString(town[2]), "PLAYER_ONE");
+	ASSERT_EQ(compiled.GetString(town[4]), "NORSE");
+	const auto belief = compiled.GetArguments(compiled.GetCommands()[1]);
+	ASSERT_EQ(belief.size(), 3);
+	ASSERT_EQ(belief[2].type, ParameterType::Float);
+	ASSERT_FLOAT_EQ(belief[2].x, 1.5f);
+
+	ASSERT_THROW(script.Compile("NOT_A_COMMAND(1)\n"), std::runtime_error);
+	ASSERT_THROW(script.Compile("SET_TOWN_BELIEF(1, 2, 3)\n"), std::runtime_error);
+}
+
+TEST(TestCompiledScript, SerializeRoundTrip)
+{
+	Script script;
+	const auto compiled = script.Compile(k_Source);
+	const auto data = compiled.Serialize();
+
+	const auto loaded = CompiledScript::Deserialize(data, compiled.GetSourceHash());
+	ASSERT_TRUE(loaded.has_value());
+	ASSERT_EQ(loaded->GetCommands().size(), compiled.GetCommands().size());
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; const auto& command : loaded->GetCommands())
+	{
+		const auto& expected = compiled.GetCommands()[i];
+		ASSERT_EQ(command.signature, expected.signature);
+		const auto arguments = loaded->GetArguments(command);
+		const auto expectedArguments = compiled.GetArguments(expected);
+		ASSERT_EQ(arguments.size(), expectedArguments.size());
+		for (size_t j = 0; j < arguments.size(); ++j)
+		{
+			ASSERT_EQ(arguments[j].type, expectedArguments[j].type);
+			ASSERT_EQ(arguments[j].number, expectedArguments[j].number);
+			ASSERT_EQ(arguments[j].x, expectedArguments[j].x);
+			ASSERT_EQ(arguments[j].z, expectedArguments[j].z);
+			if (arguments[j].type == ParameterType::String)
+			{
+				ASSERT_EQ(loaded->GetString(arguments[j]), compiled.GetString(expectedArguments[j]));
+			}
+		}
+		++i;
+	}
+
+	ASSERT_FALSE(CompiledScript::Deserialize(data, compiled.GetSourceHash() + 1).has_value());
+	ASSERT_FALSE(CompiledScript::Deserialize(std::span(data).first(data.size() - 1), compiled.GetSourceHash()).has_value());
+}
+
+TEST(TestCompiledScript, VectorArguments)
+{
+	Script script;
+	// Like std::strtof, the coordinates may have leading whitespace and a sign
+	const auto compiled = script.Compile("CREATE_TOWN(1, \" +1000.5,\t-2e3\", \"PLAYER_ONE\", 0, \"NORSE\")\n");
+	const auto town = compiled.GetArguments(compiled.GetCommands()[0]);
+	ASSERT_EQ(town[1].type, ParameterType::Vector);
+	ASSERT_FLOAT_EQ(town[1].x, 1000.5f);
+	ASSERT_FLOAT_EQ(town[1].z, -2000.0f);
+
+	// Anything else is kept as a string, which isn't a valid position
+	ASSERT_THROW(script.Compile("CREATE_TOWN(1, \"1000,\", \"PLAYER_ONE\", 0, \"NORSE\")\n"), std::runtime_error);
+	ASSERT_THROW(script.Compile("CREATE_TOWN(1, \",2000\", \"PLAYER_ONE\", 0, \"NORSE\")\n"), std::runtime_error);
+	ASSERT_THROW(script.Compile("CREATE_TOWN(1, \"1000 ,2000\", \"PLAYER_ONE\", 0, \"NORSE\")\n"), std::runtime_error);
+	ASSERT_THROW(script.Compile("CREATE_TOWN(1, \"1000,2000x\", \"PLAYER_ONE\", 0, \"NORSE\")\n"), std::runtime_error);
+}
+
+TEST(TestLexer, lexesMockScripts)
+{
+	const auto scriptsPath = std::filesystem::path(TEST_BINARY_DIR) / "mock" / "Scripts";
+	std::string source;
+	for (const auto& entry : std::filesystem::directory_iterator(scriptsPath))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".txt")
+		{
+			std::ifstream file(entry.path(), std::ios::binary);
+			source.append(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			source.push_back('\n');
+		}
+	}
+	ASSERT_FALSE(source.empty());
+
+	size_t tokens = 0;
+	openblack::lhscriptx::Lexer lexer(source);
+	for (auto token = lexer.GetToken(); !token.IsEOF(); token = lexer.GetToken())
+	{
+		++tokens;
+	}
+	ASSERT_GT(tokens, 0);
+}
+
+TEST(TestLexer, numbers)
+{
+	openblack::lhscriptx::Lexer lexer("12 -3 1.5 -0.25 12.");
+	ASSERT_EQ(*lexer.GetToken().IntegerValue(), 12);
+	ASSERT_EQ(*lexer.GetToken().IntegerValue(), -3);
+	ASSERT_FLOAT_EQ(*lexer.GetToken().FloatValue(), 1.5f);
+	ASSERT_FLOAT_EQ(*lexer.GetToken().FloatValue(), -0.25f);
+	ASSERT_FLOAT_EQ(*lexer.GetToken().FloatValue(), 12.0f);
+	ASSERT_TRUE(lexer.GetToken().IsEOF());
+
+	openblack::lhscriptx::Lexer invalid("1.2.3");
+	ASSERT_THROW(invalid.GetToken(), openblack::lhscriptx::LexerException);
+}
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ECS/Components/LivingAction.h>
+#include <ECS/Components/Villager.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/LivingActionSystemInterface.h>
+#include <Common/JobSystem.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+using openblack::ecs::components::LivingAction;
+using openblack::ecs::components::Villager;
+
+class LivingActionTest: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = openblack::Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		    .startLevel = "Land1.txt",
+		    // Villagers are updated in parallel
+		    .threadCount = 4,
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::debug);
+		game_ = std::make_unique<openblack::Game>(std::move(args));
+		ASSERT_TRUE(game_->Initialize());
+	}
+	void TearDown() override { game_.reset(); }
+
+	static LivingAction& CreateVillager(openblack::VillagerStates topState, uint16_t turnsUntilStateChange)
+	{
+		auto& registry = openblack::Locator::entitiesRegistry::value();
+		const auto entity = registry.Create();
+		return registry.Assign<LivingAction>(entity, topState, turnsUntilStateChange);
+	}
+
+	std::unique_ptr<openblack::Game> game_;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTest, unimplementedStatesReturnDefaults)
+{
+	const auto& livingActionSystem = openblack::Locator::livingActionSystem::value();
+	// The invalid state asserts
+	for (auto i = 1u; i < static_cast<uint32_t>(openblack::VillagerStates::_COUNT); ++i)
+	{
+		const auto state = static_cast<openblack::VillagerStates>(i);
+		if (state == openblack::VillagerStates::Created)
+		{
+			continue;
+		}
+		auto& action = CreateVillager(state, 1);
+		EXPECT_FALSE(livingActionSystem.VillagerCallValidate(action, LivingAction::Index::Top)) << i;
+		EXPECT_EQ(livingActionSystem.VillagerCallState(action, LivingAction::Index::Top), 0) << i;
+		EXPECT_FALSE(livingActionSystem.VillagerCallExitState(action, LivingAction::Index::Top)) << i;
+		EXPECT_EQ(livingActionSystem.VillagerGetState(action, LivingAction::Index::Top), state) << i;
+		EXPECT_EQ(action.turnsUntilStateChange, 1) << i;
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTest, createdDecidesWhatToDo)
+{
+	const auto& livingActionSystem = openblack::Locator::livingActionSystem::value();
+	auto& action = CreateVillager(openblack::VillagerStates::Created, 2);
+	EXPECT_FALSE(livingActionSystem.VillagerCallValidate(action, LivingAction::Index::Top));
+
+	EXPECT_EQ(livingActionSystem.VillagerCallState(action, LivingAction::Index::Top), 0);
+	EXPECT_EQ(action.turnsUntilStateChange, 1);
+	EXPECT_EQ(livingActionSystem.VillagerGetState(action, LivingAction::Index::Top), openblack::VillagerStates::Created);
+
+	livingActionSystem.VillagerCallState(action, LivingAction::Index::Top);
+	livingActionSystem.VillagerCallState(action, LivingAction::Index::Top);
+	EXPECT_EQ(action.turnsUntilStateChange, 0);
+	EXPECT_EQ(livingActionSystem.VillagerGetState(action, LivingAction::Index::Top),
+	          openblack::VillagerStates::DecideWhatToDo);
+	EXPECT_EQ(action.turnsSinceStateChange, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTest, dispatchesOnStateAtIndex)
+{
+	const auto& livingActionSystem = openblack::Locator::livingActionSystem::value();
+	auto& action = CreateVillager(openblack::VillagerStates::DecideWhatToDo, 1);
+	constexpr auto k_Final = static_cast<size_t>(LivingAction::Index::Final);
+	action.states.at(k_Final) = static_cast<uint8_t>(openblack::VillagerStates::Created);
+
+	livingActionSystem.VillagerCallState(action, LivingAction::Index::Top);
+	EXPECT_EQ(action.turnsUntilStateChange, 1);
+	livingActionSystem.VillagerCallState(action, LivingAction::Index::Final);
+	EXPECT_EQ(action.turnsUntilStateChange, 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTest, unimplementedLogsStateAtIndex)
+{
+	const auto& livingActionSystem = openblack::Locator::livingActionSystem::value();
+	const auto logger = spdlog::get("ai");
+	ASSERT_NE(logger, nullptr);
+	std::ostringstream log;
+	const auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(log);
+	sink->set_pattern("%v");
+	logger->sinks().push_back(sink);
+
+	auto& action = CreateVillager(openblack::VillagerStates::DecideWhatToDo, 0);
+	constexpr auto k_Final = static_cast<size_t>(LivingAction::Index::Final);
+	action.states.at(k_Final) = static_cast<uint8_t>(openblack::VillagerStates::Flying);
+	// Counts start over with the game, so this is the first call and it is logged
+	EXPECT_EQ(livingActionSystem.VillagerCallOutOfAnimation(action, LivingAction::Index::Final), -1);
+	logger->sinks().pop_back();
+
+	const auto message = log.str();
+	EXPECT_NE(message.find("transition animation function: Final FLYING (called 1 times)"), std::string::npos) << message;
+	EXPECT_EQ(message.find("DECIDE_WHAT_TO_DO"), std::string::npos) << message;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(LivingActionTest, updatesVillagersInParallel)
+{
+	auto& registry = openblack::Locator::entitiesRegistry::value();
+	auto& livingActionSystem = openblack::Locator::livingActionSystem::value();
+	ASSERT_GT(openblack::Locator::jobSystem::value().GetThreadCount(), 1);
+
+	constexpr uint16_t k_Turns = 3;
+	std::vector<entt::entity> villagers(1 << 12);
+	registry.Create(villagers.begin(), villagers.end());
+	// TODO (#749) use std::views::enumerate
+	for (uint16_t i = 0; const auto entity : villagers)
+	{
+		registry.Assign<Villager>(entity);
+		registry.Assign<LivingAction>(entity, openblack::VillagerStates::Created, static_cast<uint16_t>(i % (k_Turns + 1)));
+		++i;
+	}
+
+	for (uint16_t turn = 0; turn < k_Turns; ++turn)
+	{
+		livingActionSystem.Update();
+	}
+
+	// Created villagers count down, then decide what to do on the turn after they reach 0
+	// TODO (#749) use std::views::enumerate
+	for (uint16_t i = 0; const auto entity : villagers)
+	{
+		const auto& action = registry.Get<const LivingAction>(entity);
+		const auto turnsUntilStateChange = static_cast<uint16_t>(i % (k_Turns + 1));
+		if (turnsUntilStateChange < k_Turns)
+		{
+			ASSERT_EQ(livingActionSystem.VillagerGetState(action, LivingAction::Index::Top),
+			          openblack::VillagerStates::DecideWhatToDo)
+			    << i;
+			ASSERT_EQ(action.turnsSinceStateChange, k_Turns - 1 - turnsUntilStateChange) << i;
+		}
+		else
+		{
+			ASSERT_EQ(livingActionSystem.VillagerGetState(action, LivingAction::Index::Top), openblack::VillagerStates::Created)
+			    << i;
+			ASSERT_EQ(action.turnsUntilStateChange, 0) << i;
+			ASSERT_EQ(action.turnsSinceStateChange, k_Turns) << i;
+		}
+		++i;
+	}
+}
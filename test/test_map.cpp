@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Mobile.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Map.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+using namespace openblack::ecs;
+using namespace openblack;
+
+namespace
+{
+constexpr uint32_t k_MobileCount = 1 << 12;
+constexpr float k_WorldSize = 5110.0f;
+
+using Cells = std::set<std::pair<uint32_t, entt::entity>>;
+
+/// Every (cell, entity) pair of both grids
+std::pair<Cells, Cells> Gather()
+{
+	const auto& map = Locator::entitiesMap::value();
+	std::pair<Cells, Cells> result;
+	for (uint16_t y = 0; y < MapInterface::k_GridSize.y; ++y)
+	{
+		for (uint16_t x = 0; x < MapInterface::k_GridSize.x; ++x)
+		{
+			const auto cellIndex = static_cast<uint32_t>(x + y * MapInterface::k_GridSize.x);
+			for (const auto entity : map.GetFixedInGridCell(MapInterface::CellId(x, y)))
+			{
+				EXPECT_TRUE(result.first.emplace(cellIndex, entity).second);
+			}
+			for (const auto entity : map.GetMobileInGridCell(MapInterface::CellId(x, y)))
+			{
+				EXPECT_TRUE(result.second.emplace(cellIndex, entity).second);
+			}
+		}
+	}
+	return result;
+}
+
+glm::vec3 RandomPosition(std::mt19937& generator)
+{
+	std::uniform_real_distribution<float> distribution(0.0f, k_WorldSize);
+	return {distribution(generator), 0.0f, distribution(generator)};
+}
+
+entt::entity CreateMobile(const glm::vec3& position)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto entity = registry.Create();
+	registry.Assign<Transform>(entity, position, glm::mat3(1.0f), glm::vec3(1.0f));
+	registry.Assign<Mobile>(entity);
+	return entity;
+}
+
+/// Update the map incrementally then check that a full rebuild gives the same grids
+void ExpectUpdateMatchesRebuild()
+{
+	auto& map = Locator::entitiesMap::value();
+	map.Update();
+	const auto incremental = Gather();
+	map.Rebuild();
+	const auto rebuilt = Gather();
+	EXPECT_EQ(incremental.first, rebuilt.first);
+	EXPECT_EQ(incremental.second, rebuilt.second);
+}
+} // namespace
+
+class TestMap: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		std::mt19937 generator(0x5eed);
+		_mobiles.reserve(k_MobileCount);
+		for (uint32_t i = 0; i < k_MobileCount; ++i)
+		{
+			_mobiles.push_back(CreateMobile(RandomPosition(generator)));
+		}
+		// Corners of the grid
+		_mobiles.push_back(CreateMobile({0.0f, 0.0f, 0.0f}));
+		_mobiles.push_back(CreateMobile({k_WorldSize, 0.0f, k_WorldSize}));
+		Locator::entitiesMap::value().Update();
+	}
+	void TearDown() override { _game.reset(); }
+	std::unique_ptr<Game> _game;
+	std::vector<entt::entity> _mobiles;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMap, mobilesLinkedOnConstruct)
+{
+	const auto mobile = Gather().second;
+	ASSERT_EQ(mobile.size(), _mobiles.size());
+	const auto& registry = Locator::entitiesRegistry::value();
+	for (const auto entity : _mobiles)
+	{
+		const auto cellId = MapInterface::GetGridCell(registry.Get<const Transform>(entity).position);
+		EXPECT_TRUE(mobile.contains({cellId.x + cellId.y * MapInterface::k_GridSize.x, entity}));
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMap, updateMatchesRebuildAfterMoves)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	std::mt19937 generator(0xc0ffee);
+	for (uint32_t turn = 0; turn < 4; ++turn)
+	{
+		// Some move far, some stay within their cell and some don't move at all
+		for (size_t i = turn % 3; i < _mobiles.size(); i += 3)
+		{
+			auto& transform = registry.Get<Transform>(_mobiles[i]);
+			transform.position = (i % 2 == 0) ? RandomPosition(generator) : transform.position + glm::vec3(0.01f, 0.0f, 0.0f);
+			registry.SetDirty(_mobiles[i]);
+		}
+		ExpectUpdateMatchesRebuild();
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMap, updateMatchesRebuildAfterInsertionsAndRemovals)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	std::mt19937 generator(0xbeef);
+
+	TownArchetype::Create(0, glm::vec3(2185.72f, 0.0f, 2315.78f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+	std::vector<entt::entity> abodes;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		// Keep the bounding circle of the abodes within the grid
+		const auto position = glm::vec3(100.0f) + RandomPosition(generator) * 0.9f;
+		abodes.push_back(AbodeArchetype::Create(0, position, AbodeInfo::CelticTempleY, 0.0f, 1.0f, 0, 0));
+	}
+	for (uint32_t i = 0; i < 256; ++i)
+	{
+		_mobiles.push_back(CreateMobile(RandomPosition(generator)));
+	}
+
+	// Moved then destroyed, moved then no longer mobile, and destroyed fixed entities
+	for (size_t i = 0; i < 64; ++i)
+	{
+		registry.Get<Transform>(_mobiles[i]).position = RandomPosition(generator);
+		registry.SetDirty(_mobiles[i]);
+	}
+	for (size_t i = 0; i < 32; ++i)
+	{
+		registry.Destroy(_mobiles[i]);
+	}
+	for (size_t i = 32; i < 48; ++i)
+	{
+		registry.Remove<Mobile>(_mobiles[i]);
+	}
+	for (size_t i = 0; i < abodes.size(); i += 2)
+	{
+		registry.Destroy(abodes[i]);
+	}
+	// A recycled identifier must not be mistaken for the destroyed entity
+	for (uint32_t i = 0; i < 32; ++i)
+	{
+		CreateMobile(RandomPosition(generator));
+	}
+	ExpectUpdateMatchesRebuild();
+
+	EXPECT_EQ(Gather().second.size(), _mobiles.size() - 48 + 32);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMap, fixedFollowsItsTransform)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto isLinkedAt = [](entt::entity entity, const glm::vec2& position) {
+		const auto cellId = MapInterface::GetGridCell(position);
+		return Gather().first.contains({cellId.x + cellId.y * MapInterface::k_GridSize.x, entity});
+	};
+
+	// Linked once it has a transform, even if it is assigned after the Fixed component
+	const auto entity = registry.Create();
+	registry.Assign<Fixed>(entity, glm::vec2(1000.0f, 1000.0f), 10.0f);
+	EXPECT_FALSE(isLinkedAt(entity, {1000.0f, 1000.0f}));
+	registry.Assign<Transform>(entity, glm::vec3(1000.0f, 0.0f, 1000.0f), glm::mat3(1.0f), glm::vec3(1.0f));
+	EXPECT_TRUE(isLinkedAt(entity, {1000.0f, 1000.0f}));
+
+	// Moved by its transform, the bounding circle follows
+	registry.Get<Transform>(entity).position = glm::vec3(2000.0f, 0.0f, 1500.0f);
+	registry.SetDirty(entity);
+	ExpectUpdateMatchesRebuild();
+	EXPECT_EQ(registry.Get<const Fixed>(entity).boundingCenter, glm::vec2(2000.0f, 1500.0f));
+	EXPECT_TRUE(isLinkedAt(entity, {2000.0f, 1500.0f}));
+	EXPECT_FALSE(isLinkedAt(entity, {1000.0f, 1000.0f}));
+
+	// Replacing the transform relinks it too
+	registry.AssignOrReplace<Transform>(entity, glm::vec3(3000.0f, 0.0f, 3000.0f), glm::mat3(1.0f), glm::vec3(1.0f));
+	ExpectUpdateMatchesRebuild();
+	EXPECT_TRUE(isLinkedAt(entity, {3000.0f, 3000.0f}));
+
+	// Unlinked with its transform
+	registry.Remove<Transform>(entity);
+	EXPECT_FALSE(isLinkedAt(entity, {3000.0f, 3000.0f}));
+}
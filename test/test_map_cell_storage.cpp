@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <ECS/MapCellStorage.h>
+#include <entt/entity/entity.hpp>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs;
+
+namespace
+{
+constexpr size_t k_CellCount = 16;
+
+std::vector<entt::entity> Sorted(std::span<const entt::entity> entities)
+{
+	std::vector<entt::entity> result(entities.begin(), entities.end());
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+std::vector<entt::entity> Range(uint32_t first, uint32_t last)
+{
+	std::vector<entt::entity> result;
+	for (auto i = first; i < last; ++i)
+	{
+		result.push_back(static_cast<entt::entity>(i));
+	}
+	return result;
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMapCellStorage, emptyCells)
+{
+	const MapCellStorage storage(k_CellCount);
+	for (size_t i = 0; i < k_CellCount; ++i)
+	{
+		EXPECT_TRUE(storage.Get(i).empty());
+	}
+	EXPECT_THROW(static_cast<void>(storage.Get(k_CellCount)), std::out_of_range);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMapCellStorage, insertAndIterate)
+{
+	MapCellStorage storage(k_CellCount);
+	// Enough entities for the slices to grow and move several times while interleaved with other cells
+	for (uint32_t i = 0; i < 100; ++i)
+	{
+		storage.Insert(3, static_cast<entt::entity>(i));
+		storage.Insert(4, static_cast<entt::entity>(1000 + i));
+	}
+	storage.Insert(3, static_cast<entt::entity>(7));
+	EXPECT_EQ(Sorted(storage.Get(3)), Range(0, 100));
+	EXPECT_EQ(Sorted(storage.Get(4)), Range(1000, 1100));
+	EXPECT_TRUE(storage.Get(2).empty());
+	EXPECT_TRUE(storage.Get(5).empty());
+
+	// Moved slices left unused space behind
+	storage.Compact();
+	EXPECT_EQ(Sorted(storage.Get(3)), Range(0, 100));
+	EXPECT_EQ(Sorted(storage.Get(4)), Range(1000, 1100));
+	EXPECT_TRUE(storage.Get(2).empty());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMapCellStorage, erase)
+{
+	MapCellStorage storage(k_CellCount);
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		storage.Insert(5, static_cast<entt::entity>(i));
+		storage.Insert(6, static_cast<entt::entity>(i));
+	}
+
+	EXPECT_TRUE(storage.Erase(5, static_cast<entt::entity>(0)));
+	EXPECT_TRUE(storage.Erase(5, static_cast<entt::entity>(9)));
+	EXPECT_TRUE(storage.Erase(5, static_cast<entt::entity>(4)));
+	EXPECT_FALSE(storage.Erase(5, static_cast<entt::entity>(4)));
+	EXPECT_FALSE(storage.Erase(5, static_cast<entt::entity>(42)));
+	EXPECT_FALSE(storage.Erase(7, static_cast<entt::entity>(1)));
+
+	auto expected = Range(1, 9);
+	expected.erase(std::find(expected.begin(), expected.end(), static_cast<entt::entity>(4)));
+	EXPECT_EQ(Sorted(storage.Get(5)), expected);
+	EXPECT_EQ(Sorted(storage.Get(6)), Range(0, 10));
+
+	// Erased entities can be inserted again
+	storage.Insert(5, static_cast<entt::entity>(4));
+	EXPECT_EQ(storage.Get(5).size(), expected.size() + 1);
+	for (uint32_t i = 0; i < 10; ++i)
+	{
+		storage.Erase(5, static_cast<entt::entity>(i));
+	}
+	EXPECT_TRUE(storage.Get(5).empty());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMapCellStorage, borderCells)
+{
+	MapCellStorage storage(k_CellCount);
+	const auto first = static_cast<entt::entity>(1);
+	const auto last = static_cast<entt::entity>(2);
+	storage.Insert(0, first);
+	storage.Insert(k_CellCount - 1, last);
+	ASSERT_EQ(storage.Get(0).size(), 1);
+	ASSERT_EQ(storage.Get(k_CellCount - 1).size(), 1);
+	EXPECT_EQ(storage.Get(0).front(), first);
+	EXPECT_EQ(storage.Get(k_CellCount - 1).front(), last);
+	EXPECT_THROW(storage.Insert(k_CellCount, first), std::out_of_range);
+
+	storage.Compact();
+	EXPECT_EQ(storage.Get(0).front(), first);
+	EXPECT_EQ(storage.Get(k_CellCount - 1).front(), last);
+	EXPECT_TRUE(storage.Erase(k_CellCount - 1, last));
+	EXPECT_TRUE(storage.Get(k_CellCount - 1).empty());
+	EXPECT_EQ(storage.Get(0).front(), first);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMapCellStorage, compactAndClear)
+{
+	MapCellStorage storage(k_CellCount);
+	for (uint32_t i = 0; i < 64; ++i)
+	{
+		storage.Insert(i % k_CellCount, static_cast<entt::entity>(i));
+	}
+	for (uint32_t i = 0; i < 64; i += 2)
+	{
+		storage.Erase(i % k_CellCount, static_cast<entt::entity>(i));
+	}
+	const auto before = storage.GetMemoryUsage();
+	storage.Compact();
+	for (uint32_t cell = 0; cell < k_CellCount; ++cell)
+	{
+		std::vector<entt::entity> expected;
+		for (uint32_t i = cell; i < 64; i += k_CellCount)
+		{
+			if (i % 2 == 1)
+			{
+				expected.push_back(static_cast<entt::entity>(i));
+			}
+		}
+		EXPECT_EQ(Sorted(storage.Get(cell)), expected);
+	}
+	EXPECT_LE(storage.GetMemoryUsage(), before);
+
+	storage.Clear();
+	for (size_t i = 0; i < k_CellCount; ++i)
+	{
+		EXPECT_TRUE(storage.Get(i).empty());
+	}
+	storage.Insert(1, static_cast<entt::entity>(3));
+	EXPECT_EQ(storage.Get(1).size(), 1);
+}
@@ -0,0 +1,304 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <MappedPackFile.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::pack;
+
+namespace
+{
+constexpr uint32_t k_TextureId = 0x2a;
+constexpr uint32_t k_TextureSize = 64;
+
+/// Builds the bytes of a pack file block by block
+class PackWriter
+{
+public:
+	PackWriter() { _data.insert(_data.end(), k_Magic.begin(), k_Magic.end()); }
+
+	PackWriter& Block(const std::string& name, std::span<const uint8_t> data)
+	{
+		std::array<char, 0x20> blockName {};
+		std::copy_n(name.begin(), std::min(name.size(), blockName.size() - 1), blockName.begin());
+		_data.insert(_data.end(), blockName.begin(), blockName.end());
+		Append(_data, static_cast<uint32_t>(data.size()));
+		_data.insert(_data.end(), data.begin(), data.end());
+		return *this;
+	}
+
+	template <typename T>
+	static void Append(std::vector<uint8_t>& data, const T& value)
+	{
+		const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+		data.insert(data.end(), bytes, bytes + sizeof(T));
+	}
+
+	[[nodiscard]] const std::vector<uint8_t>& GetData() const { return _data; }
+
+private:
+	static constexpr std::array<char, 8> k_Magic = {'L', 'i', 'O', 'n', 'H', 'e', 'A', 'd'};
+
+	std::vector<uint8_t> _data;
+};
+
+std::vector<uint8_t> Bytes(uint8_t first, size_t count)
+{
+	std::vector<uint8_t> result(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		result[i] = static_cast<uint8_t>(first + i);
+	}
+	return result;
+}
+
+const std::vector<std::vector<uint8_t>> k_Meshes = {Bytes(1, 10), Bytes(50, 3), Bytes(100, 17)};
+const std::vector<std::vector<uint8_t>> k_Samples = {Bytes(7, 12), Bytes(200, 5)};
+
+std::vector<uint8_t> MeshesBlock(uint32_t meshCount)
+{
+	std::vector<uint8_t> block = {'M', 'K', 'J', 'C'};
+	PackWriter::Append(block, meshCount);
+	auto offset = static_cast<uint32_t>(block.size() + k_Meshes.size() * sizeof(uint32_t));
+	for (const auto& mesh : k_Meshes)
+	{
+		PackWriter::Append(block, offset);
+		offset += static_cast<uint32_t>(mesh.size());
+	}
+	for (const auto& mesh : k_Meshes)
+	{
+		block.insert(block.end(), mesh.begin(), mesh.end());
+	}
+	return block;
+}
+
+std::vector<uint8_t> InfoBlock(uint32_t textureId)
+{
+	std::vector<uint8_t> block;
+	PackWriter::Append(block, uint32_t {1});
+	PackWriter::Append(block, InfoBlockLookup {textureId, 0});
+	return block;
+}
+
+std::vector<uint8_t> TextureBlock(uint32_t textureId)
+{
+	std::vector<uint8_t> block;
+	PackWriter::Append(block, G3DTextureHeader {0, textureId, 0, 0});
+	DdsHeader header {};
+	header.size = sizeof(DdsHeader);
+	header.width = 8;
+	header.height = 8;
+	header.pitchOrLinearSize = k_TextureSize;
+	header.format.size = sizeof(DdsPixelFormat);
+	header.format.fourCC = {'D', 'X', 'T', '5'};
+	PackWriter::Append(block, header);
+	const auto texels = Bytes(3, k_TextureSize);
+	block.insert(block.end(), texels.begin(), texels.end());
+	return block;
+}
+
+std::vector<uint8_t> SampleTableBlock(uint32_t lastSampleOffset)
+{
+	std::vector<uint8_t> block;
+	PackWriter::Append(block, static_cast<uint32_t>(k_Samples.size()));
+	uint32_t offset = 0;
+	for (size_t i = 0; i < k_Samples.size(); ++i)
+	{
+		AudioBankSampleHeader header {};
+		header.id = static_cast<int32_t>(i + 1);
+		header.offset = i == k_Samples.size() - 1 ? lastSampleOffset : offset;
+		header.size = static_cast<uint32_t>(k_Samples[i].size());
+		PackWriter::Append(block, header);
+		offset += header.size;
+	}
+	return block;
+}
+
+std::vector<uint8_t> WaveDataBlock()
+{
+	std::vector<uint8_t> block;
+	for (const auto& sample : k_Samples)
+	{
+		block.insert(block.end(), sample.begin(), sample.end());
+	}
+	return block;
+}
+
+/// A pack with meshes, a texture and audio samples
+std::vector<uint8_t> ValidPack()
+{
+	PackWriter writer;
+	writer.Block("MESHES", MeshesBlock(static_cast<uint32_t>(k_Meshes.size())))
+	    .Block("INFO", InfoBlock(k_TextureId))
+	    .Block("2a", TextureBlock(k_TextureId))
+	    .Block("LHAudioBankSampleTable", SampleTableBlock(static_cast<uint32_t>(k_Samples[0].size())))
+	    .Block("LHAudioWaveData", WaveDataBlock());
+	return writer.GetData();
+}
+
+void ExpectContent(const MappedPackFile& pack)
+{
+	EXPECT_TRUE(pack.HasBlock("MESHES"));
+	EXPECT_FALSE(pack.HasBlock("BODY"));
+
+	const auto& meshes = pack.GetMeshes();
+	ASSERT_EQ(meshes.size(), k_Meshes.size());
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		EXPECT_TRUE(std::ranges::equal(meshes[i], k_Meshes[i]));
+	}
+
+	const auto& textures = pack.GetTextures();
+	ASSERT_EQ(textures.size(), 1);
+	const auto& texture = textures.at("2a");
+	EXPECT_EQ(texture.header.id, k_TextureId);
+	EXPECT_EQ(texture.ddsHeader.width, 8);
+	EXPECT_TRUE(std::ranges::equal(texture.ddsData, Bytes(3, k_TextureSize)));
+
+	const auto& headers = pack.GetAudioSampleHeaders();
+	const auto& samples = pack.GetAudioSamplesData();
+	ASSERT_EQ(headers.size(), k_Samples.size());
+	ASSERT_EQ(samples.size(), k_Samples.size());
+	for (size_t i = 0; i < samples.size(); ++i)
+	{
+		EXPECT_EQ(headers[i].id, static_cast<int32_t>(i + 1));
+		EXPECT_TRUE(std::ranges::equal(samples[i], k_Samples[i]));
+	}
+}
+
+PackResult OpenBuffer(MappedPackFile& pack, std::vector<uint8_t> data)
+{
+	return pack.Open(std::move(data));
+}
+} // namespace
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMappedPackFile, openFile)
+{
+	const auto path = std::filesystem::temp_directory_path() / "test_mapped_pack_file.g3d";
+	{
+		const auto data = ValidPack();
+		std::ofstream stream(path, std::ios::binary);
+		stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	}
+
+	{
+		MappedPackFile pack;
+		ASSERT_EQ(pack.Open(path), PackResult::Success);
+		ASSERT_EQ(pack.ResolveMeshes(), PackResult::Success);
+		ASSERT_EQ(pack.ResolveTextures(), PackResult::Success);
+		ASSERT_EQ(pack.ResolveAudioSamples(), PackResult::Success);
+		// Resolving again is a no-op
+		ASSERT_EQ(pack.ResolveMeshes(), PackResult::Success);
+		ExpectContent(pack);
+	}
+	std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMappedPackFile, openBuffer)
+{
+	MappedPackFile pack;
+	ASSERT_EQ(OpenBuffer(pack, ValidPack()), PackResult::Success);
+	ASSERT_EQ(pack.ResolveMeshes(), PackResult::Success);
+	ASSERT_EQ(pack.ResolveTextures(), PackResult::Success);
+	ASSERT_EQ(pack.ResolveAudioSamples(), PackResult::Success);
+	ExpectContent(pack);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMappedPackFile, openFailures)
+{
+	{
+		MappedPackFile pack;
+		EXPECT_EQ(pack.Open(std::filesystem::temp_directory_path() / "test_mapped_pack_file_missing.g3d"),
+		          PackResult::ErrCantOpen);
+	}
+	{
+		MappedPackFile pack;
+		EXPECT_EQ(OpenBuffer(pack, {'L', 'i', 'O', 'n'}), PackResult::ErrFileTooSmall);
+	}
+	{
+		auto data = ValidPack();
+		data[0] = 'X';
+		MappedPackFile pack;
+		EXPECT_EQ(OpenBuffer(pack, std::move(data)), PackResult::ErrUnrecognizedHeader);
+	}
+	{
+		// The last block is cut short
+		auto data = ValidPack();
+		data.pop_back();
+		MappedPackFile pack;
+		EXPECT_EQ(OpenBuffer(pack, std::move(data)), PackResult::ErrFileNotEvenlySplit);
+	}
+	{
+		PackWriter writer;
+		writer.Block("INFO", InfoBlock(k_TextureId)).Block("INFO", InfoBlock(k_TextureId));
+		MappedPackFile pack;
+		EXPECT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::ErrDuplicateBlockName);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(TestMappedPackFile, resolveFailures)
+{
+	{
+		PackWriter writer;
+		writer.Block("LHAudioWaveData", WaveDataBlock());
+		MappedPackFile pack;
+		ASSERT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::Success);
+		EXPECT_EQ(pack.ResolveMeshes(), PackResult::ErrMissingMeshBlock);
+		EXPECT_EQ(pack.ResolveTextures(), PackResult::ErrMissingInfoBlock);
+		EXPECT_EQ(pack.ResolveAudioSamples(), PackResult::ErrMissingAudioBankSampleTableBlock);
+	}
+	{
+		// More meshes than there is space for offsets
+		PackWriter writer;
+		writer.Block("MESHES", MeshesBlock(1000));
+		MappedPackFile pack;
+		ASSERT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::Success);
+		EXPECT_EQ(pack.ResolveMeshes(), PackResult::ErrMeshBlockHeaderMalformed);
+		EXPECT_TRUE(pack.GetMeshes().empty());
+	}
+	{
+		PackWriter writer;
+		writer.Block("INFO", InfoBlock(k_TextureId)).Block("2a", TextureBlock(k_TextureId + 1));
+		MappedPackFile pack;
+		ASSERT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::Success);
+		EXPECT_EQ(pack.ResolveTextures(), PackResult::ErrTextureBlockIdMismatch);
+	}
+	{
+		PackWriter writer;
+		writer.Block("INFO", InfoBlock(k_TextureId));
+		MappedPackFile pack;
+		ASSERT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::Success);
+		EXPECT_EQ(pack.ResolveTextures(), PackResult::ErrMissingTextureBlock);
+	}
+	{
+		// The last sample points past the end of the wave data
+		PackWriter writer;
+		writer.Block("LHAudioBankSampleTable", SampleTableBlock(static_cast<uint32_t>(WaveDataBlock().size())))
+		    .Block("LHAudioWaveData", WaveDataBlock());
+		MappedPackFile pack;
+		ASSERT_EQ(OpenBuffer(pack, writer.GetData()), PackResult::Success);
+		EXPECT_EQ(pack.ResolveAudioSamples(), PackResult::ErrFileTooSmall);
+		EXPECT_TRUE(pack.GetAudioSamplesData().empty());
+	}
+}
@@ -0,0 +1,332 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Audio/AudioPlayerInterface.h>
+#include <Audio/MusicStream.h>
+#include <PackFile.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/spdlog.h>
+
+using namespace openblack::audio;
+using namespace openblack;
+
+namespace
+{
+constexpr SourceId k_Source = 7;
+constexpr int k_SampleRate = 22050;
+
+/// Records what the stream does with its source, as a source which plays its buffers when told to
+class FakeAudioPlayer final: public AudioPlayerInterface
+{
+public:
+	void Initialize() override {}
+	void UpdateListener(glm::vec3, glm::vec3, glm::vec3, glm::vec3) const override { CheckThread(); }
+	BufferId CreateBuffer(ChannelLayout, const std::vector<int16_t>& buffer, int) override
+	{
+		CheckThread();
+		_buffers[++_lastBuffer] = buffer;
+		return _lastBuffer;
+	}
+	void FillBuffer(BufferId id, ChannelLayout layout, std::span<const int16_t> buffer, int sampleRate) override
+	{
+		CheckThread();
+		EXPECT_EQ(layout, ChannelLayout::Stereo);
+		EXPECT_EQ(sampleRate, k_SampleRate);
+		EXPECT_EQ(std::ranges::count(_queue, id), 0) << "Filled a queued buffer";
+		_buffers.at(id).assign(buffer.begin(), buffer.end());
+	}
+	void QueueBuffer(SourceId sourceId, BufferId buffer) override
+	{
+		CheckThread();
+		EXPECT_EQ(sourceId, k_Source);
+		_queue.push_back(buffer);
+	}
+	std::vector<BufferId> UnqueueProcessedBuffers(SourceId sourceId) override
+	{
+		CheckThread();
+		EXPECT_EQ(sourceId, k_Source);
+		std::vector<BufferId> result(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(_processed));
+		_queue.erase(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(_processed));
+		_processed = 0;
+		return result;
+	}
+	void DeleteBuffer(BufferId id) override
+	{
+		CheckThread();
+		EXPECT_EQ(_buffers.erase(id), 1);
+	}
+	SourceId CreateSource(float, bool) override { return k_Source; }
+	void DeleteSource(SourceId) override {}
+	void UpdateSource(SourceId, glm::vec3, float, bool) override {}
+	void UpdateSource(SourceId, float, bool) override {}
+	float GetDuration(BufferId) override { return 0.0f; }
+	void PlaySource(SourceId, glm::vec3, float, bool) override { FAIL() << "The music is not positional"; }
+	void PlaySource(SourceId sourceId, float, bool loop) override
+	{
+		CheckThread();
+		EXPECT_EQ(sourceId, k_Source);
+		EXPECT_FALSE(loop);
+		_status = AudioStatus::Playing;
+		++_playCount;
+	}
+	void PauseSource(SourceId) const override { CheckThread(); }
+	void StopSource(SourceId) const override
+	{
+		CheckThread();
+		_status = AudioStatus::Stopped;
+		_processed = _queue.size();
+	}
+	void SetVolume(SourceId, float) override {}
+	[[nodiscard]] float GetVolume() const override { return 1.0f; }
+	[[nodiscard]] AudioStatus GetStatus(SourceId) const override
+	{
+		CheckThread();
+		return _status;
+	}
+	[[nodiscard]] float GetProgress(size_t, SourceId) const override { return 0.0f; }
+
+	/// Play the next queued buffers, the source stops once it runs out of them like an OpenAL source
+	void Play(size_t bufferCount)
+	{
+		if (_status != AudioStatus::Playing)
+		{
+			return;
+		}
+		for (size_t i = 0; i < bufferCount && _processed < _queue.size(); ++i)
+		{
+			const auto& buffer = _buffers.at(_queue[_processed++]);
+			played.insert(played.end(), buffer.begin(), buffer.end());
+		}
+		if (_processed == _queue.size())
+		{
+			_status = AudioStatus::Stopped;
+		}
+	}
+
+	[[nodiscard]] size_t GetBufferCount() const { return _buffers.size(); }
+	[[nodiscard]] size_t GetQueuedCount() const { return _queue.size(); }
+	[[nodiscard]] size_t GetPlayCount() const { return _playCount; }
+
+	std::vector<int16_t> played;
+
+private:
+	void CheckThread() const { EXPECT_EQ(std::this_thread::get_id(), _thread) << "The player is used by another thread"; }
+
+	std::thread::id _thread {std::this_thread::get_id()};
+	std::map<BufferId, std::vector<int16_t>> _buffers;
+	BufferId _lastBuffer {0};
+	std::vector<BufferId> _queue;
+	mutable size_t _processed {0};
+	mutable AudioStatus _status {AudioStatus::Initial};
+	size_t _playCount {0};
+};
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, const T& value)
+{
+	const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+	data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+/// Interleaved stereo frames which differ between samples and between frames
+std::vector<int16_t> Pcm(int16_t first, size_t frameCount)
+{
+	std::vector<int16_t> result;
+	for (size_t i = 0; i < frameCount; ++i)
+	{
+		const auto value = static_cast<int16_t>((first + i) % 30000);
+		result.push_back(value);
+		result.push_back(static_cast<int16_t>(-value));
+	}
+	return result;
+}
+
+std::vector<uint8_t> Wav(const std::vector<int16_t>& pcm)
+{
+	const auto dataSize = static_cast<uint32_t>(pcm.size() * sizeof(int16_t));
+	std::vector<uint8_t> result = {'R', 'I', 'F', 'F'};
+	Append(result, 36 + dataSize);
+	result.insert(result.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+	Append(result, uint32_t {16});
+	Append(result, uint16_t {1}); // PCM
+	Append(result, uint16_t {2});
+	Append(result, uint32_t {k_SampleRate});
+	Append(result, uint32_t {k_SampleRate * 2 * sizeof(int16_t)});
+	Append(result, uint16_t {2 * sizeof(int16_t)});
+	Append(result, uint16_t {16});
+	result.insert(result.end(), {'d', 'a', 't', 'a'});
+	Append(result, dataSize);
+	const auto* bytes = reinterpret_cast<const uint8_t*>(pcm.data());
+	result.insert(result.end(), bytes, bytes + dataSize);
+	return result;
+}
+
+void AppendBlock(std::vector<uint8_t>& pack, const std::string& name, const std::vector<uint8_t>& data)
+{
+	std::array<char, 0x20> blockName {};
+	std::copy_n(name.begin(), name.size(), blockName.begin());
+	pack.insert(pack.end(), blockName.begin(), blockName.end());
+	Append(pack, static_cast<uint32_t>(data.size()));
+	pack.insert(pack.end(), data.begin(), data.end());
+}
+
+void WritePack(const std::filesystem::path& path, const std::vector<std::vector<uint8_t>>& samples)
+{
+	std::vector<uint8_t> table;
+	std::vector<uint8_t> waveData;
+	Append(table, static_cast<uint32_t>(samples.size()));
+	for (const auto& sample : samples)
+	{
+		pack::AudioBankSampleHeader header {};
+		header.offset = static_cast<uint32_t>(waveData.size());
+		header.size = static_cast<uint32_t>(sample.size());
+		header.sampleRate = k_SampleRate;
+		Append(table, header);
+		waveData.insert(waveData.end(), sample.begin(), sample.end());
+	}
+
+	std::vector<uint8_t> pack = {'L', 'i', 'O', 'n', 'H', 'e', 'A', 'd'};
+	AppendBlock(pack, "LHAudioBankSampleTable", table);
+	AppendBlock(pack, "LHAudioWaveData", waveData);
+	std::ofstream stream(path, std::ios::binary);
+	stream.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+}
+} // namespace
+
+class TestMusicStream: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		if (spdlog::get("audio") == nullptr)
+		{
+			spdlog::null_logger_mt("audio");
+		}
+		// Several buffers worth of frames which don't line up with the buffers
+		_pcm = {Pcm(1, MusicStream::k_FramesPerBuffer * 4 + 1000), Pcm(5000, 3000)};
+		_path = std::filesystem::temp_directory_path() / "test_music_stream.sad";
+		WritePack(_path, {Wav(_pcm[0]), std::vector<uint8_t>(64), Wav(_pcm[1])});
+	}
+	void TearDown() override { std::filesystem::remove(_path); }
+
+	/// Update the stream and play some buffers at a time until the condition holds
+	template <typename Condition>
+	void PlayUntil(MusicStream& stream, size_t buffersPerUpdate, Condition condition)
+	{
+		const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (!condition())
+		{
+			ASSERT_LT(std::chrono::steady_clock::now(), timeout);
+			stream.Update();
+			_player.Play(buffersPerUpdate);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	[[nodiscard]] std::vector<int16_t> Expected(size_t passes) const
+	{
+		std::vector<int16_t> result;
+		for (size_t i = 0; i < passes; ++i)
+		{
+			for (const auto& pcm : _pcm)
+			{
+				result.insert(result.end(), pcm.begin(), pcm.end());
+			}
+		}
+		return result;
+	}
+
+	FakeAudioPlayer _player;
+	std::vector<std::vector<int16_t>> _pcm;
+	std::filesystem::path _path;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMusicStream, playsPackOnce)
+{
+	MusicStream stream(_player);
+	ASSERT_TRUE(stream.Open(_path));
+	stream.Start(k_Source, 1.0f, false);
+	PlayUntil(stream, 1, [&stream] { return stream.IsFinished(); });
+
+	// The sample which can't be decoded is skipped
+	EXPECT_EQ(_player.played, Expected(1));
+	EXPECT_EQ(_player.GetQueuedCount(), 0);
+	EXPECT_EQ(_player.GetBufferCount(), MusicStream::k_BufferCount);
+	stream.Stop();
+	EXPECT_EQ(_player.GetBufferCount(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMusicStream, loopsPack)
+{
+	const auto passFrames = Expected(1).size() / 2;
+	MusicStream stream(_player);
+	ASSERT_TRUE(stream.Open(_path));
+	stream.Start(k_Source, 1.0f, true);
+	PlayUntil(stream, 1, [this, passFrames] { return _player.played.size() / 2 > passFrames * 5 / 2; });
+	// Count the last played buffer
+	stream.Update();
+
+	EXPECT_FALSE(stream.IsFinished());
+	const auto expected = Expected(3);
+	ASSERT_LE(_player.played.size(), expected.size());
+	EXPECT_TRUE(std::equal(_player.played.begin(), _player.played.end(), expected.begin()));
+	const auto playedFrames = _player.played.size() / 2;
+	EXPECT_FLOAT_EQ(stream.GetProgress(),
+	                static_cast<float>(playedFrames % passFrames) / static_cast<float>(passFrames));
+	stream.Stop();
+	EXPECT_EQ(_player.GetBufferCount(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMusicStream, restartsStarvedSource)
+{
+	MusicStream stream(_player);
+	ASSERT_TRUE(stream.Open(_path));
+	stream.Start(k_Source, 1.0f, false);
+	PlayUntil(stream, 0, [this] { return _player.GetQueuedCount() == MusicStream::k_BufferCount; });
+	EXPECT_EQ(_player.GetPlayCount(), 1);
+
+	// The source plays every queued buffer before the stream could refill them
+	_player.Play(MusicStream::k_BufferCount);
+	EXPECT_EQ(_player.GetStatus(k_Source), AudioStatus::Stopped);
+	PlayUntil(stream, 1, [this] { return _player.GetPlayCount() == 2; });
+	PlayUntil(stream, 1, [&stream] { return stream.IsFinished(); });
+	EXPECT_EQ(_player.played, Expected(1));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestMusicStream, stopReleasesBuffers)
+{
+	MusicStream stream(_player);
+	ASSERT_TRUE(stream.Open(_path));
+	stream.Start(k_Source, 1.0f, true);
+	PlayUntil(stream, 1, [this] { return !_player.played.empty(); });
+	stream.Stop();
+	EXPECT_EQ(_player.GetStatus(k_Source), AudioStatus::Stopped);
+	EXPECT_EQ(_player.GetQueuedCount(), 0);
+	EXPECT_EQ(_player.GetBufferCount(), 0);
+	// Stopping again or destroying the stopped stream does nothing
+	stream.Stop();
+}
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Components/Abode.h>
+#include <ECS/Components/Fixed.h>
+#include <ECS/Components/Footpath.h>
+#include <ECS/Components/Hand.h>
+#include <ECS/Components/LivingAction.h>
+#include <ECS/Components/Mobile.h>
+#include <ECS/Components/Stream.h>
+#include <ECS/Components/Town.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/Velocity.h>
+#include <ECS/Registry.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+using namespace openblack;
+
+namespace
+{
+constexpr uint64_t k_Key = 0x1234;
+constexpr uint32_t k_TownCount = 8;
+constexpr uint32_t k_AbodesPerTown = 64;
+constexpr uint32_t k_MobileCount = 1 << 14;
+
+/// Towns and abodes from their archetypes, then mobiles, a footpath and a stream
+void BuildWorld()
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	for (uint32_t town = 0; town < k_TownCount; ++town)
+	{
+		const auto townPosition = glm::vec3(100.0f * static_cast<float>(town), 0.0f, 2000.0f);
+		const auto townEntity =
+		    TownArchetype::Create(static_cast<int>(town), townPosition, PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+		registry.Get<Town>(townEntity).beliefs.emplace("PLAYER_ONE", 1.5f * static_cast<float>(town));
+		for (uint32_t i = 0; i < k_AbodesPerTown; ++i)
+		{
+			const auto offset = glm::vec3(static_cast<float>(i % 8), 0.0f, static_cast<float>(i / 8)) * 8.0f;
+			AbodeArchetype::Create(town, townPosition + offset, AbodeInfo::CelticTempleY, 0.5f, 1.0f, i, i);
+		}
+	}
+
+	std::vector<entt::entity> mobiles(k_MobileCount);
+	registry.Create(mobiles.begin(), mobiles.end());
+	// TODO (#749) use std::views::enumerate
+	for (uint32_t i = 0; const auto entity : mobiles)
+	{
+		registry.Assign<Transform>(entity, glm::vec3(static_cast<float>(i % 512), 0.0f, static_cast<float>(i / 512)),
+		                           glm::mat3(1.0f), glm::vec3(1.0f));
+		registry.Assign<Mobile>(entity);
+		registry.Assign<LivingAction>(entity, VillagerStates::MoveToPos, static_cast<uint16_t>(i));
+		++i;
+	}
+
+	const auto footpath = registry.Create();
+	registry.Assign<Footpath>(footpath, std::vector<Footpath::Node> {{glm::vec3(1.0f)}, {glm::vec3(2.0f)}});
+	registry.Context().footpaths.emplace(static_cast<Footpath::Id>(footpath), footpath);
+
+	const auto stream = registry.Create();
+	auto& streamComponent = registry.Assign<Stream>(stream, 7);
+	streamComponent.nodes.reserve(2);
+	streamComponent.nodes.emplace_back(glm::vec3(1.0f), streamComponent.nodes);
+	streamComponent.nodes.emplace_back(glm::vec3(2.0f), streamComponent.nodes);
+	registry.Context().streams.emplace(7, stream);
+}
+
+template <typename Component>
+std::map<entt::entity, Component> Gather()
+{
+	std::map<entt::entity, Component> components;
+	Locator::entitiesRegistry::value().Each<const Component>(
+	    [&components](entt::entity entity, const Component& component) { components.emplace(entity, component); });
+	return components;
+}
+} // namespace
+
+class RegistrySnapshotTest: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+	}
+	void TearDown() override { _game.reset(); }
+	std::unique_ptr<Game> _game;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshotTest, restoresWorld)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	BuildWorld();
+
+	const auto transforms = Gather<Transform>();
+	const auto fixed = Gather<Fixed>();
+	const auto abodes = Gather<Abode>();
+	const auto towns = Gather<Town>();
+	const auto actions = Gather<LivingAction>();
+	const auto context = registry.Context();
+
+	const auto snapshot = registry.SaveSnapshot(k_Key);
+	registry.Reset();
+	ASSERT_EQ(registry.Size<Transform>(), 0);
+	ASSERT_TRUE(registry.LoadSnapshot(snapshot, k_Key));
+
+	// Entities keep their identifiers, systems holding on to them keep working
+	ASSERT_EQ(registry.Size<Transform>(), transforms.size());
+	for (const auto& [entity, transform] : transforms)
+	{
+		ASSERT_TRUE(registry.Valid(entity));
+		const auto& restored = registry.Get<const Transform>(entity);
+		ASSERT_EQ(restored.position, transform.position);
+		ASSERT_EQ(restored.rotation, transform.rotation);
+		ASSERT_EQ(restored.scale, transform.scale);
+	}
+	ASSERT_EQ(registry.Size<Fixed>(), fixed.size());
+	for (const auto& [entity, component] : fixed)
+	{
+		ASSERT_EQ(registry.Get<const Fixed>(entity).boundingCenter, component.boundingCenter);
+		ASSERT_EQ(registry.Get<const Fixed>(entity).boundingRadius, component.boundingRadius);
+	}
+	ASSERT_EQ(registry.Size<Abode>(), abodes.size());
+	for (const auto& [entity, abode] : abodes)
+	{
+		ASSERT_EQ(registry.Get<const Abode>(entity).townId, abode.townId);
+		ASSERT_EQ(registry.Get<const Abode>(entity).foodAmount, abode.foodAmount);
+	}
+	ASSERT_EQ(registry.Size<Town>(), towns.size());
+	for (const auto& [entity, town] : towns)
+	{
+		ASSERT_EQ(registry.Get<const Town>(entity).id, town.id);
+		ASSERT_EQ(registry.Get<const Town>(entity).beliefs, town.beliefs);
+	}
+	ASSERT_EQ(registry.Size<LivingAction>(), actions.size());
+	for (const auto& [entity, action] : actions)
+	{
+		ASSERT_EQ(registry.Get<const LivingAction>(entity).states, action.states);
+		ASSERT_EQ(registry.Get<const LivingAction>(entity).turnsUntilStateChange, action.turnsUntilStateChange);
+	}
+	ASSERT_EQ(registry.Context().towns, context.towns);
+	ASSERT_EQ(registry.Context().footpaths, context.footpaths);
+	ASSERT_EQ(registry.Context().streams, context.streams);
+	const auto& stream = registry.Get<const Stream>(registry.Context().streams.at(7));
+	ASSERT_EQ(stream.nodes.size(), 2);
+	ASSERT_EQ(stream.nodes[1].edges.size(), 1);
+	ASSERT_EQ(stream.nodes[1].edges[0].position, glm::vec3(1.0f));
+	ASSERT_EQ(registry.Get<const Footpath>(registry.Context().footpaths.begin()->second).nodes.size(), 2);
+
+	// Saving the restored world gives back a snapshot of the same size
+	ASSERT_EQ(registry.SaveSnapshot(k_Key).size(), snapshot.size());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshotTest, rejected)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	BuildWorld();
+	const auto snapshot = registry.SaveSnapshot(k_Key);
+	const auto count = registry.Size<Transform>();
+
+	// Snapshots of something else leave the registry as it is
+	ASSERT_FALSE(registry.LoadSnapshot(snapshot, k_Key + 1));
+	ASSERT_EQ(registry.Size<Transform>(), count);
+
+	// Malformed snapshots leave it empty
+	ASSERT_FALSE(registry.LoadSnapshot(std::span(snapshot).first(snapshot.size() / 2), k_Key));
+	ASSERT_EQ(registry.Size<Transform>(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshotTest, rejectsDuplicateEntities)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	std::array<entt::entity, 2> entities;
+	registry.Create(entities.begin(), entities.end());
+	for (const auto entity : entities)
+	{
+		registry.Assign<Velocity>(entity, 1.0f, 2.0f, 3.0f);
+	}
+	auto snapshot = registry.SaveSnapshot(k_Key);
+
+	// The velocities are saved as their count followed by their entities, give both to the first one
+	const std::array<uint32_t, 3> storage = {2, static_cast<uint32_t>(entities[0]), static_cast<uint32_t>(entities[1])};
+	const auto* storageBytes = reinterpret_cast<const uint8_t*>(storage.data());
+	const auto found = std::search(snapshot.begin(), snapshot.end(), storageBytes, storageBytes + sizeof(storage));
+	ASSERT_NE(found, snapshot.end());
+	std::memcpy(&*found + 2 * sizeof(uint32_t), &storage[1], sizeof(uint32_t));
+
+	ASSERT_FALSE(registry.LoadSnapshot(snapshot, k_Key));
+	ASSERT_EQ(registry.Size<Velocity>(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(RegistrySnapshotTest, rejectsInvalidEnums)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto entity = registry.Create();
+	registry.Assign<Hand>(entity, false, Hand::RenderType::Symbol);
+	ASSERT_TRUE(registry.LoadSnapshot(registry.SaveSnapshot(k_Key), k_Key));
+	ASSERT_EQ(registry.Get<const Hand>(entity).renderType, Hand::RenderType::Symbol);
+
+	// Only a corrupt snapshot would have a value which isn't one of the enum's
+	registry.Get<Hand>(entity).renderType = static_cast<Hand::RenderType>(7);
+	ASSERT_FALSE(registry.LoadSnapshot(registry.SaveSnapshot(k_Key), k_Key));
+	ASSERT_EQ(registry.Size<Hand>(), 0);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST(RegistrySnapshot, listsComponentsOfLand1)
+{
+	static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+	auto args = Arguments {
+	    .graphicsBackend = openblack::GraphicsBackend::Noop,
+	    .gamePath = mockGamePath.string(),
+	    .numFramesToSimulate = 0,
+	    .logFile = "stdout",
+	    .startLevel = "Land1.txt",
+	};
+	std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+	auto game = std::make_unique<Game>(std::move(args));
+	ASSERT_TRUE(game->Initialize());
+
+	// A component added without saying whether snapshots save it would silently be lost when loading one
+	ASSERT_TRUE(Locator::entitiesRegistry::value().GetUnlistedSnapshotComponents().empty());
+	game.reset();
+}
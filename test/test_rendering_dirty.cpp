@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include <ECS/Archetypes/AbodeArchetype.h>
+#include <ECS/Archetypes/TownArchetype.h>
+#include <ECS/Components/Mesh.h>
+#include <ECS/Components/Transform.h>
+#include <ECS/Components/WallHug.h>
+#include <ECS/Registry.h>
+#include <ECS/Systems/RenderingSystemInterface.h>
+#include <Game.h>
+#include <Locator.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::ecs::archetypes;
+using namespace openblack::ecs::components;
+using namespace openblack;
+
+class TestRenderingDirty: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+
+		TownArchetype::Create(0, glm::vec3(2185.72f, 0.0f, 2315.78f), PlayerNames::PLAYER_ONE, Tribe::CELTIC);
+		_abode = AbodeArchetype::Create(0, glm::vec3(2224.63f, 0.0f, 2372.52f), AbodeInfo::CelticTempleY, 2.932f, 1.0f, 0, 0);
+		Prepare();
+		ASSERT_FALSE(Context().dirty);
+		ASSERT_TRUE(Context().instanceSlots.contains(_abode));
+	}
+	void TearDown() override { _game.reset(); }
+
+	static void Prepare() { Locator::rendereringSystem::value().PrepareDraw(false, false, false); }
+	static const ecs::systems::RenderContext& Context() { return Locator::rendereringSystem::value().GetContext(); }
+
+	std::unique_ptr<Game> _game;
+	entt::entity _abode;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestRenderingDirty, undrawnComponentsKeepContext)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	// Pathfinding swaps these every turn
+	registry.Assign<MoveStateLinearTag>(_abode, MoveStateClockwise::Clockwise, glm::vec2(0.0f));
+	registry.SwapComponents<MoveStateArrivedTag>(_abode, registry.Get<MoveStateLinearTag>(_abode),
+	                                             MoveStateClockwise::Clockwise, glm::vec2(0.0f));
+	registry.Remove<MoveStateArrivedTag>(_abode);
+	EXPECT_FALSE(Context().dirty);
+	EXPECT_TRUE(Context().dirtyEntities.empty());
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestRenderingDirty, replacedTransformUpdatesEntity)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto slot = Context().instanceSlots.at(_abode);
+	registry.AssignOrReplace<Transform>(_abode, glm::vec3(2230.0f, 0.0f, 2380.0f), glm::mat3(1.0f), glm::vec3(1.0f));
+	EXPECT_FALSE(Context().dirty);
+	ASSERT_EQ(Context().dirtyEntities.size(), 1);
+	EXPECT_EQ(Context().dirtyEntities.front(), _abode);
+
+	Prepare();
+	EXPECT_FALSE(Context().dirty);
+	EXPECT_TRUE(Context().dirtyEntities.empty());
+	EXPECT_EQ(Context().instanceSlots.at(_abode), slot);
+	EXPECT_EQ(Context().instanceUniforms[slot][3], glm::vec4(2230.0f, 0.0f, 2380.0f, 1.0f));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestRenderingDirty, drawnComponentsRebuildContext)
+{
+	auto& registry = Locator::entitiesRegistry::value();
+	const auto mesh = registry.Get<Mesh>(_abode);
+	registry.Remove<Mesh>(_abode);
+	EXPECT_TRUE(Context().dirty);
+	Prepare();
+	EXPECT_FALSE(Context().instanceSlots.contains(_abode));
+
+	registry.Assign<Mesh>(_abode, mesh);
+	EXPECT_TRUE(Context().dirty);
+	Prepare();
+	EXPECT_TRUE(Context().instanceSlots.contains(_abode));
+}
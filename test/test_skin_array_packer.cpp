@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright (c) 2018-2026 openblack developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/openblack/openblack
+ *
+ * openblack is licensed under the GNU General Public License version 3.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Game.h>
+#include <Graphics/SkinArrayPacker.h>
+#include <Graphics/Texture2D.h>
+#include <L3DFile.h>
+#include <gtest/gtest.h>
+
+using namespace openblack::graphics;
+using namespace openblack;
+
+class TestSkinArrayPacker: public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		static const auto mockGamePath = std::filesystem::path(TEST_BINARY_DIR) / "mock";
+		auto args = Arguments {
+		    .graphicsBackend = openblack::GraphicsBackend::Noop,
+		    .gamePath = mockGamePath.string(),
+		    .numFramesToSimulate = 0,
+		    .logFile = "stdout",
+		};
+		std::fill_n(args.logLevels.begin(), args.logLevels.size(), spdlog::level::warn);
+		_game = std::make_unique<Game>(std::move(args));
+		ASSERT_TRUE(_game->Initialize());
+		// Skins are too large for the stack
+		_skin = std::make_unique<l3d::L3DTexture>();
+	}
+	void TearDown() override
+	{
+		_skin.reset();
+		_game.reset();
+	}
+
+	std::unique_ptr<Game> _game;
+	std::unique_ptr<l3d::L3DTexture> _skin;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestSkinArrayPacker, packsSkinsIntoArrays)
+{
+	constexpr uint16_t k_LayersPerArray = 3;
+	std::vector<SkinLayer> layers;
+	{
+		SkinArrayPacker packer(k_LayersPerArray);
+		EXPECT_EQ(SkinArrayPacker::GetActive(), &packer);
+		for (uint32_t i = 0; i < 7; ++i)
+		{
+			layers.push_back(packer.Add(*_skin));
+		}
+		EXPECT_EQ(packer.GetSkinCount(), 7);
+		// The last array isn't full yet
+		EXPECT_EQ(packer.GetArrayCount(), 2);
+	}
+	EXPECT_EQ(SkinArrayPacker::GetActive(), nullptr);
+
+	// TODO (#749) use std::views::enumerate
+	for (size_t i = 0; i < layers.size(); ++i)
+	{
+		EXPECT_EQ(layers[i].layer, i % k_LayersPerArray);
+		EXPECT_EQ(layers[i].array, layers[i - i % k_LayersPerArray].array);
+	}
+	EXPECT_NE(layers[0].array, layers[3].array);
+	EXPECT_NE(layers[3].array, layers[6].array);
+
+	// Full arrays and the last one, created when the packer went out of scope
+	EXPECT_EQ(layers[0].array->GetLayerCount(), k_LayersPerArray);
+	EXPECT_EQ(layers[3].array->GetLayerCount(), k_LayersPerArray);
+	// A single skin is padded so that it is still sampled as an array
+	EXPECT_EQ(layers[6].array->GetLayerCount(), SkinArrayPacker::k_MinLayersPerArray);
+	EXPECT_EQ(layers[6].array->GetResolution(), glm::u16vec2(l3d::L3DTexture::k_Width, l3d::L3DTexture::k_Height));
+	EXPECT_EQ(layers[6].array->GetFormat(), TextureFormat::BGRA4);
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestSkinArrayPacker, clampsLayersPerArray)
+{
+	{
+		SkinArrayPacker packer(0);
+		const auto first = packer.Add(*_skin);
+		const auto second = packer.Add(*_skin);
+		const auto third = packer.Add(*_skin);
+		EXPECT_EQ(first.layer, 0);
+		EXPECT_EQ(second.layer, 1);
+		EXPECT_EQ(third.layer, 0);
+		EXPECT_EQ(first.array, second.array);
+		EXPECT_NE(first.array, third.array);
+		EXPECT_EQ(packer.GetArrayCount(), 1);
+	}
+	{
+		SkinArrayPacker packer(SkinArrayPacker::k_MaxLayersPerArray + 1);
+		for (uint16_t i = 0; i < SkinArrayPacker::k_MaxLayersPerArray; ++i)
+		{
+			static_cast<void>(packer.Add(*_skin));
+		}
+		EXPECT_EQ(packer.GetArrayCount(), 1);
+	}
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables): external macro
+TEST_F(TestSkinArrayPacker, emptyPackerCreatesNothing)
+{
+	{
+		const SkinArrayPacker packer;
+		EXPECT_EQ(packer.GetSkinCount(), 0);
+	}
+	EXPECT_EQ(SkinArrayPacker::GetActive(), nullptr);
+	// Only one packer may be active, so a new one can be made once the last is gone
+	const SkinArrayPacker packer;
+	EXPECT_EQ(packer.GetArrayCount(), 0);
+}